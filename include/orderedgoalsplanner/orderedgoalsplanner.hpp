@@ -3,6 +3,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include "util/api.hpp"
 #include <orderedgoalsplanner/util/alias.hpp>
 #include <orderedgoalsplanner/types/domain.hpp>
@@ -10,10 +11,13 @@
 #include <orderedgoalsplanner/types/actionstodoinparallel.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
 #include <orderedgoalsplanner/types/lookforanactionoutputinfos.hpp>
+#include <orderedgoalsplanner/types/planningbudget.hpp>
+#include <orderedgoalsplanner/types/searchstrategy.hpp>
 
 namespace ogp
 {
 struct ParallelPlan;
+struct PlannerCaches;
 
 
 /**
@@ -38,6 +42,45 @@ std::list<ActionInvocationWithGoal> planForMoreImportantGoalPossible(Problem& pP
                                                                      LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr = nullptr);
 
 
+/**
+ * @brief Anytime version of planForMoreImportantGoalPossible, bounded by a deadline and/or a number of expansions.
+ * @param[in] pBudget Budget of the plan resolution.
+ * @param[out] pStatus TRUNCATED if the budget was exhausted before the end of the search, CANCELLED if the cancellation token was cancelled.
+ * @return The best plan found so far.
+ */
+ORDEREDGOALSPLANNER_API
+std::list<ActionInvocationWithGoal> planForMoreImportantGoalPossible(Problem& pProblem,
+                                                                     const Domain& pDomain,
+                                                                     const SetOfCallbacks& pCallbacks,
+                                                                     bool pTryToDoMoreOptimalSolution,
+                                                                     const PlanningBudget& pBudget,
+                                                                     PlanningStatus& pStatus,
+                                                                     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                     const Historical* pGlobalHistorical = nullptr,
+                                                                     LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr = nullptr);
+
+/**
+ * @brief Version of planForMoreImportantGoalPossible with a choice of the search and a budget.<br/>
+ * With a forward search, the most important goal is planned with the forward search if the domain and the goal can be
+ * grounded to STRIPS, otherwise or if the forward search fails within its bounds, it is planned with the backward chaining.
+ * @param[in] pSearchStrategy Search to use.
+ * @param[in] pBudget Budget of the plan resolution, a default budget does not bound the search.
+ * @param[out] pStatus TRUNCATED if the budget was exhausted before the end of the search, CANCELLED if the cancellation token was cancelled.
+ * @return The best plan found so far.
+ */
+ORDEREDGOALSPLANNER_API
+std::list<ActionInvocationWithGoal> planForMoreImportantGoalPossible(Problem& pProblem,
+                                                                     const Domain& pDomain,
+                                                                     const SetOfCallbacks& pCallbacks,
+                                                                     bool pTryToDoMoreOptimalSolution,
+                                                                     const SearchStrategy& pSearchStrategy,
+                                                                     const PlanningBudget& pBudget,
+                                                                     PlanningStatus& pStatus,
+                                                                     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                     const Historical* pGlobalHistorical = nullptr,
+                                                                     LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr = nullptr);
+
+
 
 /**
  * @brief Ask the planner to get the next actions to do in parallel.
@@ -55,6 +98,38 @@ ActionsToDoInParallel actionsToDoInParallelNow(Problem& pProblem,
                                                const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
                                                Historical* pGlobalHistorical = nullptr);
 
+/**
+ * @brief Version of actionsToDoInParallelNow bounded by a budget, that can also be cancelled.
+ * @param[in] pBudget Budget of the plan resolution.
+ * @param[out] pStatus TRUNCATED if the budget was exhausted, CANCELLED if the cancellation token was cancelled.
+ * @return The next actions to do in parallel.
+ */
+ORDEREDGOALSPLANNER_API
+ActionsToDoInParallel actionsToDoInParallelNow(Problem& pProblem,
+                                               const Domain& pDomain,
+                                               const SetOfCallbacks& pCallbacks,
+                                               const PlanningBudget& pBudget,
+                                               PlanningStatus& pStatus,
+                                               const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                               Historical* pGlobalHistorical = nullptr);
+
+/**
+ * @brief Version of actionsToDoInParallelNow with a choice of the search and a budget.
+ * @param[in] pSearchStrategy Search to use, see the version of planForEveryGoals with a choice of the search.
+ * @param[in] pBudget Budget of the plan resolution, a default budget does not bound the search.
+ * @param[out] pStatus TRUNCATED if the budget was exhausted, CANCELLED if the cancellation token was cancelled.
+ * @return The next actions to do in parallel.
+ */
+ORDEREDGOALSPLANNER_API
+ActionsToDoInParallel actionsToDoInParallelNow(Problem& pProblem,
+                                               const Domain& pDomain,
+                                               const SetOfCallbacks& pCallbacks,
+                                               const SearchStrategy& pSearchStrategy,
+                                               const PlanningBudget& pBudget,
+                                               PlanningStatus& pStatus,
+                                               const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                               Historical* pGlobalHistorical = nullptr);
+
 
 /**
  * @brief Notify that an action started. This function will update the world (contained in the problem) accordingly.
@@ -107,11 +182,84 @@ std::list<ActionInvocationWithGoal> planForEveryGoals(Problem& pProblem,
                                                       Historical* pGlobalHistorical = nullptr,
                                                       std::list<Goal>* pGoalsDonePtr = nullptr);
 
+/**
+ * @brief Anytime version of planForEveryGoals, bounded by a deadline and/or a number of expansions.
+ * @param[in] pBudget Budget of the plan resolution.
+ * @param[out] pStatus TRUNCATED if the budget was exhausted before the end of the search, CANCELLED if the cancellation token was cancelled.
+ * @return The best plan found so far. It can cover only the first goals if the budget was exhausted.
+ */
+ORDEREDGOALSPLANNER_API
+std::list<ActionInvocationWithGoal> planForEveryGoals(Problem& pProblem,
+                                                      const Domain& pDomain,
+                                                      const SetOfCallbacks& pCallbacks,
+                                                      const PlanningBudget& pBudget,
+                                                      PlanningStatus& pStatus,
+                                                      const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                      Historical* pGlobalHistorical = nullptr,
+                                                      std::list<Goal>* pGoalsDonePtr = nullptr);
+
+/**
+ * @brief Version of planForEveryGoals with a choice of the search.<br/>
+ * With a forward search, each goal is planned with the forward search if the domain and the goal can be grounded to STRIPS,
+ * otherwise or if the forward search fails within its bounds, the goal is planned with the backward chaining.
+ * @param[in] pSearchStrategy Search to use.
+ */
+ORDEREDGOALSPLANNER_API
+std::list<ActionInvocationWithGoal> planForEveryGoals(Problem& pProblem,
+                                                      const Domain& pDomain,
+                                                      const SetOfCallbacks& pCallbacks,
+                                                      const SearchStrategy& pSearchStrategy,
+                                                      const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                      Historical* pGlobalHistorical = nullptr,
+                                                      std::list<Goal>* pGoalsDonePtr = nullptr);
+
+/**
+ * @brief Version of planForEveryGoals with a choice of the search and a budget.
+ * @param[in] pSearchStrategy Search to use.
+ * @param[in] pBudget Budget of the plan resolution, a default budget does not bound the search.
+ * @param[out] pStatus TRUNCATED if the budget was exhausted before the end of the search, CANCELLED if the cancellation token was cancelled.
+ */
+ORDEREDGOALSPLANNER_API
+std::list<ActionInvocationWithGoal> planForEveryGoals(Problem& pProblem,
+                                                      const Domain& pDomain,
+                                                      const SetOfCallbacks& pCallbacks,
+                                                      const SearchStrategy& pSearchStrategy,
+                                                      const PlanningBudget& pBudget,
+                                                      PlanningStatus& pStatus,
+                                                      const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                      Historical* pGlobalHistorical = nullptr,
+                                                      std::list<Goal>* pGoalsDonePtr = nullptr);
+
+/**
+ * @brief Incremental version of planForEveryGoals, to call after notifyActionDone with the rest of the previous plan.<br/>
+ * The actions of the previous plan are kept while they are still valid in the new state of the problem,
+ * i.e. while their preconditions are satisfied and they are for the most important goal not satisfied yet.<br/>
+ * The search only starts at the first action that is not valid anymore.
+ * @param[in, out] pProblem Problem of the planner.
+ * @param[in] pDomain Domain of the planner.
+ * @param[in] pPreviousPlan Actions of the previous plan that are not done yet.
+ * @param[in] pNow Current time.
+ * @param[in, out] pGlobalHistorical Historical more global (and with a smaller priority) than the one contained in the problem.
+ * @param[out] pGoalsDonePtr List of goals satisfied during the plannification.
+ * @param[out] pNbOfReusedActionsPtr Number of actions of the previous plan that are kept at the beginning of the new plan.
+ * @return List of all the actions to do with their parameters with values.
+ */
+ORDEREDGOALSPLANNER_API
+std::list<ActionInvocationWithGoal> replanForEveryGoals(Problem& pProblem,
+                                                        const Domain& pDomain,
+                                                        const SetOfCallbacks& pCallbacks,
+                                                        const std::list<ActionInvocationWithGoal>& pPreviousPlan,
+                                                        const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                        Historical* pGlobalHistorical = nullptr,
+                                                        std::list<Goal>* pGoalsDonePtr = nullptr,
+                                                        std::size_t* pNbOfReusedActionsPtr = nullptr);
+
 ORDEREDGOALSPLANNER_API
 void removeNotMandatoryActions(std::list<ActionInvocationWithGoal>& pPlan,
                                const Domain& pDomain,
                                const Problem& pProblem,
-                               const Goal& pGoal);
+                               const Goal& pGoal,
+                               const CancellationToken* pCancellationTokenPtr = nullptr);
 
 ORDEREDGOALSPLANNER_API
 ParallelPlan parallelPlanForEveryGoals(Problem& pProblem,
@@ -158,6 +306,174 @@ bool evaluate
  Problem& pProblem,
  const Domain& pDomain);
 
+
+/// Statistics of a cache of a planner session.
+struct ORDEREDGOALSPLANNER_API CacheStatistics
+{
+  std::size_t nbOfHits = 0;
+  std::size_t nbOfMisses = 0;
+  std::size_t nbOfEntries = 0;
+  /// Above this number of entries, the least recently used entry is evicted.
+  std::size_t maxNbOfEntries = 0;
+
+  /// Proportion of the searches that were hits, 0 if there was no search.
+  double hitRate() const
+  {
+    auto nbOfSearches = nbOfHits + nbOfMisses;
+    return nbOfSearches > 0 ? static_cast<double>(nbOfHits) / static_cast<double>(nbOfSearches) : 0.;
+  }
+};
+
+
+/**
+ * Planner bound to a domain and a problem that keeps its caches between the calls.<br/>
+ * It is useful for a replanning loop, where most of the work of a call repeats the work of the previous call.<br/>
+ * The caches are the min and max values of the fluents in the domain, the goals that failed in the recent world states
+ * and the costs of the rollouts that compare the candidate actions.<br/>
+ * They are cleared when the domain changes, and the failures of goals only apply to a world state with the same facts and the same objects.<br/>
+ * The costs of the rollouts are also cleared when the min and max values of the fluents in the goals change.<br/>
+ * Optionally, the session can also memorize the plans returned by planForMoreImportantGoalPossible (see setPlanCacheCapacity).
+ */
+struct ORDEREDGOALSPLANNER_API PlannerSession
+{
+  /**
+   * @brief Construct a planner session.
+   * @param[in] pDomain Domain of the planner. It has to outlive the session.
+   * @param[in, out] pProblem Problem of the planner. It has to outlive the session.
+   */
+  PlannerSession(const Domain& pDomain,
+                 Problem& pProblem);
+  ~PlannerSession();
+
+  PlannerSession(const PlannerSession&) = delete;
+  PlannerSession& operator=(const PlannerSession&) = delete;
+
+  /// Same as the free function planForMoreImportantGoalPossible but with the caches of the session.
+  std::list<ActionInvocationWithGoal> planForMoreImportantGoalPossible(const SetOfCallbacks& pCallbacks,
+                                                                       bool pTryToDoMoreOptimalSolution,
+                                                                       const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                       const Historical* pGlobalHistorical = nullptr,
+                                                                       LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr = nullptr);
+
+  /**
+   * @brief Same as the free function planForMoreImportantGoalPossible with a budget but with the caches of the session.<br/>
+   * A plan truncated by the budget is not memorized in the plan cache.
+   */
+  std::list<ActionInvocationWithGoal> planForMoreImportantGoalPossible(const SetOfCallbacks& pCallbacks,
+                                                                       bool pTryToDoMoreOptimalSolution,
+                                                                       const PlanningBudget& pBudget,
+                                                                       PlanningStatus& pStatus,
+                                                                       const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                       const Historical* pGlobalHistorical = nullptr,
+                                                                       LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr = nullptr);
+
+  /// Same as the free function planForMoreImportantGoalPossible with a search and a budget but with the caches of the session.
+  std::list<ActionInvocationWithGoal> planForMoreImportantGoalPossible(const SetOfCallbacks& pCallbacks,
+                                                                       bool pTryToDoMoreOptimalSolution,
+                                                                       const SearchStrategy& pSearchStrategy,
+                                                                       const PlanningBudget& pBudget,
+                                                                       PlanningStatus& pStatus,
+                                                                       const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                       const Historical* pGlobalHistorical = nullptr,
+                                                                       LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr = nullptr);
+
+  /// Same as the free function planForEveryGoals but with the caches of the session.
+  std::list<ActionInvocationWithGoal> planForEveryGoals(const SetOfCallbacks& pCallbacks,
+                                                        const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                        Historical* pGlobalHistorical = nullptr,
+                                                        std::list<Goal>* pGoalsDonePtr = nullptr);
+
+  /// Same as the free function planForEveryGoals with a budget but with the caches of the session.
+  std::list<ActionInvocationWithGoal> planForEveryGoals(const SetOfCallbacks& pCallbacks,
+                                                        const PlanningBudget& pBudget,
+                                                        PlanningStatus& pStatus,
+                                                        const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                        Historical* pGlobalHistorical = nullptr,
+                                                        std::list<Goal>* pGoalsDonePtr = nullptr);
+
+  /// Same as the free function planForEveryGoals with a search but with the caches of the session.
+  std::list<ActionInvocationWithGoal> planForEveryGoals(const SetOfCallbacks& pCallbacks,
+                                                        const SearchStrategy& pSearchStrategy,
+                                                        const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                        Historical* pGlobalHistorical = nullptr,
+                                                        std::list<Goal>* pGoalsDonePtr = nullptr);
+
+  /// Same as the free function planForEveryGoals with a search and a budget but with the caches of the session.
+  std::list<ActionInvocationWithGoal> planForEveryGoals(const SetOfCallbacks& pCallbacks,
+                                                        const SearchStrategy& pSearchStrategy,
+                                                        const PlanningBudget& pBudget,
+                                                        PlanningStatus& pStatus,
+                                                        const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                        Historical* pGlobalHistorical = nullptr,
+                                                        std::list<Goal>* pGoalsDonePtr = nullptr);
+
+  /// Same as the free function replanForEveryGoals but with the caches of the session.
+  std::list<ActionInvocationWithGoal> replanForEveryGoals(const SetOfCallbacks& pCallbacks,
+                                                          const std::list<ActionInvocationWithGoal>& pPreviousPlan,
+                                                          const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                          Historical* pGlobalHistorical = nullptr,
+                                                          std::list<Goal>* pGoalsDonePtr = nullptr,
+                                                          std::size_t* pNbOfReusedActionsPtr = nullptr);
+
+  /// Same as the free function actionsToDoInParallelNow but with the caches of the session.
+  ActionsToDoInParallel actionsToDoInParallelNow(const SetOfCallbacks& pCallbacks,
+                                                 const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                 Historical* pGlobalHistorical = nullptr);
+
+  /// Same as the free function actionsToDoInParallelNow with a budget but with the caches of the session.
+  ActionsToDoInParallel actionsToDoInParallelNow(const SetOfCallbacks& pCallbacks,
+                                                 const PlanningBudget& pBudget,
+                                                 PlanningStatus& pStatus,
+                                                 const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                 Historical* pGlobalHistorical = nullptr);
+
+  /// Same as the free function actionsToDoInParallelNow with a search and a budget but with the caches of the session.
+  ActionsToDoInParallel actionsToDoInParallelNow(const SetOfCallbacks& pCallbacks,
+                                                 const SearchStrategy& pSearchStrategy,
+                                                 const PlanningBudget& pBudget,
+                                                 PlanningStatus& pStatus,
+                                                 const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                 Historical* pGlobalHistorical = nullptr);
+
+  /// Clear the caches, for example after a modification that the caches cannot detect.
+  void clearCaches();
+
+  /// Get the number of hits and misses of the memoization of the rollouts since the last clear of the caches.
+  CacheStatistics transpositionTableStatistics() const;
+
+  /**
+   * @brief Set the number of plans memorized by planForMoreImportantGoalPossible.<br/>
+   * A call done again with the same facts, goals, objects and historicals returns the memorized plan without searching.<br/>
+   * The calls with a LookForAnActionOutputInfos, the calls with goals removed after some time of inactivity
+   * and the calls that modify the problem are not memorized.<br/>
+   * Do not use the cache if the callbacks of the conditions can answer differently for the same problem.
+   * @param[in] pMaxNbOfPlans Maximum number of plans, the least recently used plan is evicted first. 0 to disable the cache (default).
+   */
+  void setPlanCacheCapacity(std::size_t pMaxNbOfPlans);
+
+  /// Get the number of hits and misses of the memoization of the plans since the last clear of the caches.
+  CacheStatistics planCacheStatistics() const;
+
+  /**
+   * @brief Get the number of times the actions grounded for the forward searches were reused (hits) or grounded again (misses)
+   * since the last clear of the caches.<br/>
+   * The entries are the ground actions.
+   */
+  CacheStatistics forwardSearchGroundingStatistics() const;
+
+  /**
+   * @brief Set the number of threads used to evaluate the candidate actions when the planner tries to find a more optimal solution.<br/>
+   * The rollouts of the candidates are done in parallel and compared in the order of the candidates, so the plans do not change.
+   * @param[in] pNbOfThreads Number of threads, the calling thread included. 0 or 1 to evaluate the candidates sequentially (default).
+   */
+  void setNbOfThreadsToEvaluateCandidateActions(std::size_t pNbOfThreads);
+
+private:
+  const Domain& _domain;
+  Problem& _problem;
+  std::unique_ptr<PlannerCaches> _caches;
+};
+
 } // !ogp
 
 
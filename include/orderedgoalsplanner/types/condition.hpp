@@ -57,6 +57,8 @@ struct ORDEREDGOALSPLANNER_API Condition
    * @brief Iterate over all the optional facts.
    * @param[in] pFactCallback Callback called for each optional fact of the condition.
    * @param[in] pIsWrappingExpressionNegated Is the expression wrapping this call is negated.
+   * @param[in] pOnlyMandatoryFacts Skip the facts under a disjunction or an implication,
+   * because the condition can be true without them.
    */
   virtual ContinueOrBreak forAll(const std::function<ContinueOrBreak (const FactOptionalAndValueModification&, bool)>& pFactCallback,
                                  bool pIsWrappingExpressionNegated = false,
@@ -284,14 +284,16 @@ struct ORDEREDGOALSPLANNER_API Fact
 
   std::map<Parameter, Entity> extratParameterToArguments() const;
 
-  const std::string& name() const { return _name; }
+  const std::string& name() const { return _predicatePtr->name; }
+  /// Predicate of the fact, shared with the ontology and the other facts of this predicate.
+  const Predicate& predicate() const { return *_predicatePtr; }
   const std::vector<FactArgument>& arguments() const { return _arguments; }
   const std::optional<Entity>& value() const { return _value; }
   bool isValueNegated() const { return _isValueNegated; }
-  bool isMissingValue() const { return !_value && predicate.value; }
+  bool isMissingValue() const { return !_value && _predicatePtr->value; }
   void setValueNegated(bool pIsValueNegated) { _isValueNegated = pIsValueNegated; }
 
-  std::string factSignature() const;
+  const std::string& factSignature() const;
   void generateSignaturesWithRelatedTypes(const std::function<void(const std::string&)>& pSignatureCallback,
                                           bool pIncludeSubTypes,
                                           bool pIncludeParentTypes) const;
@@ -305,8 +307,8 @@ struct ORDEREDGOALSPLANNER_API Fact
   bool isCompleteWithAnyEntityValue() const;
 
   void toImmutable();
-
-  Predicate predicate;
+  /// Same as toImmutable() but the immutable predicate is shared with the ontology if it exists there.
+  void toImmutable(const Ontology& pOntology);
 
   /// Constant defining the "undefined" special value.
   static const Entity& getUndefinedEntity();
@@ -314,15 +316,16 @@ struct ORDEREDGOALSPLANNER_API Fact
   static const std::string& getPunctualPrefix();
 
 private:
-  /// Name of the fact.
-  std::string _name;
+  /// Predicate of the fact. It is shared with the ontology, unless the types were narrowed for this fact.
+  std::shared_ptr<const Predicate> _predicatePtr;
   /// Arguments of the fact.
   std::vector<FactArgument> _arguments;
   /// Value of the fact.
   std::optional<Entity> _value;
   /// Is the value of the fact negated.
   bool _isValueNegated;
-  std::string _factSignature;
+  /// Signature of the fact, interned so that the facts with the same signature share it.
+  const std::string* _factSignaturePtr;
 
   std::string _generateFactSignature() const;
 
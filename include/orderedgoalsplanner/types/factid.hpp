@@ -0,0 +1,89 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_FACTID_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_TYPES_FACTID_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../util/api.hpp"
+
+namespace ogp
+{
+struct Fact;
+
+/// Dense identifier of a symbol (predicate name or entity value).
+using SymbolId = std::uint32_t;
+
+/**
+ * Dense identifier of a ground atom.<br/>
+ * A ground atom is a predicate with all its arguments set to entities.<br/>
+ * The value of the fact is not part of the atom, so all the values of a fluent share the same identifier.
+ */
+using FactId = std::uint32_t;
+
+
+/**
+ * Table that interns the symbols and the ground atoms into dense identifiers.<br/>
+ * The identifiers are only meaningful for the table that created them. A table is owned by the component
+ * that needs the identifiers (for example a grounded model), so its memory is released with this component.<br/>
+ * Like the other containers, it is not thread-safe.
+ */
+struct ORDEREDGOALSPLANNER_API FactIdTable
+{
+  /**
+   * @brief Get the identifier of a symbol, create it if it does not exist yet.
+   * @param[in] pStr Symbol.
+   * @return The identifier of the symbol.
+   */
+  SymbolId getOrCreateSymbolId(const std::string& pStr);
+
+  /**
+   * @brief Get the identifier of a symbol without creating it.
+   * @param[in] pStr Symbol.
+   * @return The identifier of the symbol or nothing if the symbol was never interned.
+   */
+  std::optional<SymbolId> getSymbolId(const std::string& pStr) const;
+
+  /**
+   * @brief Get the string of a symbol.
+   * @param[in] pSymbolId Identifier of the symbol.
+   * @return The string of the symbol.
+   */
+  const std::string& symbolToStr(SymbolId pSymbolId) const;
+
+  /**
+   * @brief Get the identifier of the atom of a fact, create it if it does not exist yet.
+   * @param[in] pFact Fact to consider.
+   * @return The identifier of the atom or nothing if the fact is not ground (= it has a parameter or a fluent argument).
+   */
+  std::optional<FactId> getOrCreateFactId(const Fact& pFact);
+
+  /**
+   * @brief Get the identifier of the atom of a fact without creating it.<br/>
+   * It does not allocate memory.
+   * @param[in] pFact Fact to consider.
+   * @return The identifier of the atom or nothing if the fact is not ground or if the atom was never interned.
+   */
+  std::optional<FactId> getFactId(const Fact& pFact) const;
+
+  /// Is the fact ground (= all the arguments are entities and none of them is a parameter).
+  static bool isGround(const Fact& pFact);
+
+  /// Number of atoms interned.
+  std::size_t nbOfFactIds() const { return _factIdToSymbols.size(); }
+
+private:
+  std::unordered_map<std::string, SymbolId> _strToSymbolId;
+  std::vector<std::string> _symbolIdToStr;
+  /// Hash of the symbols of an atom to the atoms having this hash.
+  std::unordered_multimap<std::size_t, FactId> _atomHashToFactIds;
+  /// Atom to its symbols, the predicate name first and then the arguments.
+  std::vector<std::vector<SymbolId>> _factIdToSymbols;
+
+  std::optional<std::size_t> _getAtomHash(const Fact& pFact) const;
+};
+
+} // namespace ogp
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_TYPES_FACTID_HPP
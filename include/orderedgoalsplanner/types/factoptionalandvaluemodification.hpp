@@ -14,6 +14,11 @@ enum class ValueModification
   EXISTS
 };
 
+/**
+ * Optional fact with the way its value is modified.<br/>
+ * It holds a copy of the optional fact because Condition::forAll gives temporary facts to its callbacks,
+ * for example the negation of a fact under a not or on the left of an imply, and the callbacks store them.
+ */
 struct ORDEREDGOALSPLANNER_API FactOptionalAndValueModification
 {
   FactOptionalAndValueModification(const FactOptional& pFactOpt,
@@ -45,7 +50,7 @@ struct ORDEREDGOALSPLANNER_API FactOptionalAndValueModification
     return factOpt.fact.doesFactEffectOfSuccessorGiveAnInterestForSuccessor(pOptFact.factOpt.fact);
   }
 
-  const FactOptional& factOpt;
+  FactOptional factOpt;
   ValueModification vm;
 };
 
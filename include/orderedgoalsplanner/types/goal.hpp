@@ -1,9 +1,12 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_GOAL_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_GOAL_HPP
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <chrono>
+#include <vector>
 #include "condition.hpp"
 #include "factoptional.hpp"
 #include "../util/api.hpp"
@@ -129,6 +132,24 @@ private:
   std::set<std::string> _cacheOfEventsIdThatCanSatisfyThisGoal;
   std::set<ActionId> _cacheOfActionsPredecessors;
   std::set<FullEventId> _cacheOfEventsPredecessors;
+  /// Predicates of the facts of the objective. It is empty if the satisfaction of the objective cannot be cached.
+  std::vector<std::string> _watchedPredicates;
+  /// Satisfaction of the objective in the world state where it was checked for the last time.
+  struct SatisfactionCache
+  {
+    /// Identifier of the world state, 0 if the satisfaction was never checked.
+    std::uint64_t worldStateId = 0;
+    /// Sequence number of the last modification of the world state when the satisfaction was checked.
+    std::uint64_t sequenceNumber = 0;
+    bool isSatisfied = false;
+  };
+  /// Written by WorldState::isGoalSatisfied, that is const, so it is protected for the goals checked by several threads.
+  mutable SatisfactionCache _satisfactionCache;
+  mutable std::mutex _satisfactionCacheMutex;
+
+  SatisfactionCache _getSatisfactionCache() const;
+
+  friend struct WorldState;
 };
 
 } // !ogp
@@ -4,6 +4,8 @@
 #include <set>
 #include <map>
 #include <memory>
+#include <optional>
+#include <vector>
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/types/fact.hpp>
 #include <orderedgoalsplanner/types/goal.hpp>
@@ -233,15 +235,59 @@ struct ORDEREDGOALSPLANNER_API GoalStack
 
   bool isOrderedGoals() const;
 
+  /**
+   * @brief Get a hash of the goals, their priorities, their order and the effect between the goals.<br/>
+   * The attributes of the goals that change how they are removed from the stack (persistence, maximum time
+   * to keep inactive and if they are inactive) are taken into account, not the time since they are inactive.<br/>
+   * It is the same for the copies of the goal stack. The cost is linear in the number of goals.
+   */
+  std::uint64_t hash() const;
+
   /// Effect to apply automatically between ordered goals.
   std::unique_ptr<ogp::WorldStateModification> effectBetweenGoals{};
 
+  /// Identifier of an open checkpoint of the goals.
+  struct Checkpoint
+  {
+    /// Number of checkpoints that were already open when the checkpoint was opened.
+    std::size_t nbOfOpenCheckpointsBefore;
+  };
+
+  /**
+   * @brief Open a checkpoint.<br/>
+   * The goals are saved only when they are modified for the first time after the checkpoint.
+   * @return The checkpoint to give to rollbackTo or to releaseCheckpoint.
+   */
+  Checkpoint checkpoint();
+
+  /**
+   * @brief Restore the goals as they were when a checkpoint was opened.<br/>
+   * The checkpoint and the checkpoints opened after it are closed. The observers are not notified.
+   * @param[in] pCheckpoint Checkpoint to restore.
+   */
+  void rollbackTo(const Checkpoint& pCheckpoint);
+
+  /// Keep the modifications of the goals done since a checkpoint and close the checkpoint.
+  void releaseCheckpoint(const Checkpoint& pCheckpoint);
+
 
 private:
   /// Map of priority to goals.
   std::map<int, std::vector<Goal>> _goals{};
   /// Current active goal.
   const Goal* _currentGoalPtr = nullptr;
+  /// Goals saved for a checkpoint.
+  struct GoalsSnapshot
+  {
+    std::map<int, std::vector<Goal>> goals;
+    /// Priority and index of the current active goal.
+    std::optional<std::pair<int, std::size_t>> currentGoalPosition;
+  };
+  /// For each open checkpoint, the goals before their first modification after the checkpoint (null if not modified yet).
+  std::vector<std::shared_ptr<const GoalsSnapshot>> _goalsBeforeCheckpoints{};
+
+  /// Save the goals for the open checkpoints that did not save them yet. To call before any modification of the goals.
+  void _saveGoalsBeforeModification();
 
   void _removeNoStackableGoalsAndNotifyGoalsChanged(const WorldState& pWorldState,
                                                     const SetOfEntities& pConstants,
@@ -1,9 +1,12 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_HISTORICAL_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_TYPES_HISTORICAL_HPP
 
+#include <cstdint>
 #include <mutex>
 #include <memory>
 #include <map>
+#include <string>
+#include <vector>
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/util/alias.hpp>
 
@@ -15,6 +18,11 @@ namespace ogp
 /// Container of the actions already done.
 struct ORDEREDGOALSPLANNER_API Historical
 {
+  Historical() = default;
+  /// The copy does not inherit the checkpoints of the copied historical.
+  Historical(const Historical& pOther);
+  Historical& operator=(const Historical& pOther);
+
   /// Set the mutex.
   void setMutex(std::shared_ptr<std::mutex> pMutex);
 
@@ -38,11 +46,49 @@ struct ORDEREDGOALSPLANNER_API Historical
    */
   std::size_t getNbOfTimeAnActionHasAlreadyBeenDone(const ActionId& pActionId) const;
 
+  /**
+   * @brief Get a hash of the actions done and of their number of times.<br/>
+   * It is the same for the copies of the historical. The cost is linear in the number of actions done.
+   */
+  std::uint64_t hash() const;
+
+  /// Convert the actions done and their number of times to a string, ordered by action identifier.
+  std::string toStr() const;
+
+  /// Position in the trail of the actions done.
+  struct Checkpoint
+  {
+    /// Size of the trail when the checkpoint was opened.
+    std::size_t trailSize;
+    /// Number of checkpoints that were already open when the checkpoint was opened.
+    std::size_t nbOfOpenCheckpointsBefore;
+  };
+
+  /**
+   * @brief Open a checkpoint.<br/>
+   * While a checkpoint is open, the actions done are recorded so that they can be forgotten with rollbackTo.
+   * @return The checkpoint to give to rollbackTo or to releaseCheckpoint.
+   */
+  Checkpoint checkpoint();
+
+  /**
+   * @brief Forget the actions done since a checkpoint.<br/>
+   * The checkpoint and the checkpoints opened after it are closed.
+   * @param pCheckpoint Checkpoint to restore.
+   */
+  void rollbackTo(const Checkpoint& pCheckpoint);
+
+  /// Keep the actions done since a checkpoint and close the checkpoint.
+  void releaseCheckpoint(const Checkpoint& pCheckpoint);
+
 private:
   /// Mutex to proect this struct.
   std::shared_ptr<std::mutex> _mutexPtr;
   /// Action to the number of time the action has already been done.
   std::map<ActionId, std::size_t> _actionToNumberOfTimeAleardyDone;
+  /// Actions done since the oldest open checkpoint.
+  std::vector<ActionId> _trail;
+  std::size_t _nbOfOpenCheckpoints = 0;
 
   // Notify that an action finished.
   void _notifyActionDone(const ActionId& pActionId);
@@ -50,6 +96,10 @@ private:
   bool _hasActionAlreadyBeenDone(const ActionId& pActionId) const;
   // Get the number of time that an action has already been done.
   std::size_t _getNbOfTimeAnActionHasAlreadyBeenDone(const ActionId& pActionId) const;
+  // Get a hash of the actions done.
+  std::uint64_t _hash() const;
+  // Convert the actions done to a string.
+  std::string _toStr() const;
 };
 
 
@@ -31,6 +31,8 @@ struct LookForAnActionOutputInfos
   std::size_t nbOfNotSatisfiedGoals() const { return _nbOfNonPersistentGoalsNotSatisfied; }
   std::size_t nbOfSatisfiedGoals() const { return _goalsSatisfied.size(); }
   bool isFirstGoalInSuccess() const { return _firstGoalInSuccess && *_firstGoalInSuccess; }
+  /// Was a goal notified as satisfied or as not satisfied.
+  bool hasAGoalBeenNotified() const { return _firstGoalInSuccess.has_value(); }
   void moveGoalsDone(std::list<Goal>& pGoals) { pGoals = std::move(_goalsSatisfied); }
 
 private:
@@ -1,6 +1,8 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_ONTOLOGY_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_TYPES_ONTOLOGY_HPP
 
+#include <cstdint>
+#include <utility>
 #include "../util/api.hpp"
 #include "setofderivedpredicates.hpp"
 #include "setofentities.hpp"
@@ -27,11 +29,25 @@ struct ORDEREDGOALSPLANNER_API Ontology
     return derivedPredicates.nameToPredicatePtr(pName);
   }
 
+  std::shared_ptr<const Predicate> nameToPredicateSharedPtr(const std::string& pName) const
+  {
+    auto predicatePtr = predicates.nameToPredicateSharedPtr(pName);
+    if (predicatePtr)
+      return predicatePtr;
+    return derivedPredicates.nameToPredicateSharedPtr(pName);
+  }
+
   void updateImmutablePredicates()
   {
     predicates.updateImmutablePredicates();
     derivedPredicates.updateImmutablePredicates();
   }
+
+  /// Versions of the predicates and of the derived predicates, to know if the predicates changed.
+  std::pair<std::uint64_t, std::uint64_t> predicatesVersion() const
+  {
+    return {predicates.version(), derivedPredicates.version()};
+  }
 };
 
 } // namespace ogp
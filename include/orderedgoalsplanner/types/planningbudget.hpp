@@ -0,0 +1,63 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_PLANNINGBUDGET_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_TYPES_PLANNINGBUDGET_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include "../util/api.hpp"
+
+namespace ogp
+{
+
+/**
+ * Token to cancel a plan resolution from another thread.<br/>
+ * The copies of a token share the same state.
+ */
+struct ORDEREDGOALSPLANNER_API CancellationToken
+{
+  CancellationToken()
+    : _isCancelled(std::make_shared<std::atomic<bool>>(false))
+  {
+  }
+
+  void cancel() const { _isCancelled->store(true, std::memory_order_relaxed); }
+  bool isCancelled() const { return _isCancelled->load(std::memory_order_relaxed); }
+
+private:
+  std::shared_ptr<std::atomic<bool>> _isCancelled;
+};
+
+
+/**
+ * Budget of a plan resolution.<br/>
+ * When the budget is exhausted the planner stops the search and returns the plan found so far.<br/>
+ * The goals that were not planned stay in the goal stack, even the non persistent ones.
+ */
+struct ORDEREDGOALSPLANNER_API PlanningBudget
+{
+  /// Time point after which the planner has to return as soon as possible.
+  std::optional<std::chrono::steady_clock::time_point> deadline;
+  /// Maximum number of search nodes expanded, rollouts included.
+  std::optional<std::size_t> maxNbOfExpansions;
+  /// Token polled by the planner to abort the plan resolution.
+  CancellationToken cancellationToken;
+};
+
+
+enum class PlanningStatus
+{
+  /// The planner did all the search it does without budget.
+  COMPLETED,
+  /// The budget was exhausted, so the plan can be less optimal or can cover less goals.
+  TRUNCATED,
+  /// The cancellation token was cancelled, the plan is not complete.
+  CANCELLED
+};
+
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_TYPES_PLANNINGBUDGET_HPP
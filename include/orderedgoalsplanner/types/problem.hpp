@@ -46,6 +46,40 @@ struct ORDEREDGOALSPLANNER_API Problem
 
   /// History of actions done.
   Historical historical;
+
+  /// Checkpoint of the parts of the problem that are modified when an action is applied.
+  struct Checkpoint
+  {
+    WorldState::Checkpoint worldState;
+    GoalStack::Checkpoint goalStack;
+    Historical::Checkpoint historical;
+  };
+
+  /**
+   * @brief Open a checkpoint on the world state, the goal stack and the historical.<br/>
+   * It allows to apply some actions and to backtrack without copying the problem.
+   * @return The checkpoint to give to rollbackTo or to releaseCheckpoint.
+   */
+  Checkpoint checkpoint()
+  {
+    return Checkpoint{worldState.checkpoint(), goalStack.checkpoint(), historical.checkpoint()};
+  }
+
+  /// Undo all the modifications done since a checkpoint and close the checkpoint.
+  void rollbackTo(const Checkpoint& pCheckpoint)
+  {
+    worldState.rollbackTo(pCheckpoint.worldState);
+    goalStack.rollbackTo(pCheckpoint.goalStack);
+    historical.rollbackTo(pCheckpoint.historical);
+  }
+
+  /// Keep the modifications done since a checkpoint and close the checkpoint.
+  void releaseCheckpoint(const Checkpoint& pCheckpoint)
+  {
+    worldState.releaseCheckpoint(pCheckpoint.worldState);
+    goalStack.releaseCheckpoint(pCheckpoint.goalStack);
+    historical.releaseCheckpoint(pCheckpoint.historical);
+  }
 };
 
 } // !ogp
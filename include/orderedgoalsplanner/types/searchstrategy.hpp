@@ -0,0 +1,52 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_SEARCHSTRATEGY_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_TYPES_SEARCHSTRATEGY_HPP
+
+#include <cstddef>
+#include "../util/api.hpp"
+
+namespace ogp
+{
+
+enum class SearchAlgorithm
+{
+  /// Backward chaining from the goals, the default search of the planner.
+  BACKWARD_CHAINING,
+  /// Forward search that always expands the state with the smallest heuristic value.
+  GREEDY_BEST_FIRST,
+  /// Forward search that expands the state with the smallest cost plus the weighted heuristic value.
+  WEIGHTED_A_STAR
+};
+
+
+/// Heuristics of the forward searches, computed on the problem without the removals of facts (delete relaxation).
+enum class RelaxedHeuristic
+{
+  /// Sum of the costs to reach each fact of the goal.
+  H_ADD,
+  /// Number of actions of a relaxed plan extracted from the supporters of h_add.
+  H_FF
+};
+
+
+/**
+ * Search used to plan for the goals.<br/>
+ * The forward searches only apply to domains and goals that can be grounded to STRIPS (conjunctions of
+ * boolean facts, no events), the other goals are planned with the backward chaining.
+ */
+struct ORDEREDGOALSPLANNER_API SearchStrategy
+{
+  SearchAlgorithm algorithm = SearchAlgorithm::BACKWARD_CHAINING;
+  RelaxedHeuristic heuristic = RelaxedHeuristic::H_FF;
+  /// Weight of the heuristic for WEIGHTED_A_STAR. H_ADD and H_FF are not admissible, so even with 1 the plans are not guaranteed to be optimal.
+  double weight = 1.;
+  /// Maximum number of states expanded by a forward search before falling back to the backward chaining.
+  std::size_t maxNbOfExpansions = 100000;
+  /// Maximum number of ground actions, above it the forward search is not tried.
+  std::size_t maxNbOfGroundActions = 100000;
+};
+
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_TYPES_SEARCHSTRATEGY_HPP
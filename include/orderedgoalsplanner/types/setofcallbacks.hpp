@@ -2,6 +2,7 @@
 #define INCLUDE_ORDEREDGOALSPLANNER_TYPES_SETOFCALLBACKS_HPP
 
 #include <map>
+#include <memory>
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/types/conditiontocallback.hpp>
 #include <orderedgoalsplanner/types/factoptionalstoid.hpp>
@@ -9,6 +10,7 @@
 
 namespace ogp
 {
+struct IncrementalMatcher;
 
 
 /// Container of a set of conditions to callback.
@@ -22,11 +24,15 @@ struct ORDEREDGOALSPLANNER_API SetOfCallbacks
   const std::map<CallbackId, ConditionToCallback>& callbacks() const { return _callbacks; }
   std::map<CallbackId, ConditionToCallback>& callbacks() { return _callbacks; }
   const FactOptionalsToId& conditionsToIds() const { return _conditionsToIds; }
+  /// Incremental matcher of the condition of a callback, nullptr if the condition is not supported by the matcher.
+  const IncrementalMatcher* incrementalMatcher(const CallbackId& pCallbackId) const;
 
 
 private:
   std::map<CallbackId, ConditionToCallback> _callbacks{};
   FactOptionalsToId _conditionsToIds;
+  /// Incremental matchers of the conditions that can be compiled.
+  std::map<CallbackId, std::shared_ptr<const IncrementalMatcher>> _callbackIdToIncrementalMatcher;
 };
 
 
@@ -2,6 +2,7 @@
 #define INCLUDE_ORDEREDGOALSPLANNER_TYPES_SETOFDERIVEDPREDICATES_HPP
 
 #include "../util/api.hpp"
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -21,6 +22,7 @@ struct ORDEREDGOALSPLANNER_API SetOfDerivedPredicates
   void addDerivedPredicate(const DerivedPredicate& pDerivedPredicate);
 
   const Predicate* nameToPredicatePtr(const std::string& pPredicateName) const;
+  std::shared_ptr<const Predicate> nameToPredicateSharedPtr(const std::string& pPredicateName) const;
 
   std::unique_ptr<Condition> optFactToConditionPtr(const FactOptional& pFactOptional,
                                                    bool pAutoAddImmutablePredicates) const;
@@ -32,8 +34,14 @@ struct ORDEREDGOALSPLANNER_API SetOfDerivedPredicates
 
   const std::map<std::string, DerivedPredicate>& nameToDerivedPredicate() const { return _nameToDerivedPredicate; }
 
+  /// Version of the derived predicates. It changes at each modification and two different sets never have the same version.
+  std::uint64_t version() const { return _version; }
+
 private:
   std::map<std::string, DerivedPredicate> _nameToDerivedPredicate;
+  /// Predicate records of the derived predicates to share with the facts.
+  std::map<std::string, std::shared_ptr<const Predicate>> _nameToPredicate;
+  std::uint64_t _version;
 };
 
 } // namespace ogp
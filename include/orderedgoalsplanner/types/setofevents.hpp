@@ -2,6 +2,7 @@
 #define INCLUDE_ORDEREDGOALSPLANNER_TYPES_SETOFEVENTS_HPP
 
 #include <map>
+#include <memory>
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/types/event.hpp>
 #include <orderedgoalsplanner/types/factoptionalstoid.hpp>
@@ -9,6 +10,7 @@
 
 namespace ogp
 {
+struct IncrementalMatcher;
 
 /// Container of a set of events.
 struct ORDEREDGOALSPLANNER_API SetOfEvents
@@ -33,6 +35,8 @@ struct ORDEREDGOALSPLANNER_API SetOfEvents
   std::map<EventId, Event>& events() { return _events; }
   /// Reachable event links.
   const FactOptionalsToId& reachableEventLinks() const { return _reachableEventLinks; }
+  /// Incremental matcher of the precondition of an event, nullptr if the precondition is not supported by the matcher.
+  const IncrementalMatcher* incrementalMatcher(const EventId& pEventId) const;
 
 
 private:
@@ -40,6 +44,8 @@ private:
   std::map<EventId, Event> _events{};
   /// Reachable event links.
   FactOptionalsToId _reachableEventLinks{};
+  /// Incremental matchers of the preconditions that can be compiled.
+  std::map<EventId, std::shared_ptr<const IncrementalMatcher>> _eventIdToIncrementalMatcher{};
 };
 
 } // !ogp
@@ -2,14 +2,19 @@
 #define INCLUDE_ORDEREDGOALSPLANNER_SETOFFACTS_HPP
 
 #include "../util/api.hpp"
+#include <cstdint>
+#include <functional>
 #include <list>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
 #include <orderedgoalsplanner/types/entitieswithparamconstraints.hpp>
+#include <orderedgoalsplanner/types/factid.hpp>
 
 
 namespace ogp
@@ -21,9 +26,37 @@ struct Parameter;
 struct SetOfEntities;
 
 
+/**
+ * Set of facts with indexes to find them quickly.<br/>
+ * The facts are stored in chunks, one per predicate, that are shared between the copies of a set of facts.<br/>
+ * A chunk is duplicated only when a copy that shares it is modified, so copying a set of facts is cheap.
+ */
 struct ORDEREDGOALSPLANNER_API SetOfFacts
 {
+private:
+  /// Index of a fact in the slots of its chunk.
+  using FactSlot = std::uint32_t;
+  struct Chunk;
+  struct PostingList;
+  struct AtomFacts;
+  struct SignatureIndex;
+
+  struct FactRecord
+  {
+    /// False if the fact is timeless.
+    bool canBeRemoved;
+    FactSlot slot;
+  };
+
+public:
   SetOfFacts();
+  /// The copy does not inherit the checkpoints of the copied set of facts.
+  SetOfFacts(const SetOfFacts& pOther);
+  /// Like the copy, the move does not inherit the checkpoints of the moved set of facts.
+  SetOfFacts(SetOfFacts&& pOther);
+  ~SetOfFacts();
+  SetOfFacts& operator=(const SetOfFacts& pOther);
+  SetOfFacts& operator=(SetOfFacts&& pOther);
 
   struct Delta
   {
@@ -35,8 +68,36 @@ struct ORDEREDGOALSPLANNER_API SetOfFacts
     std::string toPddl() const;
   };
 
+  /// Modification of a delta. The fact is owned by one of the two compared sets of facts.
+  struct DeltaEntry
+  {
+    const Fact* factPtr;
+    /// True if the fact was added, false if it was removed.
+    bool isAdded;
+  };
+
   Delta deltaFrom(const SetOfFacts& pOldSetOfFacts) const;
 
+  /**
+   * @brief Compute the delta from an old set of facts into a buffer, without copying the facts.<br/>
+   * The entries stay valid as long as the two sets of facts are not modified.
+   * @param[out] pDeltaEntries Buffer of the delta. It is cleared first, so it can be reused from a call to another.
+   * @param[in] pOldSetOfFacts Set of facts to compare with.
+   */
+  void deltaFrom(std::vector<DeltaEntry>& pDeltaEntries,
+                 const SetOfFacts& pOldSetOfFacts) const;
+
+  /**
+   * @brief Iterate over the delta from an old set of facts.<br/>
+   * The facts of each predicate are compared with a merge of their sorted containers, so it costs O(number of facts of the modified predicates).
+   * The predicates shared with the old set of facts are skipped.<br/>
+   * Like in Delta, a removed fact is not notified if a fact with the same arguments was added (= only the value changed).
+   * @param[in] pCallback Called for each fact of the delta, with true if the fact was added and false if it was removed.
+   * @param[in] pOldSetOfFacts Set of facts to compare with.
+   */
+  void iterateOnDeltaFrom(const std::function<void (const Fact&, bool)>& pCallback,
+                          const SetOfFacts& pOldSetOfFacts) const;
+
   static SetOfFacts fromPddl(const std::string& pStr,
                              std::size_t& pPos,
                              const Ontology& pOntology,
@@ -48,62 +109,185 @@ struct ORDEREDGOALSPLANNER_API SetOfFacts
   bool add(const Fact& pFact,
            bool pCanBeRemoved = true);
 
-  bool erase(const Fact& pValue);
-
-  std::map<Fact, bool>::iterator eraseFactIt(std::map<Fact, bool>::iterator pFactIt);
+  /**
+   * @brief Remove a fact.
+   * @param[in] pValue Fact to remove. If it is not in this set, the first fact matching it is removed.
+   * @param[out] pErasedFactPtr If it is not null, it is set to the fact that was removed.
+   * @return True if a fact was removed.
+   */
+  bool erase(const Fact& pValue,
+             std::optional<Fact>* pErasedFactPtr = nullptr);
 
   void clear();
 
-  class SetOfFactIterator {
-     public:
-         // Constructor accepting reference to std::list<Toto*>
-         SetOfFactIterator(const std::list<Fact>* listPtr)
-           : _listPtr(listPtr),
-             _list()
-         {}
-
-         SetOfFactIterator(std::list<Fact>&& list)
-           : _listPtr(nullptr),
-             _list(std::move(list))
-         {}
-
-         // Custom iterator class for non-const access
-         class Iterator {
-             typename std::list<Fact>::const_iterator iter;
-
-         public:
-             Iterator(typename std::list<Fact>::const_iterator it) : iter(it) {}
-
-             // Overload the dereference operator to return Toto& instead of Toto*
-             const Fact& operator*() const { return *iter; }
-
-             // Pre-increment operator
-             Iterator& operator++() {
-                 ++iter;
-                 return *this;
-             }
-
-             bool operator==(const Iterator& other) const { return iter == other.iter; }
-             bool operator!=(const Iterator& other) const { return iter != other.iter; }
-         };
-
-         // Begin and end methods to return the custom iterator
-         Iterator begin() const { return Iterator(_listPtr != nullptr ? _listPtr->begin() : _list.begin()); }
-         Iterator end() const { return Iterator(_listPtr != nullptr ? _listPtr->end() : _list.end()); }
-         bool empty() const { return begin() == end(); }
-         std::string toStr() const;
-
-     private:
-         const std::list<Fact>* _listPtr;
-         std::list<Fact> _list;
+  /// Position in the trail of the modifications, to restore the facts as they were at this position.
+  struct Checkpoint
+  {
+    /// Size of the trail when the checkpoint was opened.
+    std::size_t trailSize;
+    /// Number of checkpoints that were already open when the checkpoint was opened.
+    std::size_t nbOfOpenCheckpointsBefore;
+  };
+
+  /**
+   * @brief Open a checkpoint.<br/>
+   * While a checkpoint is open, the insertions and the removals of facts are recorded in a trail.
+   * @return The checkpoint to give to rollbackTo or to releaseCheckpoint.
+   */
+  Checkpoint checkpoint();
+
+  /**
+   * @brief Undo all the modifications done since a checkpoint, in O(number of modifications).<br/>
+   * The removed facts are put back at the positions they had, so find() gives the facts in the same order as before the checkpoint.<br/>
+   * The checkpoint and the checkpoints opened after it are closed.
+   * @param[in] pCheckpoint Checkpoint to restore.
+   */
+  void rollbackTo(const Checkpoint& pCheckpoint);
+
+  /**
+   * @brief Keep the modifications done since a checkpoint.<br/>
+   * The checkpoint and the checkpoints opened after it are closed.
+   * @param[in] pCheckpoint Checkpoint to close.
+   */
+  void releaseCheckpoint(const Checkpoint& pCheckpoint);
+
+  /**
+   * @brief Iterate over the modifications done since a checkpoint that is still open, in their order.
+   * @param[in] pCallback Called for each insertion or removal of a fact, with true if the fact was added.
+   * @param[in] pCheckpoint Open checkpoint.
+   */
+  void iterateOnModificationsSince(const std::function<void (const Fact&, bool)>& pCallback,
+                                   const Checkpoint& pCheckpoint) const;
+
+  /**
+   * Read-only view of all the facts, ordered like a std::map<Fact, bool>. The bool is false if the fact is timeless.<br/>
+   * It replaces the std::map<Fact, bool> that was returned before the facts were stored in shared chunks.
+   * It has the same read functions, and it converts implicitly to the map for the code that still needs one.
+   */
+  class ORDEREDGOALSPLANNER_API FactsView {
+  public:
+    FactsView(const SetOfFacts& pSetOfFacts)
+      : _setOfFactsPtr(&pSetOfFacts)
+    {}
+
+    class Iterator {
+    public:
+      using ChunkIterator = std::map<std::string, std::shared_ptr<const Chunk>>::const_iterator;
+
+      Iterator(ChunkIterator pChunkIt,
+               ChunkIterator pChunkEnd);
+      Iterator(ChunkIterator pChunkIt,
+               ChunkIterator pChunkEnd,
+               std::map<Fact, FactRecord>::const_iterator pFactIt);
+
+      /// Fact and false if the fact is timeless.
+      std::pair<const Fact&, bool> operator*() const;
+      Iterator& operator++();
+
+      bool operator==(const Iterator& pOther) const;
+      bool operator!=(const Iterator& pOther) const { return !operator==(pOther); }
+
+    private:
+      ChunkIterator _chunkIt;
+      ChunkIterator _chunkEnd;
+      std::map<Fact, FactRecord>::const_iterator _factIt;
+    };
+
+    Iterator begin() const;
+    Iterator end() const;
+    std::size_t size() const { return _setOfFactsPtr->_nbOfFacts; }
+    bool empty() const { return _setOfFactsPtr->_nbOfFacts == 0; }
+    std::size_t count(const Fact& pFact) const { return _setOfFactsPtr->contains(pFact) ? 1 : 0; }
+    /// Find a fact, like std::map<Fact, bool>::find.
+    Iterator find(const Fact& pFact) const;
+    /// Copy the facts in a map.
+    std::map<Fact, bool> toMap() const;
+    /// Copy the facts in a map, for the code written when the facts were a std::map<Fact, bool>.
+    operator std::map<Fact, bool>() const { return toMap(); }
+
+  private:
+    const SetOfFacts* _setOfFactsPtr;
+  };
+
+  /// View over the facts matching a search, in the order of their insertion.
+  class ORDEREDGOALSPLANNER_API SetOfFactIterator {
+  public:
+    /// Construct an empty view.
+    SetOfFactIterator()
+      : _slotToFactPtr(nullptr),
+        _slotsPtr(nullptr),
+        _slots()
+    {}
+
+    /// Construct a view over slots owned by a chunk.
+    SetOfFactIterator(const std::vector<const Fact*>& pSlotToFact,
+                      const std::vector<FactSlot>& pSlots)
+      : _slotToFactPtr(&pSlotToFact),
+        _slotsPtr(&pSlots),
+        _slots()
+    {}
+
+    /// Construct a view over slots owned by the view.
+    SetOfFactIterator(const std::vector<const Fact*>& pSlotToFact,
+                      std::vector<FactSlot>&& pSlots)
+      : _slotToFactPtr(&pSlotToFact),
+        _slotsPtr(nullptr),
+        _slots(std::move(pSlots))
+    {}
+
+    class Iterator {
+    public:
+      Iterator(const std::vector<const Fact*>* pSlotToFactPtr,
+               std::vector<FactSlot>::const_iterator pIt,
+               std::vector<FactSlot>::const_iterator pEnd)
+        : _slotToFactPtr(pSlotToFactPtr),
+          _it(pIt),
+          _end(pEnd)
+      {
+        _skipRemovedFacts();
+      }
+
+      const Fact& operator*() const { return *(*_slotToFactPtr)[*_it]; }
+
+      Iterator& operator++() {
+        ++_it;
+        _skipRemovedFacts();
+        return *this;
+      }
+
+      bool operator==(const Iterator& pOther) const { return _it == pOther._it; }
+      bool operator!=(const Iterator& pOther) const { return _it != pOther._it; }
+
+    private:
+      const std::vector<const Fact*>* _slotToFactPtr;
+      std::vector<FactSlot>::const_iterator _it;
+      std::vector<FactSlot>::const_iterator _end;
+
+      void _skipRemovedFacts()
+      {
+        while (_it != _end && *_it == _removedSlot)
+          ++_it;
+      }
+    };
+
+    Iterator begin() const { return Iterator(_slotToFactPtr, _getSlots().begin(), _getSlots().end()); }
+    Iterator end() const { return Iterator(_slotToFactPtr, _getSlots().end(), _getSlots().end()); }
+    bool empty() const { return begin() == end(); }
+    std::string toStr() const;
+
+  private:
+    const std::vector<const Fact*>* _slotToFactPtr;
+    const std::vector<FactSlot>* _slotsPtr;
+    std::vector<FactSlot> _slots;
+
+    const std::vector<FactSlot>& _getSlots() const { return _slotsPtr != nullptr ? *_slotsPtr : _slots; }
   };
 
 
   SetOfFactIterator find(const Fact& pFact,
                          bool pIgnoreValue = false) const;
 
-  const std::map<Fact, bool>& facts() const { return _facts; }
-  std::map<Fact, bool>& facts() { return _facts; }
+  FactsView facts() const { return FactsView(*this); }
 
   /**
    * @brief Get the value of a fact in the world state.
@@ -112,6 +296,14 @@ struct ORDEREDGOALSPLANNER_API SetOfFacts
    */
   std::optional<Entity> getFluentValue(const Fact& pFact) const;
 
+  /**
+   * @brief Get the numeric value of a fact in the world state.<br/>
+   * The numbers are parsed once when the facts are added, so it does not parse the value of the fact.
+   * @param[in] pFact Fact to extract the value.
+   * @return The value of the fact if it is a number, nothing otherwise.
+   */
+  std::optional<Number> getFluentNumber(const Fact& pFact) const;
+
   /**
    * @brief Extract the potential arguments of a fact parameter.
    * @param[out] pPotentialArgumentsOfTheParameter The extracted the potential arguments of a fact parameter.
@@ -126,37 +318,94 @@ struct ORDEREDGOALSPLANNER_API SetOfFacts
 
   bool hasFact(const Fact& pFact) const;
 
-  bool empty() const { return _facts.empty(); }
+  /**
+   * @brief Check if a fact is in this set.<br/>
+   * For ground facts it is a lookup of the fact identifier instead of a comparison of the facts.
+   * @param[in] pFact Fact to check.
+   * @return True if the fact is in this set.
+   */
+  bool contains(const Fact& pFact) const;
+
+  /**
+   * @brief Get the facts holding at least one of the entities, in an argument, in a fluent argument or in the value.<br/>
+   * It costs O(number of predicates + number of facts holding the entities).
+   * @param[in] pEntityIds Values of the entities to consider.
+   * @return The facts holding the entities, with false if the fact is timeless.
+   */
+  std::list<std::pair<Fact, bool>> getFactsHoldingEntities(const std::set<std::string>& pEntityIds) const;
 
-  void updateImmutableFacts(const Ontology& pOntology);
+  /// Check if a fact of this set holds an entity, in an argument, in a fluent argument or in the value.
+  bool hasEntity(const std::string& pEntityId) const;
 
-private:
-  /// Fact to bool True if the fact is timeless
-  std::map<Fact, bool> _facts;
-  std::optional<std::map<std::string, std::list<Fact>>> _exactCallToListsOpt;
-  std::optional<std::map<std::string, std::list<Fact>>> _exactCallWithoutValueToListsOpt;
-  struct ParameterToValues
-  {
-    ParameterToValues(std::size_t pNbOfArgs)
-     : all(),
-       argIdToArgValueToValues(pNbOfArgs),
-       fluentValueToValues()
-    {
-    }
-    std::list<Fact> all;
-    std::vector<std::map<std::string, std::list<Fact>>> argIdToArgValueToValues;
-    std::map<std::string, std::list<Fact>> fluentValueToValues;
-  };
-  std::map<std::string, ParameterToValues> _signatureToLists;
+  bool empty() const { return _nbOfFacts == 0; }
+  std::size_t size() const { return _nbOfFacts; }
 
-  bool _erase(const Fact& pValue);
+  /**
+   * @brief Get the Zobrist hash of the facts.<br/>
+   * It is updated in constant time for each fact added or removed, it does not depend on the order of the insertions
+   * and it is the same for all the copies that have the same facts.<br/>
+   * The key of a fact is computed from its name, its arguments and its value, not from an identifier
+   * local to the process, so the hash is the same from one execution to another.
+   */
+  std::uint64_t hash() const { return _hash; }
 
-  // TODO: can be static
-  void _removeAValueForList(std::list<Fact>& pList,
-                            const Fact& pValue) const;
+  /**
+   * @brief Add the immutable facts that correspond to the facts and remove the other immutable facts.<br/>
+   * The immutable facts that are already right are kept.
+   * @param[in] pOntology Ontology containing the immutable predicates.
+   * @param[out] pModificationsPtr If not null, it receives the facts removed (false) and added (true), in that order.
+   */
+  void updateImmutableFacts(const Ontology& pOntology,
+                            std::list<std::pair<Fact, bool>>* pModificationsPtr = nullptr);
 
-  const std::list<Fact>* _findAnExactCall(const std::optional<std::map<std::string, std::list<Fact>>>& pExactCalls,
-                                          const std::string& pExactCall) const;
+private:
+  /// Value of a slot removed from a posting list.
+  static constexpr FactSlot _removedSlot = static_cast<FactSlot>(-1);
+
+  /// Modification recorded while a checkpoint is open.
+  struct TrailEntry;
+  struct Snapshot;
+
+  /// Predicate name to the facts of this predicate.
+  std::map<std::string, std::shared_ptr<const Chunk>> _predicateNameToChunk;
+  std::size_t _nbOfFacts;
+  /// Xor of the Zobrist keys of the facts.
+  std::uint64_t _hash;
+  /// Modifications done since the oldest open checkpoint.
+  std::vector<TrailEntry> _trail;
+  std::size_t _nbOfOpenCheckpoints;
+
+  const Chunk* _getChunk(const std::string& pPredicateName) const;
+  /// Get a chunk that is not shared with another set of facts, the chunk is created if it does not exist.
+  Chunk& _getChunkToModify(const std::string& pPredicateName);
+  void _removeChunkIfEmpty(const std::string& pPredicateName);
+
+  bool _erase(const Fact& pValue,
+              bool pEvenIfTimeless = false);
+  /// Record in the trail the replacement of all the facts by the new facts (or by nothing if pNewFactsPtr is null).
+  void _recordReplacementOfAllTheFacts(const SetOfFacts* pNewFactsPtr);
+  void _closeCheckpoint(const Checkpoint& pCheckpoint);
+  /**
+   * @brief Add a fact in a chunk and in its posting lists.
+   * @param[in] pPositionsPtr If it is not null, positions of the fact in its posting lists, as given by _eraseFactFromChunk.
+   */
+  void _addFactToChunk(Chunk& pChunk,
+                       const Fact& pFact,
+                       bool pCanBeRemoved,
+                       const std::vector<std::size_t>* pPositionsPtr);
+  /**
+   * @brief Remove a fact from a chunk and from its posting lists.
+   * @param[out] pPositionsPtr If it is not null, the positions the fact had in its posting lists are appended to it.
+   */
+  void _eraseFactFromChunk(Chunk& pChunk,
+                           std::map<Fact, FactRecord>::iterator pFactIt,
+                           std::vector<std::size_t>* pPositionsPtr);
+
+  const PostingList* _findFactsOfAnAtom(const Chunk& pChunk,
+                                        const Fact& pFact) const;
+  /// Update the number of a ground atom from the value of its first fact, like getFluentValue does.
+  static void _refreshFluentNumber(const Chunk& pChunk,
+                                   AtomFacts& pAtomFacts);
 
 };
 
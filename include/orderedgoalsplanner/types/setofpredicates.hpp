@@ -2,8 +2,10 @@
 #define INCLUDE_ORDEREDGOALSPLANNER_TYPES_SETOFPREDICATES_HPP
 
 #include "../util/api.hpp"
+#include <cstdint>
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include "predicate.hpp"
 
@@ -34,6 +36,8 @@ struct ORDEREDGOALSPLANNER_API SetOfPredicates
   void updateImmutablePredicates();
 
   const Predicate* nameToPredicatePtr(const std::string& pName) const;
+  /// Get the predicate record to share with the facts. It is never modified, a new record is created when a predicate is replaced.
+  std::shared_ptr<const Predicate> nameToPredicateSharedPtr(const std::string& pName) const;
   Predicate nameToPredicate(const std::string& pName) const;
 
   std::string toPddl(PredicatePddlType pTypeFilter, std::size_t pIdentation = 0) const;
@@ -42,8 +46,12 @@ struct ORDEREDGOALSPLANNER_API SetOfPredicates
   bool empty() const { return _nameToPredicate.empty(); }
   bool hasPredicateOfPddlType(PredicatePddlType pTypeFilter) const;
 
+  /// Version of the predicates. It changes at each modification and two different sets never have the same version.
+  std::uint64_t version() const { return _version; }
+
 private:
-  std::map<std::string, Predicate> _nameToPredicate;
+  std::map<std::string, std::shared_ptr<const Predicate>> _nameToPredicate;
+  std::uint64_t _version;
 };
 
 } // namespace ogp
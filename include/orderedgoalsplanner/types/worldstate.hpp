@@ -2,10 +2,16 @@
 #define INCLUDE_ORDEREDGOALSPLANNER_TYPES_WORLDSTATE_HPP
 
 #include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <orderedgoalsplanner/types/entitieswithparamconstraints.hpp>
 #include <orderedgoalsplanner/types/fact.hpp>
 #include <orderedgoalsplanner/types/setoffacts.hpp>
@@ -35,7 +41,7 @@ struct ORDEREDGOALSPLANNER_API WorldState
 {
   /// Construct a world state.
   WorldState(const SetOfFacts* pFactsPtr = nullptr);
-  /// Construct a world state from another world state.
+  /// Construct a world state from another world state. The observers and the change journal are not copied.
   WorldState(const WorldState& pOther);
 
   ~WorldState();
@@ -61,6 +67,20 @@ struct ORDEREDGOALSPLANNER_API WorldState
                   const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
                   bool pCanFactsBeRemoved = true);
 
+  /**
+   * @brief Apply a delta computed by SetOfFacts::deltaFrom into a buffer.<br/>
+   * The added facts are applied before the removed facts, like for a SetOfFacts::Delta.
+   * @param[in] pDeltaEntries Entries of the delta. The sets of facts that own the facts must still be alive.
+   */
+  bool applyDelta(const std::vector<SetOfFacts::DeltaEntry>& pDeltaEntries,
+                  GoalStack& pGoalStack,
+                  const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
+                  const SetOfCallbacks& pCallbacks,
+                  const Ontology& pOntology,
+                  const SetOfEntities& pObjects,
+                  const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                  bool pCanFactsBeRemoved = true);
+
   /**
    * @brief Notify that an action has been done.
    * @param[in] pParameters Effect parameters.
@@ -82,8 +102,12 @@ struct ORDEREDGOALSPLANNER_API WorldState
                    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow);
 
 
-  /// Be notified when facts changed.
-  ogpstd::observable::ObservableUnsafe<void (const std::map<Fact, bool>&)> onFactsChanged;
+  /**
+   * Be notified when facts changed.<br/>
+   * The facts are given as a view, so nothing is copied. A callback taking a const std::map<Fact, bool>& still works,
+   * the map is then built for this callback only.
+   */
+  ogpstd::observable::ObservableUnsafe<void (const SetOfFacts::FactsView&)> onFactsChanged;
   /// Be notified when punctual facts changed.
   ogpstd::observable::ObservableUnsafe<void (const std::set<Fact>&)> onPunctualFacts;
   /// Be notified when facts are added.
@@ -91,6 +115,57 @@ struct ORDEREDGOALSPLANNER_API WorldState
   /// Be notified when facts are removed.
   ogpstd::observable::ObservableUnsafe<void (const std::set<Fact>&)> onFactsRemoved;
 
+
+  /// Kind of modification of a fact.
+  enum class FactChangeType
+  {
+    ADDED,
+    REMOVED,
+    PUNCTUAL
+  };
+
+  /// Modification of a fact, with its position in the sequence of the modifications of the world state.
+  struct FactChange
+  {
+    /// Sequence number of the modification. The sequence numbers start at 1 and increase by 1 for each modification.
+    std::uint64_t sequenceNumber;
+    FactChangeType type;
+    /**
+     * Fact modified. It is stored only once in the world state, whatever the number of its modifications.<br/>
+     * It is valid while the modification is in the change journal or while it is notified.
+     */
+    const Fact* factPtr;
+
+    const Fact& fact() const { return *factPtr; }
+  };
+
+  /**
+   * Be notified of the modifications of the facts done since the previous notification.<br/>
+   * Unlike onFactsChanged, it does not give all the facts of the world.<br/>
+   * The modifications undone by rollbackTo are notified as the inverse modifications, like in the change journal.
+   */
+  ogpstd::observable::ObservableUnsafe<void (const std::vector<FactChange>&)> onFactChanges;
+
+  /// Sequence number of the last modification of the facts, 0 if no fact was modified.
+  std::uint64_t lastChangeSequenceNumber() const { return _lastChangeSequenceNumber; }
+
+  /**
+   * @brief Set the maximum number of modifications kept in the change journal.<br/>
+   * The oldest modifications are dropped when the journal is full. By default the capacity is 0, so nothing is kept.
+   * @param[in] pCapacity Maximum number of modifications to keep.
+   */
+  void setChangeJournalCapacity(std::size_t pCapacity);
+
+  /**
+   * @brief Iterate over the modifications of the facts done after a sequence number, in their order.
+   * @param[in] pCallback Called for each modification.
+   * @param[in] pSequenceNumber Sequence number of the last modification already known by the caller.
+   * @return False if some modifications after the sequence number are no longer in the change journal.
+   * In that case nothing is iterated, and the caller should read all the facts again.
+   */
+  bool iterateOnChangesSince(const std::function<void (const FactChange&)>& pCallback,
+                             std::uint64_t pSequenceNumber) const;
+
   /**
    * @brief Add a fact.
    * @param[in] pFact Fact to add.
@@ -204,8 +279,32 @@ struct ORDEREDGOALSPLANNER_API WorldState
                 const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow);
 
 
-  /// Facts of the world.
-  const std::map<Fact, bool>& facts() const { return _factsMapping.facts(); }
+  /// Position in the trail of the modifications of the facts.
+  using Checkpoint = SetOfFacts::Checkpoint;
+
+  /**
+   * @brief Open a checkpoint.<br/>
+   * While a checkpoint is open, all the modifications of the facts (done by applyEffect, modify, the events, ...) are recorded.
+   * @return The checkpoint to give to rollbackTo or to releaseCheckpoint.
+   */
+  Checkpoint checkpoint() { return _factsMapping.checkpoint(); }
+
+  /**
+   * @brief Undo all the modifications of the facts done since a checkpoint, in O(number of modifications).<br/>
+   * Only onFactChanges is notified of the restored facts, the other observers are not.
+   * @param[in] pCheckpoint Checkpoint to restore.
+   */
+  void rollbackTo(const Checkpoint& pCheckpoint);
+
+  /// Keep the modifications of the facts done since a checkpoint and close the checkpoint.
+  void releaseCheckpoint(const Checkpoint& pCheckpoint) { _factsMapping.releaseCheckpoint(pCheckpoint); }
+
+  /// Batch of modifications of the world state, see WorldState::Transaction below.
+  class Transaction;
+
+
+  /// Facts of the world. The view converts implicitly to the std::map<Fact, bool> returned before.
+  SetOfFacts::FactsView facts() const { return _factsMapping.facts(); }
   /// Fact names to facts in the world.
   const SetOfFacts& factsMapping() const { return _factsMapping; }
   void updateImmutableFacts(const Ontology& pOntology);
@@ -240,7 +339,8 @@ struct ORDEREDGOALSPLANNER_API WorldState
 
   /**
    * @brief Check if a goal is satisfied.<br/>
-   * A goal is satisfied if his internal objective condition is satisfied and if the goal is enabled.
+   * A goal is satisfied if his internal objective condition is satisfied and if the goal is enabled.<br/>
+   * The result is cached in the goal and it is computed again only if a fact of a predicate watched by the goal changed.
    * @param[in] pGoal Goal to check.
    * @return True if the goal is satisfied.
    */
@@ -277,10 +377,62 @@ struct ORDEREDGOALSPLANNER_API WorldState
 
   bool hasEntity(const std::string& pEntityId) const;
 
+  /**
+   * @brief Check if a fact of some predicates changed after a sequence number.
+   * @param[in] pPredicateNames Names of the predicates to check.
+   * @param[in] pSequenceNumber Sequence number of the last modification already known by the caller.
+   * @return True if a fact of one of the predicates was added or removed after the sequence number.
+   */
+  bool hasAPredicateChangedSince(const std::vector<std::string>& pPredicateNames,
+                                 std::uint64_t pSequenceNumber) const;
+
+  /// Identifier of this world state. Each world state, including the copies, has a different identifier.
+  std::uint64_t id() const { return _id; }
+
+  /**
+   * @brief Get a hash of the facts, updated in constant time for each modification of the facts.<br/>
+   * Unlike the identifier, it is the same for the world states that have the same facts, whatever the order of the modifications.
+   */
+  std::uint64_t hash() const { return _factsMapping.hash(); }
+
 
 private:
   /// Facts of the world state.
   SetOfFacts _factsMapping;
+  /// True while a transaction is open, the modifications are then notified only when the transaction is committed.
+  bool _isInATransaction;
+  std::uint64_t _lastChangeSequenceNumber;
+  std::size_t _changeJournalCapacity;
+  /// Last modifications of the facts, at most _changeJournalCapacity of them.
+  std::deque<FactChange> _changeJournal;
+  /// Modifications not yet notified to onFactChanges.
+  std::vector<FactChange> _factChangesToNotify;
+  /// Facts referenced by the change journal and by the modifications to notify, with their number of references.
+  std::map<Fact, std::size_t> _changedFactToNbOfReferences;
+  std::uint64_t _id;
+  /// Sequence number of the last modification of the facts of each predicate.
+  std::unordered_map<std::string, std::uint64_t> _predicateToLastChangeSequenceNumber;
+  /// Sequence number of the last modification that can concern the facts of any predicate.
+  std::uint64_t _lastChangeOfAllPredicatesSequenceNumber;
+  /// Sequence number and version of the predicates of the last update of the immutable facts.
+  std::uint64_t _immutableFactsUpdateSequenceNumber;
+  std::pair<std::uint64_t, std::uint64_t> _immutableFactsPredicatesVersion;
+
+  /// Increment the sequence number for a modification of a fact of a predicate.
+  void _stampPredicateChange(const std::string& pPredicateName);
+  /// Increment the sequence number for a modification that can concern the facts of any predicate.
+  void _stampChangeOfAllPredicates();
+
+  void _recordFactChange(FactChangeType pType,
+                         const Fact& pFact,
+                         bool pToNotify = true);
+  /// Release the reference of a modification to its fact.
+  void _releaseChangedFact(const FactChange& pFactChange);
+  /// Undo the modifications done since a checkpoint, and notify them if asked.
+  void _rollbackTo(const Checkpoint& pCheckpoint,
+                   bool pToNotify);
+  /// Notify the modifications not yet notified to onFactChanges.
+  void _notifyFactChanges();
 
   /// Stored what changed.
   struct WhatChanged
@@ -291,11 +443,29 @@ private:
     std::set<Fact> addedFacts;
     /// Facts that we removed in the world.
     std::set<Fact> removedFacts;
+    /// Facts inserted in the sets above that were not yet given to the events and to the callbacks, in their insertion order.
+    std::vector<std::pair<const Fact*, FactChangeType>> factsToPropagate;
+
+    void insertPunctualFact(const Fact& pFact) { _insert(punctualFacts, pFact, FactChangeType::PUNCTUAL); }
+    void insertAddedFact(const Fact& pFact) { _insert(addedFacts, pFact, FactChangeType::ADDED); }
+    void insertRemovedFact(const Fact& pFact) { _insert(removedFacts, pFact, FactChangeType::REMOVED); }
+    /// Set all the facts of the sets above as not propagated, to call after a removal from the sets.
+    void resetFactsToPropagate();
 
     /// Check if something changed.
     bool somethingChanged() const { return !punctualFacts.empty() || !addedFacts.empty() || !removedFacts.empty(); }
     /// Has some facts to add or to remove.
     bool hasFactsToModifyInTheWorldForSure() const { return !addedFacts.empty() || !removedFacts.empty(); }
+
+  private:
+    void _insert(std::set<Fact>& pFacts,
+                 const Fact& pFact,
+                 FactChangeType pType)
+    {
+      auto insertionRes = pFacts.insert(pFact);
+      if (insertionRes.second)
+        factsToPropagate.emplace_back(&*insertionRes.first, pType);
+    }
   };
 
 
@@ -377,7 +547,7 @@ private:
                         bool& pGoalChanged,
                         GoalStack& pGoalStack,
                         const EventId& pEventId,
-                        const std::map<EventId, Event>& pEvents,
+                        const SetOfEvents& pSetOfEventsOfTheEvent,
                         const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
                         const SetOfCallbacks& pCallbacks,
                         const Ontology& pOntology,
@@ -389,7 +559,7 @@ private:
                           const SetOfEntities& pConstants,
                           const SetOfEntities& pObjects,
                           const std::string& pCallbackId,
-                          const std::map<CallbackId, ConditionToCallback>& pCallbacks);
+                          const SetOfCallbacks& pCallbacks);
 
   /**
    * @brief Do events and raise the observables if some facts or goals changed.
@@ -413,6 +583,67 @@ private:
   friend struct ConditionNode;
 };
 
+
+/**
+ * @brief Batch of modifications of a world state.<br/>
+ * The modifications are applied to the facts immediately but the events, the callbacks, the refresh of
+ * the goal stack and the observables are run only once, when the transaction is committed, with all what changed.<br/>
+ * A fact added and then removed (or removed and then added) in the same transaction is not notified.<br/>
+ * A transaction that is not committed explicitly is rolled back when it is destroyed, for example when an exception
+ * is thrown in its scope.<br/>
+ * Only one transaction can be open at a time on a world state.
+ */
+class ORDEREDGOALSPLANNER_API WorldState::Transaction
+{
+public:
+  /// Begin a transaction.
+  Transaction(WorldState& pWorldState,
+              GoalStack& pGoalStack,
+              const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
+              const SetOfCallbacks& pCallbacks,
+              const Ontology& pOntology,
+              const SetOfEntities& pObjects,
+              const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+              bool pCanFactsBeRemoved = true);
+  Transaction(const Transaction&) = delete;
+  Transaction& operator=(const Transaction&) = delete;
+  /// Roll back the transaction if it was not committed. It never throws.
+  ~Transaction();
+
+  /// Add a fact. If the fact has a value, it replaces the other values of the fact.
+  void addFact(const Fact& pFact);
+  /// Remove a fact.
+  void removeFact(const Fact& pFact);
+  /// Apply a modification.
+  void modify(const WorldStateModification* pWsModifPtr);
+
+  /**
+   * @brief Notify all the modifications done in the transaction and close it.
+   * @return True if some facts were added or removed.
+   */
+  bool commit();
+
+  /// Undo all the modifications done in the transaction, without notifying them, and close it.
+  void rollback();
+
+private:
+  WorldState& _worldState;
+  GoalStack& _goalStack;
+  const std::map<SetOfEventsId, SetOfEvents>& _setOfEvents;
+  const SetOfCallbacks& _callbacks;
+  const Ontology& _ontology;
+  const SetOfEntities& _objects;
+  /// Copy of the current time given at the beginning of the transaction.
+  const std::unique_ptr<std::chrono::steady_clock::time_point> _now;
+  bool _canFactsBeRemoved;
+  WhatChanged _whatChanged;
+  /// Checkpoint to know the facts that were present before the transaction.
+  Checkpoint _checkpoint;
+  /// Number of fact changes waiting to be notified at the beginning of the transaction.
+  std::size_t _nbOfFactChangesToNotify;
+  bool _isOpen;
+};
+
 } // !ogp
 
 
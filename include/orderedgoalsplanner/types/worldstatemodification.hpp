@@ -137,6 +137,13 @@ struct ORDEREDGOALSPLANNER_API WorldStateModification
    */
   virtual std::optional<Entity> getValue(const SetOfFacts& pSetOfFact) const = 0;
 
+  /**
+   * @brief Convert this world state modification to a number, without converting the numbers to strings when it is possible.
+   * @param[in] pSetOfFact Facts use to extract value of the facts.
+   * @return The world state modification converted to a number, nothing if it is not a number.
+   */
+  virtual std::optional<Number> getNumber(const SetOfFacts& pSetOfFact) const;
+
   /// Convert this world state modification to an optional fact if possible.
   virtual const FactOptional* getOptionalFact() const = 0;
 
@@ -9,6 +9,7 @@
 namespace ogp
 {
 struct Domain;
+struct GoalStack;
 struct Problem;
 
 
@@ -16,6 +17,16 @@ ORDEREDGOALSPLANNER_API
 std::map<std::string, MinMaxValues> extractMinMaxValuesForFacts(const Problem& pProblem,
                                                                 const Domain& pDomain);
 
+/// Add the min and max values of the fluents compared in the goals.
+ORDEREDGOALSPLANNER_API
+void extractMinMaxValuesForFactsOfGoals(std::map<std::string, MinMaxValues>& pRes,
+                                        const GoalStack& pGoalStack);
+
+/// Add the min and max values of the fluents compared in the derived predicates and in the action preconditions.
+ORDEREDGOALSPLANNER_API
+void extractMinMaxValuesForFactsOfDomain(std::map<std::string, MinMaxValues>& pRes,
+                                         const Domain& pDomain);
+
 
 }
 
@@ -39,6 +39,9 @@ public:
   template<typename... Args>
   void operator()(Args&&... pArgs);
 
+  /// True if nobody is connected, useful to avoid computing the arguments of a notification nobody listens to.
+  bool empty() const { return _connections.empty(); }
+
 private:
   mutable std::map<int, std::pair<Connection, std::function<FuncSignature>>> _connections;
   void _disconnectId(int pId) const;
@@ -54,6 +54,16 @@ bool compIntNb(const std::string& pNb1Str,
                bool pBoolSuperiorOrInferior,
                bool pCanBeEqual);
 
+ORDEREDGOALSPLANNER_API
+bool compNb(const Number& pNb1,
+            const Number& pNb2,
+            bool pBoolSuperiorOrInferior,
+            bool pCanBeEqual);
+
+/// Convert an entity to a number, nothing if the entity is not a valid number.
+ORDEREDGOALSPLANNER_API
+std::optional<Number> entityToNumberOpt(const Entity& pEntity);
+
 ORDEREDGOALSPLANNER_API
 std::string incrementLastNumberUntilAConditionIsSatisfied(
     const std::string& pStr,
@@ -0,0 +1,405 @@
+#include "actiongroundings.hpp"
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <optional>
+#include <orderedgoalsplanner/types/condition.hpp>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/predicate.hpp>
+#include <orderedgoalsplanner/types/setofentities.hpp>
+#include <orderedgoalsplanner/types/worldstate.hpp>
+#include <orderedgoalsplanner/types/worldstatemodification.hpp>
+#include <orderedgoalsplanner/util/util.hpp>
+
+namespace ogp
+{
+namespace
+{
+
+/// Fact required by a precondition whose predicate cannot be modified during the search.
+struct StaticFact
+{
+  /// For each argument, the index of the action parameter, or nothing if the argument is a constant.
+  std::vector<std::optional<std::size_t>> argumentToParameterIndex;
+  /// For each argument that is a constant, its value.
+  std::vector<std::string> constantArguments;
+  /// Arguments of the facts that exist.
+  const std::set<std::vector<std::string>>* existingArgumentsPtr = nullptr;
+  /// For each argument, the values that it has in the facts that exist.
+  std::vector<std::set<std::string>> argumentToExistingValues;
+  mutable std::vector<std::string> argumentsBuffer;
+
+  void setExistingArguments(const std::set<std::vector<std::string>>& pExistingArguments)
+  {
+    existingArgumentsPtr = &pExistingArguments;
+    argumentsBuffer.resize(argumentToParameterIndex.size());
+    argumentToExistingValues.resize(argumentToParameterIndex.size());
+    for (const auto& currArguments : pExistingArguments)
+      for (std::size_t i = 0; i < currArguments.size(); ++i)
+        argumentToExistingValues[i].insert(currArguments[i]);
+  }
+
+  bool isSatisfied(const std::vector<const Entity*>& pParameterValues) const
+  {
+    for (std::size_t i = 0; i < argumentToParameterIndex.size(); ++i)
+      argumentsBuffer[i] = argumentToParameterIndex[i] ? pParameterValues[*argumentToParameterIndex[i]]->value : constantArguments[i];
+    return existingArgumentsPtr->count(argumentsBuffer) > 0;
+  }
+};
+
+
+void _extractModifiedPredicates(std::set<std::string>& pRes,
+                                const WorldStateModification* pWorldStateModificationPtr)
+{
+  if (pWorldStateModificationPtr == nullptr)
+    return;
+  pWorldStateModificationPtr->forAllThatCanBeModified([&](const FactOptionalAndValueModification& pFactOptional) {
+    pRes.insert(pFactOptional.factOpt.fact.name());
+    return ContinueOrBreak::CONTINUE;
+  });
+}
+
+
+void _addExistingArguments(std::set<std::vector<std::string>>& pRes,
+                           const Fact& pPattern,
+                           const Fact& pFact)
+{
+  if (pFact.name() != pPattern.name() || pFact.arguments().size() != pPattern.arguments().size())
+    return;
+  std::vector<std::string> arguments;
+  arguments.reserve(pFact.arguments().size());
+  for (const auto& currArgument : pFact.arguments())
+  {
+    if (!currArgument.isEntity())
+      return;
+    arguments.push_back(currArgument.entity().value);
+  }
+  pRes.insert(std::move(arguments));
+}
+
+
+/// Only the facts under conjunctions are extracted, because they are required whatever the rest of the precondition.
+void _extractStaticFacts(std::list<std::pair<StaticFact, const Fact*>>& pRes,
+                         const Condition& pCondition,
+                         const std::vector<Parameter>& pParameters,
+                         const std::function<bool(const std::string&)>& pIsStatic)
+{
+  const auto* nodePtr = pCondition.fcNodePtr();
+  if (nodePtr != nullptr)
+  {
+    if (nodePtr->nodeType == ConditionNodeType::AND)
+    {
+      if (nodePtr->leftOperand)
+        _extractStaticFacts(pRes, *nodePtr->leftOperand, pParameters, pIsStatic);
+      if (nodePtr->rightOperand)
+        _extractStaticFacts(pRes, *nodePtr->rightOperand, pParameters, pIsStatic);
+    }
+    return;
+  }
+
+  const auto* factPtr = pCondition.fcFactPtr();
+  if (factPtr == nullptr)
+    return;
+  const auto& factOptional = factPtr->factOptional;
+  const auto& fact = factOptional.fact;
+  if (factOptional.isFactNegated || fact.isPunctual() || fact.value() || fact.isValueNegated() ||
+      !pIsStatic(fact.name()))
+    return;
+
+  StaticFact staticFact;
+  for (const auto& currArgument : fact.arguments())
+  {
+    if (!currArgument.isEntity() || currArgument.isAnyEntity())
+      return;
+    const auto& entity = currArgument.entity();
+    if (!entity.isAParameterToFill())
+    {
+      staticFact.argumentToParameterIndex.emplace_back();
+      staticFact.constantArguments.push_back(entity.value);
+      continue;
+    }
+    std::optional<std::size_t> parameterIndex;
+    for (std::size_t i = 0; i < pParameters.size(); ++i)
+      if (pParameters[i].name == entity.value)
+        parameterIndex = i;
+    if (!parameterIndex)
+      return;
+    staticFact.argumentToParameterIndex.push_back(parameterIndex);
+    staticFact.constantArguments.emplace_back();
+  }
+  pRes.emplace_back(std::move(staticFact), &fact);
+}
+
+
+/// Check if a value of a parameter is in the facts that exist, for all the arguments of the static facts that hold the parameter.
+bool _canBeAnArgument(const std::list<std::pair<StaticFact, const Fact*>>& pStaticFacts,
+                      std::size_t pParameterIndex,
+                      const std::string& pValue)
+{
+  for (const auto& currStaticFact : pStaticFacts)
+  {
+    const auto& staticFact = currStaticFact.first;
+    for (std::size_t i = 0; i < staticFact.argumentToParameterIndex.size(); ++i)
+      if (staticFact.argumentToParameterIndex[i] == pParameterIndex &&
+          staticFact.argumentToExistingValues[i].count(pValue) == 0)
+        return false;
+  }
+  return true;
+}
+
+
+/**
+ * @brief Give a value to the parameters one by one and check each static fact as soon as all its parameters have a value.
+ * @return False if there are more groundings than the maximum or if the join visited more nodes than allowed.
+ */
+bool _joinStaticFacts(ActionGroundings::Groundings& pRes,
+                      std::vector<const Entity*>& pGrounding,
+                      std::size_t pParameterIndex,
+                      const std::vector<std::vector<Entity>>& pParameterValues,
+                      const std::vector<std::vector<const StaticFact*>>& pParameterToStaticFactsToCheck,
+                      std::size_t& pNbOfNodesLeft,
+                      std::size_t pMaxNbOfGroundings)
+{
+  if (pParameterIndex == pGrounding.size())
+  {
+    if (pRes.size() >= pMaxNbOfGroundings)
+      return false;
+    for (std::size_t i = 0; i < pGrounding.size(); ++i)
+    {
+      pRes.values.push_back(*pGrounding[i]);
+      pRes.possibleValues[i].insert(pGrounding[i]->value);
+    }
+    return true;
+  }
+
+  const auto& staticFactsToCheck = pParameterToStaticFactsToCheck[pParameterIndex];
+  for (const auto& currValue : pParameterValues[pParameterIndex])
+  {
+    if (pNbOfNodesLeft == 0)
+      return false;
+    --pNbOfNodesLeft;
+    pGrounding[pParameterIndex] = &currValue;
+    bool areStaticFactsSatisfied = std::all_of(staticFactsToCheck.begin(), staticFactsToCheck.end(),
+                                               [&](const StaticFact* pStaticFactPtr) { return pStaticFactPtr->isSatisfied(pGrounding); });
+    if (areStaticFactsSatisfied &&
+        !_joinStaticFacts(pRes, pGrounding, pParameterIndex + 1, pParameterValues, pParameterToStaticFactsToCheck,
+                          pNbOfNodesLeft, pMaxNbOfGroundings))
+      return false;
+  }
+  return true;
+}
+
+
+bool _isRowLessThan(const std::vector<Entity>& pValues,
+                    std::size_t pRowIndex,
+                    const std::vector<const std::string*>& pKey)
+{
+  auto offset = pRowIndex * pKey.size();
+  for (std::size_t i = 0; i < pKey.size(); ++i)
+  {
+    const auto& value = pValues[offset + i].value;
+    if (value != *pKey[i])
+      return value < *pKey[i];
+  }
+  return false;
+}
+
+}
+
+
+const std::size_t ActionGroundings::defaultMaxNbOfGroundingsPerAction = 100000;
+
+
+bool ActionGroundings::Groundings::contains(const std::map<Parameter, Entity>& pParameters) const
+{
+  if (parameters.empty())
+    return true;
+  std::vector<const std::string*> key;
+  key.reserve(parameters.size());
+  for (const auto& currParameter : parameters)
+  {
+    auto itParameter = pParameters.find(currParameter);
+    if (itParameter == pParameters.end())
+      return true;
+    key.push_back(&itParameter->second.value);
+  }
+
+  // Binary search of the row, the rows are sorted
+  std::size_t begin = 0;
+  std::size_t end = size();
+  while (begin < end)
+  {
+    auto middle = begin + (end - begin) / 2;
+    if (_isRowLessThan(values, middle, key))
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+  if (begin == size())
+    return false;
+  auto offset = begin * parameters.size();
+  for (std::size_t i = 0; i < key.size(); ++i)
+    if (values[offset + i].value != *key[i])
+      return false;
+  return true;
+}
+
+
+ActionGroundings::ActionGroundings(const Domain& pDomain,
+                                   std::size_t pMaxNbOfGroundingsPerAction)
+  : _domain(pDomain),
+    _maxNbOfGroundingsPerAction(pMaxNbOfGroundingsPerAction),
+    _worldStatePtr(nullptr),
+    _objects(),
+    _predicatesModifiedByTheDomain(),
+    _modifiedPredicates(),
+    _patternToStaticFacts(),
+    _actionIdToGroundings()
+{
+  for (const auto& currAction : pDomain.actions())
+  {
+    const auto& effect = currAction.second.effect;
+    _extractModifiedPredicates(_predicatesModifiedByTheDomain, effect.worldStateModification.get());
+    _extractModifiedPredicates(_predicatesModifiedByTheDomain, effect.worldStateModificationAtStart.get());
+    _extractModifiedPredicates(_predicatesModifiedByTheDomain, effect.potentialWorldStateModification.get());
+  }
+  for (const auto& currSetOfEvents : pDomain.getSetOfEvents())
+    for (const auto& currEvent : currSetOfEvents.second.events())
+      _extractModifiedPredicates(_predicatesModifiedByTheDomain, currEvent.second.factsToModify.get());
+  _modifiedPredicates = _predicatesModifiedByTheDomain;
+}
+
+
+void ActionGroundings::update(const WorldState& pWorldState,
+                              const WorldStateModification* pEffectBetweenGoalsPtr,
+                              const SetOfEntities& pObjects)
+{
+  _worldStatePtr = &pWorldState;
+  auto modifiedPredicates = _predicatesModifiedByTheDomain;
+  _extractModifiedPredicates(modifiedPredicates, pEffectBetweenGoalsPtr);
+  auto objectsDelta = pObjects.deltaFrom(_objects);
+  bool isStillValid = modifiedPredicates == _modifiedPredicates &&
+      objectsDelta.addedEntities.empty() && objectsDelta.removedEntities.empty();
+  // Only the facts that match the patterns of the preconditions are compared, thanks to the index of the facts
+  std::set<std::vector<std::string>> existingArguments;
+  for (auto itPattern = _patternToStaticFacts.begin(); isStillValid && itPattern != _patternToStaticFacts.end(); ++itPattern)
+  {
+    existingArguments.clear();
+    _extractExistingArguments(existingArguments, itPattern->second.pattern);
+    isStillValid = existingArguments == itPattern->second.existingArguments;
+  }
+  if (isStillValid)
+    return;
+
+  _objects = pObjects;
+  _modifiedPredicates = std::move(modifiedPredicates);
+  _patternToStaticFacts.clear();
+  _actionIdToGroundings.clear();
+}
+
+
+const ActionGroundings::Groundings* ActionGroundings::getGroundingsPtr(const ActionId& pActionId)
+{
+  auto it = _actionIdToGroundings.find(pActionId);
+  if (it == _actionIdToGroundings.end())
+    it = _actionIdToGroundings.emplace(pActionId, _computeGroundings(pActionId)).first;
+  return it->second.get();
+}
+
+
+bool ActionGroundings::_isStatic(const std::string& pPredicateName) const
+{
+  if (_modifiedPredicates.count(pPredicateName) > 0)
+    return false;
+  // The immutable facts are copies of the facts of another predicate that are updated when the goals change
+  const auto& immutablePrefix = Predicate::getImmutablePrefix();
+  if (pPredicateName.compare(0, immutablePrefix.size(), immutablePrefix) == 0)
+    return _modifiedPredicates.count(pPredicateName.substr(immutablePrefix.size())) == 0;
+  return true;
+}
+
+
+void ActionGroundings::_extractExistingArguments(std::set<std::vector<std::string>>& pRes,
+                                                 const Fact& pPattern) const
+{
+  for (const auto& currFact : _worldStatePtr->factsMapping().find(pPattern))
+    _addExistingArguments(pRes, pPattern, currFact);
+  for (const auto& currFact : _domain.getTimelessFacts().setOfFacts().find(pPattern))
+    _addExistingArguments(pRes, pPattern, currFact);
+}
+
+
+const std::set<std::vector<std::string>>& ActionGroundings::_getExistingArguments(const Fact& pPattern)
+{
+  auto patternStr = pPattern.toStr();
+  auto itPattern = _patternToStaticFacts.find(patternStr);
+  if (itPattern == _patternToStaticFacts.end())
+  {
+    itPattern = _patternToStaticFacts.emplace(std::move(patternStr), StaticFactsOfAPattern{pPattern, {}}).first;
+    _extractExistingArguments(itPattern->second.existingArguments, pPattern);
+  }
+  return itPattern->second.existingArguments;
+}
+
+
+std::unique_ptr<ActionGroundings::Groundings> ActionGroundings::_computeGroundings(const ActionId& pActionId)
+{
+  const auto* actionPtr = _domain.getActionPtr(pActionId);
+  if (actionPtr == nullptr || !actionPtr->precondition || actionPtr->parameters.empty() || _worldStatePtr == nullptr)
+    return {};
+  const auto& parameters = actionPtr->parameters;
+
+  std::list<std::pair<StaticFact, const Fact*>> staticFacts;
+  _extractStaticFacts(staticFacts, *actionPtr->precondition, parameters,
+                      [this](const std::string& pPredicateName) { return _isStatic(pPredicateName); });
+  if (staticFacts.empty())
+    return {};
+
+  auto res = std::make_unique<Groundings>();
+  res->parameters = parameters;
+  res->possibleValues.resize(parameters.size());
+  // Each static fact is checked as soon as its last parameter has a value
+  std::vector<std::vector<const StaticFact*>> parameterToStaticFactsToCheck(parameters.size());
+  for (auto& currStaticFact : staticFacts)
+  {
+    auto& staticFact = currStaticFact.first;
+    staticFact.setExistingArguments(_getExistingArguments(*currStaticFact.second));
+    std::optional<std::size_t> lastParameterIndex;
+    for (const auto& currParameterIndex : staticFact.argumentToParameterIndex)
+      if (currParameterIndex && (!lastParameterIndex || *currParameterIndex > *lastParameterIndex))
+        lastParameterIndex = currParameterIndex;
+    if (lastParameterIndex)
+      parameterToStaticFactsToCheck[*lastParameterIndex].push_back(&staticFact);
+    else if (!staticFact.isSatisfied({}))
+      return res; // A static fact without parameter is missing, so no grounding is possible
+  }
+
+  // The entities are sorted and the join assigns the parameters in their order,
+  // so the groundings are found in lexicographic order
+  const auto& constants = _domain.getOntology().constants;
+  std::vector<std::vector<Entity>> parameterValues;
+  for (std::size_t parameterIndex = 0; parameterIndex < parameters.size(); ++parameterIndex)
+  {
+    const auto& parameter = parameters[parameterIndex];
+    if (!parameter.type)
+      return {};
+    auto entities = typeToEntities(*parameter.type, constants, _objects);
+    if (entities.empty())
+      return {};
+    auto& values = parameterValues.emplace_back();
+    for (const auto& currEntity : entities)
+      if (_canBeAnArgument(staticFacts, parameterIndex, currEntity.first.value))
+        values.push_back(currEntity.first);
+  }
+
+  std::vector<const Entity*> grounding(parameters.size(), nullptr);
+  // Bound of the work of the join, even if the static facts do not prune anything
+  std::size_t nbOfNodesLeft = _maxNbOfGroundingsPerAction * parameters.size();
+  if (!_joinStaticFacts(*res, grounding, 0, parameterValues, parameterToStaticFactsToCheck,
+                        nbOfNodesLeft, _maxNbOfGroundingsPerAction))
+    return {};
+  return res;
+}
+
+
+} // End of namespace ogp
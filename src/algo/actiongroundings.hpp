@@ -0,0 +1,116 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_ACTIONGROUNDINGS_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_ACTIONGROUNDINGS_HPP
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <orderedgoalsplanner/types/entity.hpp>
+#include <orderedgoalsplanner/types/fact.hpp>
+#include <orderedgoalsplanner/types/parameter.hpp>
+#include <orderedgoalsplanner/types/setofentities.hpp>
+#include <orderedgoalsplanner/util/alias.hpp>
+
+namespace ogp
+{
+struct Domain;
+struct WorldState;
+struct WorldStateModification;
+
+
+/**
+ * Groundings of the actions that are not statically impossible.<br/>
+ * A predicate is static if no action, no event and no effect between goals can modify it,
+ * so its facts are the same during all the search. The groundings of an action whose precondition
+ * requires a missing static fact can never be done, so they are removed.<br/>
+ * The groundings are computed lazily, the first time that an action is asked, by joining the static facts
+ * parameter by parameter.<br/>
+ * They are kept between the updates while the objects, the static predicates and the facts of the static predicates
+ * used by the preconditions do not change.
+ */
+struct ActionGroundings
+{
+  /// Groundings of one action, stored row by row in a flat array sorted in lexicographic order.
+  struct Groundings
+  {
+    /// Parameters of the action, in the order of the values of a row.
+    std::vector<Parameter> parameters;
+    /// Values of the parameters, parameters.size() values per grounding.
+    std::vector<Entity> values;
+    /// For each parameter, the values that are in at least one grounding.
+    std::vector<std::set<std::string>> possibleValues;
+
+    std::size_t size() const { return parameters.empty() ? 0 : values.size() / parameters.size(); }
+    bool empty() const { return values.empty(); }
+
+    /// True if the parameters are a grounding, or if they do not give a value to all the parameters of the action.
+    bool contains(const std::map<Parameter, Entity>& pParameters) const;
+  };
+
+  /**
+   * @brief Construct the groundings of the actions of a domain, update has to be called before asking the groundings.
+   * @param[in] pDomain Domain of the actions.
+   * @param[in] pMaxNbOfGroundingsPerAction Above this number of groundings, an action is not grounded.
+   */
+  ActionGroundings(const Domain& pDomain,
+                   std::size_t pMaxNbOfGroundingsPerAction = defaultMaxNbOfGroundingsPerAction);
+
+  /**
+   * @brief Set the state of the problem to ground the actions for.<br/>
+   * The groundings already computed are removed if they depend on something that changed.
+   * @param[in] pWorldState World state to extract the static facts. It has to live until the next update.
+   * @param[in] pEffectBetweenGoalsPtr Effect applied between the goals, the predicates it modifies are not static.
+   * @param[in] pObjects Objects of the problem.
+   */
+  void update(const WorldState& pWorldState,
+              const WorldStateModification* pEffectBetweenGoalsPtr,
+              const SetOfEntities& pObjects);
+
+  /**
+   * @brief Get the groundings of an action.
+   * @param[in] pActionId Identifier of the action.
+   * @return The groundings or nullptr if they are not filtered, because the precondition of the action does not
+   * require any static fact, because a parameter has no type or because there are too many groundings.
+   */
+  const Groundings* getGroundingsPtr(const ActionId& pActionId);
+
+  /// Default maximum number of groundings of an action.
+  static const std::size_t defaultMaxNbOfGroundingsPerAction;
+
+private:
+  /// Facts of the world state and of the timeless facts that match a fact of a precondition.
+  struct StaticFactsOfAPattern
+  {
+    /// Fact of a precondition, with the parameters of its action.
+    Fact pattern;
+    /// Arguments of the facts that match the pattern.
+    std::set<std::vector<std::string>> existingArguments;
+  };
+
+  const Domain& _domain;
+  std::size_t _maxNbOfGroundingsPerAction;
+  const WorldState* _worldStatePtr;
+  SetOfEntities _objects;
+  /// Predicates modified by the actions and the events of the domain.
+  std::set<std::string> _predicatesModifiedByTheDomain;
+  /// Predicates that can be modified during the search.
+  std::set<std::string> _modifiedPredicates;
+  /// Static facts already extracted, by pattern.
+  std::map<std::string, StaticFactsOfAPattern> _patternToStaticFacts;
+  /// Groundings already computed, nullptr if they are not filtered.
+  std::map<ActionId, std::unique_ptr<Groundings>> _actionIdToGroundings;
+
+  bool _isStatic(const std::string& pPredicateName) const;
+  void _extractExistingArguments(std::set<std::vector<std::string>>& pRes,
+                                 const Fact& pPattern) const;
+  const std::set<std::vector<std::string>>& _getExistingArguments(const Fact& pPattern);
+  std::unique_ptr<Groundings> _computeGroundings(const ActionId& pActionId);
+};
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_ACTIONGROUNDINGS_HPP
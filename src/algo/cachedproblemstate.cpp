@@ -0,0 +1,50 @@
+#include "cachedproblemstate.hpp"
+#include <vector>
+#include <orderedgoalsplanner/types/problem.hpp>
+
+namespace ogp
+{
+
+
+CachedProblemState::CachedProblemState(const Problem& pProblem,
+                                       std::string pContext)
+  : facts(pProblem.worldState.factsMapping()),
+    problemContext(problemContextToStr(pProblem)),
+    context(std::move(pContext))
+{
+}
+
+
+std::string CachedProblemState::problemContextToStr(const Problem& pProblem)
+{
+  std::string res;
+  for (const auto& currGoalsWithPriority : pProblem.goalStack.goals())
+  {
+    res += "priority: " + std::to_string(currGoalsWithPriority.first) + "\n";
+    for (const auto& currGoal : currGoalsWithPriority.second)
+    {
+      res += currGoal.toPddl(0) + " group: " + currGoal.getGoalGroupId() +
+          " maxTimeToKeepInactive: " + std::to_string(currGoal.getMaxTimeToKeepInactive()) +
+          (currGoal.getInactiveSince() ? " inactive\n" : "\n");
+    }
+  }
+  const auto& effectBetweenGoals = pProblem.goalStack.effectBetweenGoals;
+  res += "effect between goals: " + (effectBetweenGoals ? effectBetweenGoals->toStr() : std::string()) + "\n";
+  res += "objects: " + pProblem.objects.toStr() + "\n";
+  res += "historical: " + pProblem.historical.toStr() + "\n";
+  return res;
+}
+
+
+bool CachedProblemState::isStateOf(const Problem& pProblem,
+                                   const std::string& pContext) const
+{
+  if (context != pContext || problemContext != problemContextToStr(pProblem))
+    return false;
+  std::vector<SetOfFacts::DeltaEntry> deltaEntries;
+  pProblem.worldState.factsMapping().deltaFrom(deltaEntries, facts);
+  return deltaEntries.empty();
+}
+
+
+} // End of namespace ogp
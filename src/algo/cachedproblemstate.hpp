@@ -0,0 +1,51 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_CACHEDPROBLEMSTATE_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_CACHEDPROBLEMSTATE_HPP
+
+#include <string>
+#include <orderedgoalsplanner/types/setoffacts.hpp>
+
+namespace ogp
+{
+struct Problem;
+
+
+/**
+ * State of a problem memorized with an entry of a cache that is searched by hashes.<br/>
+ * When the hashes match, the state is compared to the problem, so that a collision of the hashes
+ * cannot return the entry of another state.<br/>
+ * The facts are copied with their shared chunks, so the copy and the comparison are cheap
+ * for the states that share most of their facts.
+ */
+struct CachedProblemState
+{
+  /**
+   * @brief Memorize the state of a problem.
+   * @param[in] pProblem Problem to memorize.
+   * @param[in] pContext Other data that the entry depends on, already converted to a string.
+   */
+  CachedProblemState(const Problem& pProblem,
+                     std::string pContext);
+
+  /**
+   * @brief Convert the goals, the effect between the goals, the objects and the historical of a problem to a string.<br/>
+   * Everything except the facts, that are compared separately.
+   */
+  static std::string problemContextToStr(const Problem& pProblem);
+
+  /// Check if a problem and the other data that the entry depends on are the ones memorized.
+  bool isStateOf(const Problem& pProblem,
+                 const std::string& pContext) const;
+
+  /// Facts of the world state.
+  SetOfFacts facts;
+  /// Goals, effect between the goals, objects and historical of the problem.
+  std::string problemContext;
+  /// Other data that the entry depends on.
+  std::string context;
+};
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_CACHEDPROBLEMSTATE_HPP
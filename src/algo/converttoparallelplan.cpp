@@ -6,6 +6,7 @@
 #include <orderedgoalsplanner/types/actionstodoinparallel.hpp>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/parallelplan.hpp>
+#include <orderedgoalsplanner/types/planningbudget.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
 #include <orderedgoalsplanner/types/setofcallbacks.hpp>
 #include <orderedgoalsplanner/types/worldstate.hpp>
@@ -44,7 +45,8 @@ ParallelPlan toParallelPlan
  Problem& pProblem,
  const Domain& pDomain,
  std::list<Goal>& pGoals,
- const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
+ const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+ const CancellationToken* pCancellationTokenPtr)
 {
   const auto& actions = pDomain.actions();
   const auto& ontology = pDomain.getOntology();
@@ -66,6 +68,9 @@ ParallelPlan toParallelPlan
 
   for (auto itPlanStep = currentRes.begin(); itPlanStep != currentRes.end(); ++itPlanStep)
   {
+    // The remaining steps stay sequential
+    if (pCancellationTokenPtr != nullptr && pCancellationTokenPtr->isCancelled())
+      break;
     const Goal* goalPtr = nullptr;
     for (ActionDataForParallelisation& currActionTmpData : *itPlanStep)
     {
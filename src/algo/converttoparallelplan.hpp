@@ -10,6 +10,7 @@
 namespace ogp
 {
 struct ActionInvocationWithGoal;
+struct CancellationToken;
 struct Domain;
 struct Goal;
 struct ParallelPlan;
@@ -23,7 +24,8 @@ ParallelPlan toParallelPlan
  Problem& pProblem,
  const Domain& pDomain,
  std::list<Goal>& pGoals,
- const std::unique_ptr<std::chrono::_V2::steady_clock::time_point>& pNow);
+ const std::unique_ptr<std::chrono::_V2::steady_clock::time_point>& pNow,
+ const CancellationToken* pCancellationTokenPtr = nullptr);
 
 } // End of namespace ogp
 
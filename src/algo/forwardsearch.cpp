@@ -0,0 +1,411 @@
+#include "forwardsearch.hpp"
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/goal.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/util/util.hpp>
+#include "../util/hash.hpp"
+#include "groundedstripsmodel.hpp"
+#include "searchlimits.hpp"
+
+namespace ogp
+{
+namespace
+{
+const std::size_t _infiniteCost = std::numeric_limits<std::size_t>::max();
+
+
+/**
+ * @brief Ground the actions of a domain with all the entities of their parameter types.<br/>
+ * The actions that cannot be used by the planner are skipped, like in the backward chaining.
+ * @return False if an action cannot be grounded or if there are more ground actions than the maximum.
+ */
+bool _groundActions(std::vector<ForwardSearchGrounding::GroundAction>& pGroundActions,
+                    std::list<ActionDataForParallelisation>& pActionsData,
+                    const Problem& pProblem,
+                    const Domain& pDomain,
+                    std::size_t pMaxNbOfGroundActions)
+{
+  const auto& constants = pDomain.getOntology().constants;
+  for (const auto& currAction : pDomain.actions())
+  {
+    if (!currAction.second.canThisActionBeUsedByThePlanner)
+      continue;
+    std::vector<std::pair<const Parameter*, std::vector<Entity>>> parameterValues;
+    std::size_t nbOfGroundings = 1;
+    for (const auto& currParameter : currAction.second.parameters)
+    {
+      if (!currParameter.type)
+        return false;
+      parameterValues.emplace_back(&currParameter, std::vector<Entity>());
+      for (const auto& currEntity : typeToEntities(*currParameter.type, constants, pProblem.objects))
+        parameterValues.back().second.push_back(currEntity.first);
+      nbOfGroundings *= parameterValues.back().second.size();
+      if (nbOfGroundings > pMaxNbOfGroundActions)
+        return false;
+    }
+    if (nbOfGroundings == 0)
+      continue;
+    if (pGroundActions.size() + nbOfGroundings > pMaxNbOfGroundActions)
+      return false;
+
+    // Cartesian product of the entities of the parameters, like an odometer
+    std::vector<std::size_t> entityIndexes(parameterValues.size(), 0);
+    for (std::size_t groundingIndex = 0; groundingIndex < nbOfGroundings; ++groundingIndex)
+    {
+      std::map<Parameter, Entity> grounding;
+      for (std::size_t i = 0; i < parameterValues.size(); ++i)
+        grounding.emplace(*parameterValues[i].first, parameterValues[i].second[entityIndexes[i]]);
+      for (std::size_t i = 0; i < entityIndexes.size(); ++i)
+      {
+        if (++entityIndexes[i] < parameterValues[i].second.size())
+          break;
+        entityIndexes[i] = 0;
+      }
+      pActionsData.emplace_back(currAction.second, ActionInvocationWithGoal(currAction.first, grounding, {}, 0));
+      pGroundActions.push_back(ForwardSearchGrounding::GroundAction{&currAction.first, std::move(grounding)});
+    }
+  }
+  return true;
+}
+
+
+std::vector<std::size_t> _toAtoms(const StripsBitset& pBitset,
+                                  std::size_t pNbOfAtoms)
+{
+  std::vector<std::size_t> res;
+  for (std::size_t atom = 0; atom < pNbOfAtoms; ++atom)
+    if (pBitset.test(atom))
+      res.push_back(atom);
+  return res;
+}
+
+
+/// Delete relaxation of a grounded STRIPS model, to compute h_add and h_FF.
+struct DeleteRelaxation
+{
+  DeleteRelaxation(const GroundedStripsModel& pModel)
+    : _nbOfAtoms(pModel.nbOfAtoms()),
+      _actionPreconditions(),
+      _actionAddedAtoms(),
+      _atomToConsumers(pModel.nbOfAtoms()),
+      _goalAtoms(_toAtoms(pModel.goalPositiveAtoms(), pModel.nbOfAtoms())),
+      _atomCosts(),
+      _atomSupporters(),
+      _nbOfUnreachedPreconditions(),
+      _actionCosts()
+  {
+    auto nbOfActions = pModel.nbOfActions();
+    _actionPreconditions.reserve(nbOfActions);
+    _actionAddedAtoms.reserve(nbOfActions);
+    for (std::size_t actionIndex = 0; actionIndex < nbOfActions; ++actionIndex)
+    {
+      _actionPreconditions.emplace_back(_toAtoms(pModel.positivePrecondition(actionIndex), _nbOfAtoms));
+      _actionAddedAtoms.emplace_back(_toAtoms(pModel.addedAtoms(actionIndex), _nbOfAtoms));
+      for (const auto& currAtom : _actionPreconditions.back())
+        _atomToConsumers[currAtom].push_back(actionIndex);
+    }
+  }
+
+  /// Compute the heuristic value of a state, _infiniteCost if the goal is not reachable even without the removals.
+  std::size_t compute(const StripsBitset& pState,
+                      RelaxedHeuristic pHeuristic)
+  {
+    _computeAtomCosts(pState);
+    std::size_t res = 0;
+    for (const auto& currAtom : _goalAtoms)
+    {
+      if (_atomCosts[currAtom] == _infiniteCost)
+        return _infiniteCost;
+      res += _atomCosts[currAtom];
+    }
+    if (pHeuristic == RelaxedHeuristic::H_ADD)
+      return res;
+    return _relaxedPlanSize();
+  }
+
+private:
+  std::size_t _nbOfAtoms;
+  std::vector<std::vector<std::size_t>> _actionPreconditions;
+  std::vector<std::vector<std::size_t>> _actionAddedAtoms;
+  std::vector<std::vector<std::size_t>> _atomToConsumers;
+  std::vector<std::size_t> _goalAtoms;
+  // Buffers reused between the computations
+  std::vector<std::size_t> _atomCosts;
+  std::vector<std::size_t> _atomSupporters;
+  std::vector<std::size_t> _nbOfUnreachedPreconditions;
+  std::vector<std::size_t> _actionCosts;
+
+  /// Generalized Dijkstra: an action is reached when all its preconditions are reached, its cost is 1 plus their sum.
+  void _computeAtomCosts(const StripsBitset& pState)
+  {
+    auto nbOfActions = _actionPreconditions.size();
+    _atomCosts.assign(_nbOfAtoms, _infiniteCost);
+    _atomSupporters.assign(_nbOfAtoms, _infiniteCost);
+    _nbOfUnreachedPreconditions.resize(nbOfActions);
+    _actionCosts.assign(nbOfActions, 0);
+
+    using AtomWithCost = std::pair<std::size_t, std::size_t>;
+    std::priority_queue<AtomWithCost, std::vector<AtomWithCost>, std::greater<AtomWithCost>> atomsToPropagate;
+    auto reachAction = [&](std::size_t pActionIndex) {
+      auto cost = _actionCosts[pActionIndex] + 1;
+      for (const auto& currAtom : _actionAddedAtoms[pActionIndex])
+      {
+        if (cost < _atomCosts[currAtom])
+        {
+          _atomCosts[currAtom] = cost;
+          _atomSupporters[currAtom] = pActionIndex;
+          atomsToPropagate.emplace(cost, currAtom);
+        }
+      }
+    };
+
+    for (std::size_t atom = 0; atom < _nbOfAtoms; ++atom)
+    {
+      if (pState.test(atom))
+      {
+        _atomCosts[atom] = 0;
+        atomsToPropagate.emplace(0, atom);
+      }
+    }
+    for (std::size_t actionIndex = 0; actionIndex < nbOfActions; ++actionIndex)
+    {
+      _nbOfUnreachedPreconditions[actionIndex] = _actionPreconditions[actionIndex].size();
+      if (_nbOfUnreachedPreconditions[actionIndex] == 0)
+        reachAction(actionIndex);
+    }
+
+    while (!atomsToPropagate.empty())
+    {
+      auto [cost, atom] = atomsToPropagate.top();
+      atomsToPropagate.pop();
+      if (cost != _atomCosts[atom])
+        continue;
+      for (const auto& currActionIndex : _atomToConsumers[atom])
+      {
+        _actionCosts[currActionIndex] += cost;
+        if (--_nbOfUnreachedPreconditions[currActionIndex] == 0)
+          reachAction(currActionIndex);
+      }
+    }
+  }
+
+  /// Number of actions of the relaxed plan made of the supporters of the goal atoms, recursively.
+  std::size_t _relaxedPlanSize() const
+  {
+    std::unordered_set<std::size_t> relaxedPlan;
+    std::vector<bool> isAtomProcessed(_nbOfAtoms, false);
+    std::vector<std::size_t> atomsToSupport = _goalAtoms;
+    while (!atomsToSupport.empty())
+    {
+      auto atom = atomsToSupport.back();
+      atomsToSupport.pop_back();
+      if (isAtomProcessed[atom] || _atomCosts[atom] == 0)
+        continue;
+      isAtomProcessed[atom] = true;
+      auto supporter = _atomSupporters[atom];
+      if (relaxedPlan.insert(supporter).second)
+        atomsToSupport.insert(atomsToSupport.end(), _actionPreconditions[supporter].begin(),
+                              _actionPreconditions[supporter].end());
+    }
+    return relaxedPlan.size();
+  }
+};
+
+
+struct StripsBitsetHasher
+{
+  std::size_t operator()(const StripsBitset& pBitset) const
+  {
+    std::uint64_t res = 0;
+    for (const auto& currWord : pBitset.words)
+      combineHash(res, currWord);
+    return static_cast<std::size_t>(res);
+  }
+};
+
+
+struct SearchNode
+{
+  const StripsBitset* statePtr;
+  std::size_t parentIndex;
+  std::size_t actionIndex;
+  std::size_t cost;
+};
+
+
+/// Sequence of action indexes from the initial state to a node, or nothing if the search failed.
+std::optional<std::vector<std::size_t>> _search(const GroundedStripsModel& pModel,
+                                                const SearchStrategy& pStrategy,
+                                                SearchLimits* pSearchLimitsPtr)
+{
+  DeleteRelaxation deleteRelaxation(pModel);
+  const bool isGreedy = pStrategy.algorithm == SearchAlgorithm::GREEDY_BEST_FIRST;
+  std::unordered_map<StripsBitset, std::size_t, StripsBitsetHasher> stateToNodeIndex;
+  std::vector<SearchNode> nodes;
+  // Priority, heuristic value, insertion order, node index and cost of the node when it was inserted, the smallest first
+  using OpenEntry = std::tuple<double, std::size_t, std::size_t, std::size_t, std::size_t>;
+  std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> openList;
+  std::size_t nbOfInsertions = 0;
+
+  auto pushNode = [&](std::size_t pNodeIndex, std::size_t pHeuristic) {
+    const auto cost = nodes[pNodeIndex].cost;
+    double priority = isGreedy ? static_cast<double>(pHeuristic) :
+                                 static_cast<double>(cost) + pStrategy.weight * static_cast<double>(pHeuristic);
+    openList.emplace(priority, pHeuristic, nbOfInsertions++, pNodeIndex, cost);
+  };
+
+  const auto& initialState = pModel.initialState();
+  auto initialHeuristic = deleteRelaxation.compute(initialState, pStrategy.heuristic);
+  if (initialHeuristic == _infiniteCost)
+    return {};
+  auto itInitialState = stateToNodeIndex.emplace(initialState, 0).first;
+  nodes.push_back(SearchNode{&itInitialState->first, _infiniteCost, _infiniteCost, 0});
+  pushNode(0, initialHeuristic);
+
+  std::size_t nbOfExpansions = 0;
+  while (!openList.empty())
+  {
+    auto nodeIndex = std::get<3>(openList.top());
+    auto costWhenInserted = std::get<4>(openList.top());
+    openList.pop();
+    const auto node = nodes[nodeIndex];
+    // The node was reinserted with a smaller cost
+    if (costWhenInserted != node.cost)
+      continue;
+    if (pModel.isGoalSatisfied(*node.statePtr))
+    {
+      std::vector<std::size_t> res;
+      for (auto currIndex = nodeIndex; nodes[currIndex].parentIndex != _infiniteCost; currIndex = nodes[currIndex].parentIndex)
+        res.push_back(nodes[currIndex].actionIndex);
+      return std::vector<std::size_t>(res.rbegin(), res.rend());
+    }
+
+    if (++nbOfExpansions > pStrategy.maxNbOfExpansions)
+      return {};
+    if (pSearchLimitsPtr != nullptr)
+    {
+      pSearchLimitsPtr->notifyExpansion();
+      if (pSearchLimitsPtr->isExhausted())
+        return {};
+    }
+
+    for (std::size_t actionIndex = 0; actionIndex < pModel.nbOfActions(); ++actionIndex)
+    {
+      auto successor = *node.statePtr;
+      if (!pModel.applyAction(successor, actionIndex))
+        continue;
+      auto successorCost = node.cost + 1;
+      auto itSuccessor = stateToNodeIndex.find(successor);
+      if (itSuccessor != stateToNodeIndex.end())
+      {
+        // The greedy search does not reopen the states, A* reopens a state reached with a smaller cost
+        auto& successorNode = nodes[itSuccessor->second];
+        if (isGreedy || successorCost >= successorNode.cost)
+          continue;
+        successorNode.parentIndex = nodeIndex;
+        successorNode.actionIndex = actionIndex;
+        successorNode.cost = successorCost;
+        pushNode(itSuccessor->second, deleteRelaxation.compute(successor, pStrategy.heuristic));
+        continue;
+      }
+
+      auto heuristic = deleteRelaxation.compute(successor, pStrategy.heuristic);
+      if (heuristic == _infiniteCost)
+        continue;
+      auto successorIndex = nodes.size();
+      itSuccessor = stateToNodeIndex.emplace(std::move(successor), successorIndex).first;
+      nodes.push_back(SearchNode{&itSuccessor->first, nodeIndex, actionIndex, successorCost});
+      pushNode(successorIndex, heuristic);
+    }
+  }
+  return {};
+}
+
+}
+
+
+bool ForwardSearchGrounding::update(const Problem& pProblem,
+                                    const Domain& pDomain,
+                                    std::size_t pMaxNbOfGroundActions)
+{
+  if (!_domainUuid.empty() && _domainUuid == pDomain.getUuid() &&
+      _maxNbOfGroundActions == pMaxNbOfGroundActions)
+  {
+    auto objectsDelta = pProblem.objects.deltaFrom(_objects);
+    if (objectsDelta.addedEntities.empty() && objectsDelta.removedEntities.empty())
+    {
+      ++_nbOfHits;
+      return _isGrounded;
+    }
+  }
+
+  ++_nbOfMisses;
+  groundActions.clear();
+  actionsData.clear();
+  _isGrounded = _groundActions(groundActions, actionsData, pProblem, pDomain, pMaxNbOfGroundActions);
+  if (!_isGrounded)
+  {
+    groundActions.clear();
+    actionsData.clear();
+  }
+  _domainUuid = pDomain.getUuid();
+  _objects = pProblem.objects;
+  _maxNbOfGroundActions = pMaxNbOfGroundActions;
+  return _isGrounded;
+}
+
+
+void ForwardSearchGrounding::clear()
+{
+  groundActions.clear();
+  actionsData.clear();
+  _domainUuid.clear();
+  _objects = SetOfEntities();
+  _maxNbOfGroundActions = 0;
+  _isGrounded = false;
+  _nbOfHits = 0;
+  _nbOfMisses = 0;
+}
+
+
+std::optional<std::list<ActionInvocationWithGoal>> planWithForwardSearch(const Problem& pProblem,
+                                                                         const Domain& pDomain,
+                                                                         const Goal& pGoal,
+                                                                         int pPriority,
+                                                                         const SearchStrategy& pStrategy,
+                                                                         SearchLimits* pSearchLimitsPtr,
+                                                                         ForwardSearchGrounding* pGroundingPtr)
+{
+  if (pStrategy.algorithm == SearchAlgorithm::BACKWARD_CHAINING ||
+      !GroundedStripsModel::canBeUsedFor(pDomain))
+    return {};
+
+  ForwardSearchGrounding localGrounding;
+  auto& grounding = pGroundingPtr != nullptr ? *pGroundingPtr : localGrounding;
+  if (!grounding.update(pProblem, pDomain, pStrategy.maxNbOfGroundActions))
+    return {};
+  const auto& groundActions = grounding.groundActions;
+  auto modelPtr = GroundedStripsModel::tryToCompile(grounding.actionsData, pGoal, pProblem.worldState, pDomain);
+  if (!modelPtr)
+    return {};
+
+  auto actionIndexesOpt = _search(*modelPtr, pStrategy, pSearchLimitsPtr);
+  if (!actionIndexesOpt)
+    return {};
+  std::list<ActionInvocationWithGoal> res;
+  for (const auto& currActionIndex : *actionIndexesOpt)
+  {
+    const auto& groundAction = groundActions[currActionIndex];
+    res.emplace_back(*groundAction.actionIdPtr, groundAction.parameters, pGoal.clone(), pPriority);
+  }
+  return res;
+}
+
+
+} // End of namespace ogp
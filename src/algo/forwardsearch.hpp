@@ -0,0 +1,95 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_FORWARDSEARCH_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_FORWARDSEARCH_HPP
+
+#include <list>
+#include <optional>
+#include <string>
+#include <vector>
+#include <orderedgoalsplanner/types/actioninvocationwithgoal.hpp>
+#include <orderedgoalsplanner/types/searchstrategy.hpp>
+#include <orderedgoalsplanner/types/setofentities.hpp>
+#include "actiondataforparallelisation.hpp"
+
+namespace ogp
+{
+struct Domain;
+struct Goal;
+struct Problem;
+struct SearchLimits;
+
+
+/**
+ * Actions of a domain grounded with all the objects and constants of their parameter types.<br/>
+ * The grounding only depends on the domain and on the objects, so it is reused by the searches
+ * while they do not change.
+ */
+struct ForwardSearchGrounding
+{
+  struct GroundAction
+  {
+    const ActionId* actionIdPtr;
+    std::map<Parameter, Entity> parameters;
+  };
+
+  /**
+   * @brief Ground the actions of a domain if the grounding is not already the one of the domain and of the objects.
+   * @param[in] pProblem Problem that holds the objects.
+   * @param[in] pDomain Domain of the problem.
+   * @param[in] pMaxNbOfGroundActions Maximum number of ground actions.
+   * @return False if an action cannot be grounded or if there are more ground actions than the maximum.
+   */
+  bool update(const Problem& pProblem,
+              const Domain& pDomain,
+              std::size_t pMaxNbOfGroundActions);
+
+  /// Clear the grounding and its statistics.
+  void clear();
+
+  /// Number of updates that kept the grounding.
+  std::size_t nbOfHits() const { return _nbOfHits; }
+  /// Number of updates that grounded the actions again.
+  std::size_t nbOfMisses() const { return _nbOfMisses; }
+  std::size_t maxNbOfGroundActions() const { return _maxNbOfGroundActions; }
+
+  std::vector<GroundAction> groundActions{};
+  /// Same actions as groundActions, with their conditions and effects filled with the parameters once for all the searches.
+  std::list<ActionDataForParallelisation> actionsData{};
+
+private:
+  std::string _domainUuid{};
+  SetOfEntities _objects{};
+  std::size_t _maxNbOfGroundActions = 0;
+  bool _isGrounded = false;
+  std::size_t _nbOfHits = 0;
+  std::size_t _nbOfMisses = 0;
+};
+
+
+/**
+ * @brief Plan for a goal with a forward search in the states of the problem grounded to STRIPS.<br/>
+ * The actions of the domain that can be used by the planner are grounded with all the objects and constants
+ * of their parameter types, then the search expands the states as bitsets, guided by a delete relaxation heuristic,
+ * and detects the duplicate states with their hash.
+ * @param[in] pProblem Problem to plan for. It is not modified.
+ * @param[in] pDomain Domain of the problem.
+ * @param[in] pGoal Goal to satisfy.
+ * @param[in] pPriority Priority of the goal.
+ * @param[in] pStrategy Algorithm, heuristic and bounds of the search.
+ * @param[in, out] pSearchLimitsPtr Limits of the search shared with the other searches of the plan resolution.
+ * @param[in, out] pGroundingPtr Grounding kept between the searches, nullptr to ground the actions for this search only.
+ * @return The actions to do to satisfy the goal, or nothing if the problem cannot be grounded to STRIPS
+ * or if no plan was found within the bounds.
+ */
+std::optional<std::list<ActionInvocationWithGoal>> planWithForwardSearch(const Problem& pProblem,
+                                                                         const Domain& pDomain,
+                                                                         const Goal& pGoal,
+                                                                         int pPriority,
+                                                                         const SearchStrategy& pStrategy,
+                                                                         SearchLimits* pSearchLimitsPtr,
+                                                                         ForwardSearchGrounding* pGroundingPtr = nullptr);
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_FORWARDSEARCH_HPP
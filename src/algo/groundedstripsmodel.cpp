@@ -0,0 +1,300 @@
+#include "groundedstripsmodel.hpp"
+#include <set>
+#include <string>
+#include <orderedgoalsplanner/types/condition.hpp>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/fact.hpp>
+#include <orderedgoalsplanner/types/factid.hpp>
+#include <orderedgoalsplanner/types/goal.hpp>
+#include <orderedgoalsplanner/types/worldstate.hpp>
+#include "../types/worldstatemodificationprivate.hpp"
+#include "actiondataforparallelisation.hpp"
+
+namespace ogp
+{
+namespace
+{
+/// Requirements that do not prevent to compile the domain to STRIPS.
+const std::set<std::string> _requirementsCompatibleWithStrips = {
+  ":strips", ":typing", ":negative-preconditions", ":equality", ":ordered-goals"
+};
+
+
+/// Ground atom referenced by a precondition, an effect or a goal, before the allocation of the bitsets.
+struct AtomLiteral
+{
+  std::size_t atom;
+  bool isNegated;
+};
+
+/// Index of the atoms of a model. The identifiers are local to the model, so they are released with it.
+struct AtomIndexer
+{
+  FactIdTable factIdTable;
+  /// Fact of each atom, to look for the atoms in the world state.
+  std::vector<Fact> atomToFact;
+
+  std::optional<std::size_t> getAtom(const FactOptional& pFactOptional)
+  {
+    const auto& fact = pFactOptional.fact;
+    if (fact.value() || fact.isValueNegated() || fact.isPunctual() || !FactIdTable::isGround(fact))
+      return {};
+    auto factIdOpt = factIdTable.getOrCreateFactId(fact);
+    if (!factIdOpt)
+      return {};
+    if (*factIdOpt == atomToFact.size())
+      atomToFact.emplace_back(fact);
+    return *factIdOpt;
+  }
+};
+
+
+bool _compileCondition(std::vector<AtomLiteral>& pRes,
+                       AtomIndexer& pAtomIndexer,
+                       const Condition& pCondition,
+                       bool pIsNegated)
+{
+  const auto* nodePtr = pCondition.fcNodePtr();
+  if (nodePtr != nullptr)
+  {
+    // A negated conjunction is a disjunction, so it is not STRIPS
+    if (nodePtr->nodeType != ConditionNodeType::AND || pIsNegated)
+      return false;
+    return (!nodePtr->leftOperand || _compileCondition(pRes, pAtomIndexer, *nodePtr->leftOperand, pIsNegated)) &&
+        (!nodePtr->rightOperand || _compileCondition(pRes, pAtomIndexer, *nodePtr->rightOperand, pIsNegated));
+  }
+
+  const auto* notPtr = pCondition.fcNotPtr();
+  if (notPtr != nullptr)
+    return !notPtr->condition || _compileCondition(pRes, pAtomIndexer, *notPtr->condition, !pIsNegated);
+
+  const auto* factPtr = pCondition.fcFactPtr();
+  if (factPtr != nullptr)
+  {
+    auto atomOpt = pAtomIndexer.getAtom(factPtr->factOptional);
+    if (!atomOpt)
+      return false;
+    pRes.push_back(AtomLiteral{*atomOpt, factPtr->factOptional.isFactNegated != pIsNegated});
+    return true;
+  }
+  return false;
+}
+
+
+bool _compileWorldStateModification(std::vector<AtomLiteral>& pRes,
+                                    AtomIndexer& pAtomIndexer,
+                                    const WorldStateModification& pWsModif)
+{
+  const auto* nodePtr = dynamic_cast<const WorldStateModificationNode*>(&pWsModif);
+  if (nodePtr != nullptr)
+  {
+    if (nodePtr->nodeType != WorldStateModificationNodeType::AND)
+      return false;
+    return (!nodePtr->leftOperand || _compileWorldStateModification(pRes, pAtomIndexer, *nodePtr->leftOperand)) &&
+        (!nodePtr->rightOperand || _compileWorldStateModification(pRes, pAtomIndexer, *nodePtr->rightOperand));
+  }
+
+  const auto* factPtr = dynamic_cast<const WorldStateModificationFact*>(&pWsModif);
+  if (factPtr != nullptr)
+  {
+    auto atomOpt = pAtomIndexer.getAtom(factPtr->factOptional);
+    if (!atomOpt)
+      return false;
+    pRes.push_back(AtomLiteral{*atomOpt, factPtr->factOptional.isFactNegated});
+    return true;
+  }
+  return false;
+}
+
+
+struct ActionLiterals
+{
+  std::vector<AtomLiteral> precondition;
+  std::vector<std::vector<AtomLiteral>> effects;
+};
+
+
+void _fillBitsets(StripsBitset& pPositive,
+                  StripsBitset& pNegative,
+                  const std::vector<AtomLiteral>& pLiterals)
+{
+  for (const auto& currLiteral : pLiterals)
+  {
+    if (currLiteral.isNegated)
+      pNegative.set(currLiteral.atom);
+    else
+      pPositive.set(currLiteral.atom);
+  }
+}
+
+}
+
+
+bool StripsBitset::includes(const StripsBitset& pOther) const
+{
+  for (std::size_t i = 0; i < words.size(); ++i)
+    if ((words[i] & pOther.words[i]) != pOther.words[i])
+      return false;
+  return true;
+}
+
+
+bool StripsBitset::intersects(const StripsBitset& pOther) const
+{
+  for (std::size_t i = 0; i < words.size(); ++i)
+    if ((words[i] & pOther.words[i]) != 0)
+      return true;
+  return false;
+}
+
+
+bool StripsBitset::any() const
+{
+  for (const auto& currWord : words)
+    if (currWord != 0)
+      return true;
+  return false;
+}
+
+
+bool GroundedStripsModel::canBeUsedFor(const Domain& pDomain)
+{
+  for (const auto& currRequirement : pDomain.requirements())
+    if (_requirementsCompatibleWithStrips.count(currRequirement) == 0)
+      return false;
+  for (const auto& currSetOfEvents : pDomain.getSetOfEvents())
+    if (!currSetOfEvents.second.events().empty())
+      return false;
+  return true;
+}
+
+
+std::unique_ptr<GroundedStripsModel> GroundedStripsModel::tryToCompile(std::list<ActionDataForParallelisation>& pActions,
+                                                                       const Goal& pGoal,
+                                                                       const WorldState& pWorldState,
+                                                                       const Domain& pDomain)
+{
+  AtomIndexer atomIndexer;
+  std::vector<ActionLiterals> actionsLiterals;
+  actionsLiterals.reserve(pActions.size());
+  for (auto& currAction : pActions)
+  {
+    actionsLiterals.emplace_back();
+    auto& actionLiterals = actionsLiterals.back();
+    const auto* conditionPtr = currAction.getConditionWithoutParameterPtr();
+    if (conditionPtr != nullptr && !_compileCondition(actionLiterals.precondition, atomIndexer, *conditionPtr, false))
+      return {};
+
+    for (const auto* currWsModifPtr : {currAction.getWorldStateModificationAtStartWithoutParameterPtr(),
+                                       currAction.getWorldStateModificationWithoutParameterPtr(),
+                                       currAction.getPotentialWorldStateModificationWithoutParameterPtr()})
+    {
+      if (currWsModifPtr == nullptr)
+        continue;
+      actionLiterals.effects.emplace_back();
+      if (!_compileWorldStateModification(actionLiterals.effects.back(), atomIndexer, *currWsModifPtr))
+        return {};
+    }
+  }
+
+  std::vector<AtomLiteral> goalLiterals;
+  if (!_compileCondition(goalLiterals, atomIndexer, pGoal.objective(), false))
+    return {};
+
+  auto nbOfAtoms = atomIndexer.factIdTable.nbOfFactIds();
+  std::unique_ptr<GroundedStripsModel> res(new GroundedStripsModel());
+  res->_nbOfAtoms = nbOfAtoms;
+  res->_initialState = StripsBitset(nbOfAtoms);
+  res->_timelessAtoms = StripsBitset(nbOfAtoms);
+  // Look for the atoms of the model in the world state, so the facts of the world state that are not
+  // referenced by the model are never visited
+  // The timeless facts of the domain are not always copied in the world state
+  const auto worldStateFacts = pWorldState.facts();
+  const auto domainTimelessFacts = pDomain.getTimelessFacts().setOfFacts().facts();
+  for (std::size_t atom = 0; atom < nbOfAtoms; ++atom)
+  {
+    const auto& fact = atomIndexer.atomToFact[atom];
+    if (domainTimelessFacts.find(fact) != domainTimelessFacts.end())
+    {
+      res->_initialState.set(atom);
+      res->_timelessAtoms.set(atom);
+      continue;
+    }
+    auto itFact = worldStateFacts.find(fact);
+    if (itFact == worldStateFacts.end())
+      continue;
+    res->_initialState.set(atom);
+    if (!(*itFact).second)
+      res->_timelessAtoms.set(atom);
+  }
+
+  res->_actions.reserve(actionsLiterals.size());
+  for (const auto& currActionLiterals : actionsLiterals)
+  {
+    res->_actions.emplace_back();
+    auto& compiledAction = res->_actions.back();
+    compiledAction.positivePrecondition = StripsBitset(nbOfAtoms);
+    compiledAction.negativePrecondition = StripsBitset(nbOfAtoms);
+    _fillBitsets(compiledAction.positivePrecondition, compiledAction.negativePrecondition, currActionLiterals.precondition);
+    for (const auto& currEffectLiterals : currActionLiterals.effects)
+    {
+      compiledAction.effects.emplace_back();
+      auto& effect = compiledAction.effects.back();
+      effect.add = StripsBitset(nbOfAtoms);
+      effect.del = StripsBitset(nbOfAtoms);
+      _fillBitsets(effect.add, effect.del, currEffectLiterals);
+    }
+  }
+
+  res->_goalPositiveAtoms = StripsBitset(nbOfAtoms);
+  res->_goalNegativeAtoms = StripsBitset(nbOfAtoms);
+  _fillBitsets(res->_goalPositiveAtoms, res->_goalNegativeAtoms, goalLiterals);
+  return res;
+}
+
+
+bool GroundedStripsModel::applyAction(StripsBitset& pState,
+                                      std::size_t pActionIndex) const
+{
+  const auto& action = _actions[pActionIndex];
+  if (!pState.includes(action.positivePrecondition) ||
+      pState.intersects(action.negativePrecondition))
+    return false;
+
+  bool somethingChanged = false;
+  auto& stateWords = pState.words;
+  const auto& timelessWords = _timelessAtoms.words;
+  for (const auto& currEffect : action.effects)
+  {
+    const auto& addWords = currEffect.add.words;
+    const auto& delWords = currEffect.del.words;
+    // Like in the world state, the additions are done before the removals and a removal is a modification
+    // even if the fact was not present
+    for (std::size_t i = 0; i < stateWords.size(); ++i)
+    {
+      if ((addWords[i] & ~stateWords[i]) != 0 || delWords[i] != 0)
+        somethingChanged = true;
+      stateWords[i] = (stateWords[i] | addWords[i]) & ~(delWords[i] & ~timelessWords[i]);
+    }
+  }
+  return somethingChanged;
+}
+
+
+bool GroundedStripsModel::isGoalSatisfied(const StripsBitset& pState) const
+{
+  return pState.includes(_goalPositiveAtoms) && !pState.intersects(_goalNegativeAtoms);
+}
+
+
+StripsBitset GroundedStripsModel::addedAtoms(std::size_t pActionIndex) const
+{
+  StripsBitset res(_nbOfAtoms);
+  for (const auto& currEffect : _actions[pActionIndex].effects)
+    for (std::size_t i = 0; i < res.words.size(); ++i)
+      res.words[i] |= currEffect.add.words[i];
+  return res;
+}
+
+
+} // End of namespace ogp
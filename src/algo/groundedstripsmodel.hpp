@@ -0,0 +1,126 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_GROUNDEDSTRIPSMODEL_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_GROUNDEDSTRIPSMODEL_HPP
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace ogp
+{
+struct ActionDataForParallelisation;
+struct Domain;
+struct Goal;
+struct WorldState;
+
+
+/// Dense set of ground atoms, one bit per atom.
+struct StripsBitset
+{
+  StripsBitset(std::size_t pNbOfAtoms = 0)
+    : words((pNbOfAtoms + 63) / 64, 0)
+  {
+  }
+
+  void set(std::size_t pAtom) { words[pAtom / 64] |= std::uint64_t(1) << (pAtom % 64); }
+  bool test(std::size_t pAtom) const { return (words[pAtom / 64] >> (pAtom % 64)) & 1; }
+
+  /// Check if all the atoms of pOther are in this set.
+  bool includes(const StripsBitset& pOther) const;
+  /// Check if at least one atom of pOther is in this set.
+  bool intersects(const StripsBitset& pOther) const;
+  bool any() const;
+
+  bool operator==(const StripsBitset& pOther) const { return words == pOther.words; }
+
+  std::vector<std::uint64_t> words;
+};
+
+
+/**
+ * Grounded STRIPS compilation of a sequence of actions and of a goal.<br/>
+ * The atoms are the ground boolean facts referenced by the actions and the goal, so the world state
+ * becomes a bitset and applying an action is a few word-wise AND/OR operations.<br/>
+ * The compilation only succeeds if every precondition is a conjunction of ground boolean facts or their negation,
+ * if every effect is a conjunction of ground boolean facts to add or to remove and if the goal is a conjunction of
+ * ground boolean facts or their negation.
+ */
+struct GroundedStripsModel
+{
+  /**
+   * @brief Check if the requirements of the domain permit to use a grounded STRIPS model.<br/>
+   * The domain must not have events because they can modify the world state after each action.
+   * @param[in] pDomain Domain to check.
+   * @return True if the grounded STRIPS model can be tried for this domain.
+   */
+  static bool canBeUsedFor(const Domain& pDomain);
+
+  /**
+   * @brief Compile a sequence of actions and a goal into a grounded STRIPS model.
+   * @param[in] pActions Actions to compile, with their parameters already filled.
+   * @param[in] pGoal Goal to compile.
+   * @param[in] pWorldState World state to convert to the initial state of the model.
+   * @param[in] pDomain Domain of the actions, its timeless facts are in the initial state and cannot be removed.
+   * @return The model, or nullptr if an action or the goal is not STRIPS.
+   */
+  static std::unique_ptr<GroundedStripsModel> tryToCompile(std::list<ActionDataForParallelisation>& pActions,
+                                                           const Goal& pGoal,
+                                                           const WorldState& pWorldState,
+                                                           const Domain& pDomain);
+
+  const StripsBitset& initialState() const { return _initialState; }
+
+  /**
+   * @brief Apply an action to a state, with the same semantic as applying the action to the world state.
+   * @param[in, out] pState State to modify.
+   * @param[in] pActionIndex Index of the action in the actions given to tryToCompile.
+   * @return True if the precondition was satisfied and if the effects modified something, false otherwise.
+   */
+  bool applyAction(StripsBitset& pState,
+                   std::size_t pActionIndex) const;
+
+  bool isGoalSatisfied(const StripsBitset& pState) const;
+
+  std::size_t nbOfAtoms() const { return _nbOfAtoms; }
+  std::size_t nbOfActions() const { return _actions.size(); }
+
+  /// Atoms that have to be in the state to apply an action.
+  const StripsBitset& positivePrecondition(std::size_t pActionIndex) const { return _actions[pActionIndex].positivePrecondition; }
+
+  /// Atoms added by any of the effects of an action.
+  StripsBitset addedAtoms(std::size_t pActionIndex) const;
+
+  /// Atoms that have to be in the state to satisfy the goal.
+  const StripsBitset& goalPositiveAtoms() const { return _goalPositiveAtoms; }
+
+private:
+  struct Effect
+  {
+    StripsBitset add;
+    StripsBitset del;
+  };
+
+  struct CompiledAction
+  {
+    StripsBitset positivePrecondition;
+    StripsBitset negativePrecondition;
+    /// Effects at start, at end and potentially at end, in the order to apply them.
+    std::vector<Effect> effects;
+  };
+
+  GroundedStripsModel() = default;
+
+  std::size_t _nbOfAtoms = 0;
+  StripsBitset _initialState;
+  /// Atoms that cannot be removed because they are timeless in the world state.
+  StripsBitset _timelessAtoms;
+  std::vector<CompiledAction> _actions;
+  StripsBitset _goalPositiveAtoms;
+  StripsBitset _goalNegativeAtoms;
+};
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_GROUNDEDSTRIPSMODEL_HPP
@@ -0,0 +1,238 @@
+#include "incrementalmatcher.hpp"
+#include <orderedgoalsplanner/types/condition.hpp>
+#include <orderedgoalsplanner/types/setoffacts.hpp>
+
+namespace ogp
+{
+namespace
+{
+
+bool _extractFactPatterns(std::vector<const Fact*>& pRes,
+                          const Condition& pCondition)
+{
+  const auto* nodePtr = pCondition.fcNodePtr();
+  if (nodePtr != nullptr)
+  {
+    if (nodePtr->nodeType != ConditionNodeType::AND)
+      return false;
+    return (!nodePtr->leftOperand || _extractFactPatterns(pRes, *nodePtr->leftOperand)) &&
+        (!nodePtr->rightOperand || _extractFactPatterns(pRes, *nodePtr->rightOperand));
+  }
+
+  const auto* factPtr = pCondition.fcFactPtr();
+  if (factPtr != nullptr)
+  {
+    const auto& fact = factPtr->factOptional.fact;
+    if (factPtr->factOptional.isFactNegated || fact.isPunctual() || fact.hasAFluentArgument() ||
+        fact.isValueNegated() || fact.isMissingValue())
+      return false;
+    pRes.push_back(&fact);
+    return true;
+  }
+  return false;
+}
+
+}
+
+
+std::shared_ptr<const IncrementalMatcher> IncrementalMatcher::tryToCompile(const Condition& pCondition,
+                                                                           const std::vector<Parameter>& pParameters)
+{
+  std::vector<const Fact*> facts;
+  if (!_extractFactPatterns(facts, pCondition) || facts.empty())
+    return {};
+
+  std::shared_ptr<IncrementalMatcher> res(new IncrementalMatcher());
+  res->_parameters = pParameters;
+  std::vector<bool> parametersUsed(pParameters.size(), false);
+
+  auto compileTerm = [&](Term& pTerm, const Entity& pEntity) {
+    if (pEntity.isAnyEntity())
+    {
+      pTerm.kind = Term::Kind::ANY;
+      return true;
+    }
+    if (pEntity.isAParameterToFill())
+    {
+      for (std::size_t i = 0; i < pParameters.size(); ++i)
+      {
+        if (pParameters[i].name == pEntity.value)
+        {
+          pTerm.kind = Term::Kind::PARAMETER;
+          pTerm.parameterIndex = i;
+          parametersUsed[i] = true;
+          return true;
+        }
+      }
+      return false;
+    }
+    pTerm.kind = Term::Kind::CONSTANT;
+    pTerm.constant = pEntity.value;
+    return true;
+  };
+
+  for (const auto* currFactPtr : facts)
+  {
+    Pattern pattern{*currFactPtr, {}, {}};
+    for (const auto& currArg : currFactPtr->arguments())
+    {
+      pattern.arguments.emplace_back();
+      if (!currArg.isEntity() || !compileTerm(pattern.arguments.back(), currArg.entity()))
+        return {};
+    }
+    if (currFactPtr->value())
+    {
+      pattern.value = std::make_unique<Term>();
+      if (!compileTerm(*pattern.value, *currFactPtr->value()))
+        return {};
+    }
+    res->_predicateToPatterns[currFactPtr->name()].push_back(res->_patterns.size());
+    res->_patterns.emplace_back(std::move(pattern));
+  }
+
+  // A parameter not bound by a fact would need an enumeration of the entities
+  for (bool currParameterUsed : parametersUsed)
+    if (!currParameterUsed)
+      return {};
+  return res;
+}
+
+
+void IncrementalMatcher::iterateOnNewMatches(const std::function<bool (const std::map<Parameter, Entity>&)>& pCallback,
+                                             const std::set<Fact>& pAddedFacts,
+                                             const SetOfFacts& pFacts) const
+{
+  std::set<std::map<Parameter, Entity>> alreadyMatched;
+  bool shouldStop = false;
+  Binding binding(_parameters.size(), nullptr);
+  std::vector<std::size_t> newlyBound;
+  for (const auto& currAddedFact : pAddedFacts)
+  {
+    auto itPatterns = _predicateToPatterns.find(currAddedFact.name());
+    if (itPatterns == _predicateToPatterns.end())
+      continue;
+    for (const auto& currPatternIndex : itPatterns->second)
+    {
+      newlyBound.clear();
+      if (!_unify(binding, newlyBound, _patterns[currPatternIndex], currAddedFact))
+        continue;
+      // The added fact can be removed by a later modification of the same notification
+      if (pFacts.contains(currAddedFact))
+      {
+        _join(binding, 0, currPatternIndex, pFacts, [&](const Binding& pCompleteBinding) {
+          std::map<Parameter, Entity> parametersToValue;
+          for (std::size_t i = 0; i < _parameters.size(); ++i)
+            parametersToValue.emplace(_parameters[i], *pCompleteBinding[i]);
+          if (alreadyMatched.insert(parametersToValue).second && pCallback(parametersToValue))
+            shouldStop = true;
+          return shouldStop;
+        });
+      }
+      for (const auto& currParameterIndex : newlyBound)
+        binding[currParameterIndex] = nullptr;
+      if (shouldStop)
+        return;
+    }
+  }
+}
+
+
+bool IncrementalMatcher::hasANewMatch(const std::set<Fact>& pAddedFacts,
+                                      const SetOfFacts& pFacts) const
+{
+  bool res = false;
+  iterateOnNewMatches([&](const std::map<Parameter, Entity>&) {
+    res = true;
+    return true;
+  }, pAddedFacts, pFacts);
+  return res;
+}
+
+
+bool IncrementalMatcher::_unify(Binding& pBinding,
+                                std::vector<std::size_t>& pNewlyBound,
+                                const Pattern& pPattern,
+                                const Fact& pFact) const
+{
+  auto unifyTerm = [&](const Term& pTerm, const Entity& pEntity) {
+    switch (pTerm.kind)
+    {
+    case Term::Kind::ANY:
+      return true;
+    case Term::Kind::CONSTANT:
+      return pTerm.constant == pEntity.value;
+    case Term::Kind::PARAMETER:
+    {
+      auto*& boundEntityPtr = pBinding[pTerm.parameterIndex];
+      if (boundEntityPtr != nullptr)
+        return boundEntityPtr->value == pEntity.value;
+      const auto& parameterType = _parameters[pTerm.parameterIndex].type;
+      if (pEntity.type && parameterType && !pEntity.type->isA(*parameterType))
+        return false;
+      boundEntityPtr = &pEntity;
+      pNewlyBound.push_back(pTerm.parameterIndex);
+      return true;
+    }
+    }
+    return false;
+  };
+
+  bool res = pFact.name() == pPattern.fact.name() &&
+      pFact.arguments().size() == pPattern.arguments.size() &&
+      !pFact.isValueNegated();
+  for (std::size_t i = 0; res && i < pPattern.arguments.size(); ++i)
+  {
+    const auto& currArg = pFact.arguments()[i];
+    res = currArg.isEntity() && unifyTerm(pPattern.arguments[i], currArg.entity());
+  }
+  if (res && pPattern.value)
+    res = pFact.value() && unifyTerm(*pPattern.value, *pFact.value());
+
+  if (!res)
+  {
+    for (const auto& currParameterIndex : pNewlyBound)
+      pBinding[currParameterIndex] = nullptr;
+    pNewlyBound.clear();
+  }
+  return res;
+}
+
+
+bool IncrementalMatcher::_join(Binding& pBinding,
+                               std::size_t pPatternIndex,
+                               std::size_t pSeedPatternIndex,
+                               const SetOfFacts& pFacts,
+                               const std::function<bool (const Binding&)>& pCallback) const
+{
+  if (pPatternIndex == pSeedPatternIndex)
+    ++pPatternIndex;
+  if (pPatternIndex >= _patterns.size())
+    return pCallback(pBinding);
+
+  // Use the indexes of the world state with the parameters already bound
+  const auto& pattern = _patterns[pPatternIndex];
+  std::map<Parameter, Entity> boundParameters;
+  for (std::size_t i = 0; i < _parameters.size(); ++i)
+    if (pBinding[i] != nullptr)
+      boundParameters.emplace(_parameters[i], *pBinding[i]);
+  Fact factToLookFor = pattern.fact;
+  if (!boundParameters.empty())
+    factToLookFor.replaceArguments(boundParameters);
+
+  std::vector<std::size_t> newlyBound;
+  for (const auto& currFact : pFacts.find(factToLookFor))
+  {
+    newlyBound.clear();
+    if (!_unify(pBinding, newlyBound, pattern, currFact))
+      continue;
+    bool shouldStop = _join(pBinding, pPatternIndex + 1, pSeedPatternIndex, pFacts, pCallback);
+    for (const auto& currParameterIndex : newlyBound)
+      pBinding[currParameterIndex] = nullptr;
+    if (shouldStop)
+      return true;
+  }
+  return false;
+}
+
+
+} // End of namespace ogp
@@ -0,0 +1,97 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_INCREMENTALMATCHER_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_INCREMENTALMATCHER_HPP
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <orderedgoalsplanner/types/entity.hpp>
+#include <orderedgoalsplanner/types/fact.hpp>
+#include <orderedgoalsplanner/types/parameter.hpp>
+
+namespace ogp
+{
+struct Condition;
+struct SetOfFacts;
+
+
+/**
+ * Incremental matcher of a condition against the deltas of a world state.<br/>
+ * Each fact pattern of the condition is an alpha memory, backed by the indexes of the world state, and
+ * the parameters are bound by joining the patterns one after the other.<br/>
+ * Only the matches that use at least one added fact are produced, so an event or a callback fires only
+ * on the new complete matches instead of evaluating again its condition from scratch.<br/>
+ * The compilation only succeeds if the condition is a conjunction of positive and not punctual facts
+ * without fluent arguments and if every parameter appears in at least one of these facts.
+ */
+struct IncrementalMatcher
+{
+  /**
+   * @brief Compile a condition into an incremental matcher.
+   * @param[in] pCondition Condition to compile.
+   * @param[in] pParameters Parameters of the condition.
+   * @return The matcher, or nullptr if the condition is not supported.
+   */
+  static std::shared_ptr<const IncrementalMatcher> tryToCompile(const Condition& pCondition,
+                                                                const std::vector<Parameter>& pParameters);
+
+  /**
+   * @brief Iterate on the new complete matches of the condition.
+   * @param[in] pCallback Callback called for each distinct binding of the parameters. Return true to stop the iteration.
+   * @param[in] pAddedFacts Facts added since the last time the condition was checked.
+   * @param[in] pFacts Facts of the world state, that already contain the added facts.
+   */
+  void iterateOnNewMatches(const std::function<bool (const std::map<Parameter, Entity>&)>& pCallback,
+                           const std::set<Fact>& pAddedFacts,
+                           const SetOfFacts& pFacts) const;
+
+  bool hasANewMatch(const std::set<Fact>& pAddedFacts,
+                    const SetOfFacts& pFacts) const;
+
+private:
+  IncrementalMatcher() = default;
+
+  /// Argument or value of a fact pattern.
+  struct Term
+  {
+    enum class Kind { CONSTANT, PARAMETER, ANY };
+    Kind kind;
+    /// Index in _parameters for a parameter.
+    std::size_t parameterIndex;
+    std::string constant;
+  };
+
+  struct Pattern
+  {
+    Fact fact;
+    std::vector<Term> arguments;
+    /// No value means that the value is not considered.
+    std::unique_ptr<Term> value;
+  };
+
+  using Binding = std::vector<const Entity*>;
+
+  bool _unify(Binding& pBinding,
+              std::vector<std::size_t>& pNewlyBound,
+              const Pattern& pPattern,
+              const Fact& pFact) const;
+
+  bool _join(Binding& pBinding,
+             std::size_t pPatternIndex,
+             std::size_t pSeedPatternIndex,
+             const SetOfFacts& pFacts,
+             const std::function<bool (const Binding&)>& pCallback) const;
+
+  std::vector<Parameter> _parameters;
+  std::vector<Pattern> _patterns;
+  /// Alpha memories entry points: predicate name to indexes of the patterns.
+  std::map<std::string, std::vector<std::size_t>> _predicateToPatterns;
+};
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_INCREMENTALMATCHER_HPP
@@ -0,0 +1,151 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_LRUCACHE_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_LRUCACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace ogp
+{
+
+
+/**
+ * Cache with a bounded number of entries, the least recently used entry is evicted first.<br/>
+ * It counts the hits and the misses of the searches.<br/>
+ * All the functions are thread-safe.
+ */
+template <typename KEY, typename VALUE, typename HASHER = std::hash<KEY>>
+struct LruCache
+{
+  LruCache(std::size_t pMaxNbOfEntries)
+    : _maxNbOfEntries(pMaxNbOfEntries),
+      _mutex(),
+      _entries(),
+      _keyToEntry(),
+      _nbOfHits(0),
+      _nbOfMisses(0)
+  {
+  }
+
+  LruCache(const LruCache&) = delete;
+  LruCache& operator=(const LruCache&) = delete;
+
+  /// Get the value of a key and count a hit or a miss.
+  std::optional<VALUE> find(const KEY& pKey)
+  {
+    return find(pKey, [](const VALUE&) { return true; });
+  }
+
+  /**
+   * @brief Get the value of a key if it is accepted by a predicate, and count a hit or a miss.<br/>
+   * It is useful when the key is a hash, to check the content that the hash represents.
+   * @param[in] pKey Key to search.
+   * @param[in] pIsAccepted Predicate called with the value found for the key. A refused value is counted as a miss.
+   * @return The value accepted, nothing otherwise.
+   */
+  std::optional<VALUE> find(const KEY& pKey,
+                            const std::function<bool(const VALUE&)>& pIsAccepted)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _keyToEntry.find(pKey);
+    if (it == _keyToEntry.end() || !pIsAccepted(it->second->second))
+    {
+      ++_nbOfMisses;
+      return {};
+    }
+    ++_nbOfHits;
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return it->second->second;
+  }
+
+  /// Set the value of a key, the least recently used entry is evicted if the cache is full.
+  void insert(const KEY& pKey,
+              const VALUE& pValue)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_maxNbOfEntries == 0)
+      return;
+    auto it = _keyToEntry.find(pKey);
+    if (it != _keyToEntry.end())
+    {
+      it->second->second = pValue;
+      _entries.splice(_entries.begin(), _entries, it->second);
+      return;
+    }
+    _evictUntilSize(_maxNbOfEntries - 1);
+    _entries.emplace_front(pKey, pValue);
+    _keyToEntry.emplace(pKey, _entries.begin());
+  }
+
+  /// Remove all the entries and reset the counters.
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _keyToEntry.clear();
+    _nbOfHits = 0;
+    _nbOfMisses = 0;
+  }
+
+  /// Set the maximum number of entries, the least recently used entries are evicted if there are too many entries.
+  void setMaxNbOfEntries(std::size_t pMaxNbOfEntries)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxNbOfEntries = pMaxNbOfEntries;
+    _evictUntilSize(_maxNbOfEntries);
+  }
+
+  std::size_t maxNbOfEntries() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _maxNbOfEntries;
+  }
+
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+  }
+
+  std::size_t nbOfHits() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _nbOfHits;
+  }
+
+  std::size_t nbOfMisses() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _nbOfMisses;
+  }
+
+private:
+  using Entries = std::list<std::pair<KEY, VALUE>>;
+
+  std::size_t _maxNbOfEntries;
+  mutable std::mutex _mutex;
+  /// Most recently used entry first.
+  Entries _entries;
+  std::unordered_map<KEY, typename Entries::iterator, HASHER> _keyToEntry;
+  std::size_t _nbOfHits;
+  std::size_t _nbOfMisses;
+
+  void _evictUntilSize(std::size_t pSize)
+  {
+    while (_entries.size() > pSize)
+    {
+      _keyToEntry.erase(_entries.back().first);
+      _entries.pop_back();
+    }
+  }
+};
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_LRUCACHE_HPP
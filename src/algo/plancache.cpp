@@ -0,0 +1,107 @@
+#include "plancache.hpp"
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/historical.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/types/searchstrategy.hpp>
+#include "../util/hash.hpp"
+
+namespace ogp
+{
+namespace
+{
+
+/// A goal that is removed after some time of inactivity makes the plan depend on the current time.
+bool _dependsOnTime(const Problem& pProblem,
+                    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
+{
+  if (!pNow)
+    return false;
+  for (const auto& currGoalsGroup : pProblem.goalStack.goals())
+    for (const auto& currGoal : currGoalsGroup.second)
+      if (currGoal.getMaxTimeToKeepInactive() > 0)
+        return true;
+  return false;
+}
+
+}
+
+
+PlanCache::PlanCache(std::size_t pMaxNbOfPlans)
+  : _cache(pMaxNbOfPlans)
+{
+}
+
+
+std::optional<PlanCache::Key> PlanCache::computeKey(const Problem& pProblem,
+                                                    const Domain& pDomain,
+                                                    bool pTryToDoMoreOptimalSolution,
+                                                    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                    const Historical* pGlobalHistorical) const
+{
+  if (_cache.maxNbOfEntries() == 0 || _dependsOnTime(pProblem, pNow))
+    return {};
+  // The objects are not hashed, they rarely change between the calls and they are compared on a hit
+  Key res{pProblem.worldState.hash(), pProblem.goalStack.hash(), pProblem.historical.hash()};
+  combineHash(res.contextFingerprint, hashStr(pDomain.getUuid()));
+  combineHash(res.contextFingerprint, pTryToDoMoreOptimalSolution ? 1 : 0);
+  // Separate the two historicals so that their counts cannot be mixed up
+  combineHash(res.contextFingerprint, pGlobalHistorical != nullptr ? 1 : 0);
+  if (pGlobalHistorical != nullptr)
+    combineHash(res.contextFingerprint, pGlobalHistorical->hash());
+  return res;
+}
+
+
+std::string PlanCache::contextToStr(const Domain& pDomain,
+                                    bool pTryToDoMoreOptimalSolution,
+                                    const Historical* pGlobalHistorical,
+                                    const SearchStrategy* pSearchStrategyPtr)
+{
+  std::string res = "domain: " + pDomain.getUuid() + "\n";
+  res += pTryToDoMoreOptimalSolution ? "optimal\n" : "not optimal\n";
+  if (pGlobalHistorical != nullptr)
+    res += "global historical: " + pGlobalHistorical->toStr() + "\n";
+  if (pSearchStrategyPtr != nullptr && pSearchStrategyPtr->algorithm != SearchAlgorithm::BACKWARD_CHAINING)
+    res += "search: " + std::to_string(static_cast<int>(pSearchStrategyPtr->algorithm)) + " " +
+        std::to_string(static_cast<int>(pSearchStrategyPtr->heuristic)) + " " +
+        std::to_string(pSearchStrategyPtr->weight) + " " +
+        std::to_string(pSearchStrategyPtr->maxNbOfExpansions) + " " +
+        std::to_string(pSearchStrategyPtr->maxNbOfGroundActions) + "\n";
+  return res;
+}
+
+
+std::optional<std::list<ActionInvocationWithGoal>> PlanCache::find(const Key& pKey,
+                                                                   const Problem& pProblem,
+                                                                   const std::string& pContext)
+{
+  auto entryOpt = _cache.find(pKey, [&](const Entry& pEntry) {
+    return pEntry.state.isStateOf(pProblem, pContext);
+  });
+  if (entryOpt)
+    return std::move(entryOpt->plan);
+  return {};
+}
+
+
+void PlanCache::insertIfProblemIsUnchanged(const Key& pKey,
+                                           CachedProblemState pStateBefore,
+                                           const Problem& pProblem,
+                                           const std::list<ActionInvocationWithGoal>& pPlan)
+{
+  // The planner can remove the satisfied goals or apply the effects between the goals
+  if (pStateBefore.isStateOf(pProblem, pStateBefore.context))
+    _cache.insert(pKey, Entry{pPlan, std::move(pStateBefore)});
+}
+
+
+std::size_t PlanCache::KeyHasher::operator()(const Key& pKey) const
+{
+  auto res = pKey.worldStateHash;
+  combineHash(res, pKey.goalStackHash);
+  combineHash(res, pKey.contextFingerprint);
+  return static_cast<std::size_t>(res);
+}
+
+
+} // End of namespace ogp
@@ -0,0 +1,135 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_PLANCACHE_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_PLANCACHE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <orderedgoalsplanner/types/actioninvocationwithgoal.hpp>
+#include "cachedproblemstate.hpp"
+#include "lrucache.hpp"
+
+namespace ogp
+{
+struct Domain;
+struct Historical;
+struct Problem;
+struct SearchStrategy;
+
+
+/**
+ * Memoization of the plans returned by the planner between the calls of a planner session.<br/>
+ * A call is identified by the state of the problem, by the historicals and by the kind of search,
+ * so a call done again after a modification that did not change anything returns the previous plan.<br/>
+ * The plans are searched by hashes and the state is compared on a hit, so a collision is a miss.<br/>
+ * Only the calls that did not modify the problem are memorized, because a cached plan cannot replay the modifications.<br/>
+ * The number of plans is bounded, the least recently used plan is evicted first. A capacity of 0 disables the cache.<br/>
+ * All the functions are thread-safe.
+ */
+struct PlanCache
+{
+  /// Identifier of a call of the planner.
+  struct Key
+  {
+    /// Hash of the facts of the world state.
+    std::uint64_t worldStateHash;
+    /// Hash of the goals to satisfy.
+    std::uint64_t goalStackHash;
+    /// Fingerprint of the domain, of the historicals and of the kind of search.
+    std::uint64_t contextFingerprint;
+
+    bool operator==(const Key& pOther) const
+    {
+      return worldStateHash == pOther.worldStateHash && goalStackHash == pOther.goalStackHash &&
+          contextFingerprint == pOther.contextFingerprint;
+    }
+  };
+
+  PlanCache(std::size_t pMaxNbOfPlans = 0);
+
+  /**
+   * @brief Compute the key of a call of the planner.
+   * @param[in] pProblem Problem to plan for.
+   * @param[in] pDomain Domain of the problem.
+   * @param[in] pTryToDoMoreOptimalSolution If the planner compares the candidate actions.
+   * @param[in] pNow Current time.
+   * @param[in] pGlobalHistorical Historical shared between the problems.
+   * @return The key of the call, or nothing if the cache is disabled or if the plan depends on the current time.
+   */
+  std::optional<Key> computeKey(const Problem& pProblem,
+                                const Domain& pDomain,
+                                bool pTryToDoMoreOptimalSolution,
+                                const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                const Historical* pGlobalHistorical) const;
+
+  /**
+   * @brief Convert the data of a call of the planner that are not in the problem to the context of a cached state.
+   * @param[in] pDomain Domain of the problem.
+   * @param[in] pTryToDoMoreOptimalSolution If the planner compares the candidate actions.
+   * @param[in] pGlobalHistorical Historical shared between the problems.
+   * @param[in] pSearchStrategyPtr Search chosen for the call, nullptr for the backward chaining.
+   * @return The context of the call.
+   */
+  static std::string contextToStr(const Domain& pDomain,
+                                  bool pTryToDoMoreOptimalSolution,
+                                  const Historical* pGlobalHistorical,
+                                  const SearchStrategy* pSearchStrategyPtr = nullptr);
+
+  /**
+   * @brief Get the plan memorized for a call and count a hit or a miss.
+   * @param[in] pKey Key of the call.
+   * @param[in] pProblem Problem to plan for.
+   * @param[in] pContext Context of the call returned by contextToStr.
+   * @return The plan memorized if the entry of the key was computed for the same state.
+   */
+  std::optional<std::list<ActionInvocationWithGoal>> find(const Key& pKey,
+                                                          const Problem& pProblem,
+                                                          const std::string& pContext);
+
+  /**
+   * @brief Memorize the plan of a call if the call did not modify the problem.
+   * @param[in] pKey Key of the call.
+   * @param[in] pStateBefore State of the problem before the call, with the context returned by contextToStr.
+   * @param[in] pProblem Problem after the call.
+   * @param[in] pPlan Plan returned by the call.
+   */
+  void insertIfProblemIsUnchanged(const Key& pKey,
+                                  CachedProblemState pStateBefore,
+                                  const Problem& pProblem,
+                                  const std::list<ActionInvocationWithGoal>& pPlan);
+
+  /// Set the maximum number of plans, 0 to disable the cache.
+  void setMaxNbOfPlans(std::size_t pMaxNbOfPlans) { _cache.setMaxNbOfEntries(pMaxNbOfPlans); }
+
+  /// Remove all the plans and reset the counters.
+  void clear() { _cache.clear(); }
+
+  std::size_t size() const { return _cache.size(); }
+  std::size_t nbOfHits() const { return _cache.nbOfHits(); }
+  std::size_t nbOfMisses() const { return _cache.nbOfMisses(); }
+  std::size_t maxNbOfPlans() const { return _cache.maxNbOfEntries(); }
+
+private:
+  struct KeyHasher
+  {
+    std::size_t operator()(const Key& pKey) const;
+  };
+
+  /// Plan of a call with the state it was computed for.
+  struct Entry
+  {
+    std::list<ActionInvocationWithGoal> plan;
+    CachedProblemState state;
+  };
+
+  LruCache<Key, Entry, KeyHasher> _cache;
+};
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_PLANCACHE_HPP
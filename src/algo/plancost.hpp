@@ -0,0 +1,38 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_PLANCOST_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_PLANCOST_HPP
+
+#include <cstddef>
+#include <orderedgoalsplanner/util/number.hpp>
+
+namespace ogp
+{
+
+
+/// Cost of the plan found by a rollout, to compare the candidate actions.
+struct PlanCost
+{
+  bool success = true;
+  std::size_t nbOfGoalsNotSatisfied = 0;
+  std::size_t nbOfGoalsSatisfied = 0;
+  Number totalCost = 0;
+  Number costForFirstGoal = 0;
+
+  bool isBetterThan(const PlanCost& pOther) const
+  {
+    if (success != pOther.success)
+      return success;
+    if (nbOfGoalsNotSatisfied != pOther.nbOfGoalsNotSatisfied)
+      return nbOfGoalsNotSatisfied > pOther.nbOfGoalsNotSatisfied;
+    if (nbOfGoalsSatisfied != pOther.nbOfGoalsSatisfied)
+      return nbOfGoalsSatisfied > pOther.nbOfGoalsSatisfied;
+    if (costForFirstGoal != pOther.costForFirstGoal)
+      return costForFirstGoal < pOther.costForFirstGoal;
+    return totalCost < pOther.totalCost;
+  }
+};
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_PLANCOST_HPP
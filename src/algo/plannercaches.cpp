@@ -0,0 +1,173 @@
+#include "plannercaches.hpp"
+#include <algorithm>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/goal.hpp>
+#include <orderedgoalsplanner/types/historical.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/types/worldstatemodification.hpp>
+#include "../util/hash.hpp"
+
+namespace ogp
+{
+namespace
+{
+
+std::string _goalKey(const Goal& pGoal,
+                     bool pTryToDoMoreOptimalSolution)
+{
+  return (pTryToDoMoreOptimalSolution ? "1" : "0") + pGoal.toPddl(0);
+}
+
+/// Hash of the facts and of what can change the resolution of the goals in addition to the facts and the objects.
+std::uint64_t _stateHash(const Problem& pProblem,
+                         const Historical* pGlobalHistorical)
+{
+  std::uint64_t res = pProblem.worldState.hash();
+  combineHash(res, pProblem.goalStack.hash());
+  combineHash(res, pProblem.historical.hash());
+  combineHash(res, pGlobalHistorical != nullptr ? pGlobalHistorical->hash() : 0);
+  return res;
+}
+
+bool _areEqual(const std::map<std::string, MinMaxValues>& pMinMaxValues1,
+               const std::map<std::string, MinMaxValues>& pMinMaxValues2)
+{
+  return pMinMaxValues1.size() == pMinMaxValues2.size() &&
+      std::equal(pMinMaxValues1.begin(), pMinMaxValues1.end(), pMinMaxValues2.begin(),
+                 [](const auto& pElt1, const auto& pElt2) {
+                   return pElt1.first == pElt2.first && pElt1.second.min == pElt2.second.min &&
+                       pElt1.second.max == pElt2.second.max;
+                 });
+}
+
+}
+
+const std::size_t PlannerCaches::maxNbOfStatesWithFailedGoals = 4;
+
+
+std::map<std::string, MinMaxValues> PlannerCaches::minMaxValuesForFacts(const Problem& pProblem,
+                                                                        const Domain& pDomain)
+{
+  refreshIfNeeded(pDomain);
+  if (!_areMinMaxValuesOfDomainComputed)
+  {
+    extractMinMaxValuesForFactsOfDomain(_minMaxValuesOfDomain, pDomain);
+    _areMinMaxValuesOfDomainComputed = true;
+  }
+  // The merge of the min and max values does not depend on the order of the extractions
+  auto res = _minMaxValuesOfDomain;
+  extractMinMaxValuesForFactsOfGoals(res, pProblem.goalStack);
+  return res;
+}
+
+
+bool PlannerCaches::hasGoalFailed(const Goal& pGoal,
+                                  bool pTryToDoMoreOptimalSolution,
+                                  const Problem& pProblem,
+                                  const Historical* pGlobalHistorical)
+{
+  if (_statesWithFailedGoals.empty())
+    return false;
+  auto itState = _findState(pProblem, _stateHash(pProblem, pGlobalHistorical));
+  return itState != _statesWithFailedGoals.end() &&
+      itState->failedGoals.count(_goalKey(pGoal, pTryToDoMoreOptimalSolution)) > 0;
+}
+
+
+void PlannerCaches::notifyGoalFailure(const Goal& pGoal,
+                                      bool pTryToDoMoreOptimalSolution,
+                                      const Problem& pProblem,
+                                      const Historical* pGlobalHistorical)
+{
+  auto stateHash = _stateHash(pProblem, pGlobalHistorical);
+  auto itState = _findState(pProblem, stateHash);
+  if (itState == _statesWithFailedGoals.end())
+  {
+    if (_statesWithFailedGoals.size() >= maxNbOfStatesWithFailedGoals)
+      _statesWithFailedGoals.pop_back();
+    // The copy of the facts shares the chunks of the world state
+    _statesWithFailedGoals.push_front(StateWithFailedGoals{stateHash, pProblem.worldState.factsMapping(), pProblem.objects, {}});
+    itState = _statesWithFailedGoals.begin();
+  }
+  itState->failedGoals.insert(_goalKey(pGoal, pTryToDoMoreOptimalSolution));
+}
+
+
+ActionGroundings& PlannerCaches::actionGroundings(const Problem& pProblem,
+                                                  const Domain& pDomain)
+{
+  refreshIfNeeded(pDomain);
+  if (!_actionGroundingsPtr)
+    _actionGroundingsPtr = std::make_unique<ActionGroundings>(pDomain);
+  _actionGroundingsPtr->update(pProblem.worldState, pProblem.goalStack.effectBetweenGoals.get(), pProblem.objects);
+  return *_actionGroundingsPtr;
+}
+
+
+TranspositionTable& PlannerCaches::transpositionTable(const std::map<std::string, MinMaxValues>& pMinMaxValuesForFacts)
+{
+  if (!_areEqual(pMinMaxValuesForFacts, _minMaxValuesOfTranspositionTable))
+  {
+    _transpositionTable.clear();
+    _minMaxValuesOfTranspositionTable = pMinMaxValuesForFacts;
+  }
+  return _transpositionTable;
+}
+
+
+void PlannerCaches::setNbOfThreads(std::size_t pNbOfThreads)
+{
+  _threadPoolPtr = pNbOfThreads > 1 ? std::make_unique<ThreadPool>(pNbOfThreads - 1) : std::unique_ptr<ThreadPool>();
+}
+
+
+void PlannerCaches::refreshIfNeeded(const Domain& pDomain)
+{
+  if (_domainUuid != pDomain.getUuid())
+  {
+    clear();
+    _domainUuid = pDomain.getUuid();
+  }
+}
+
+
+void PlannerCaches::clear()
+{
+  _domainUuid.clear();
+  _areMinMaxValuesOfDomainComputed = false;
+  _minMaxValuesOfDomain.clear();
+  _statesWithFailedGoals.clear();
+  _transpositionTable.clear();
+  _minMaxValuesOfTranspositionTable.clear();
+  _planCache.clear();
+  _forwardSearchGrounding.clear();
+  _actionGroundingsPtr.reset();
+}
+
+
+std::list<PlannerCaches::StateWithFailedGoals>::iterator PlannerCaches::_findState(const Problem& pProblem,
+                                                                                   std::uint64_t pStateHash)
+{
+  const auto& facts = pProblem.worldState.factsMapping();
+  for (auto itState = _statesWithFailedGoals.begin(); itState != _statesWithFailedGoals.end(); ++itState)
+  {
+    // The hashes differ for most of the states that have different facts or a different context,
+    // so the facts and the objects are compared only for the state that is very likely the same
+    if (itState->hash != pStateHash)
+      continue;
+    _deltaBuffer.clear();
+    facts.deltaFrom(_deltaBuffer, itState->facts);
+    if (!_deltaBuffer.empty())
+      continue;
+    auto objectsDelta = pProblem.objects.deltaFrom(itState->objects);
+    if (!objectsDelta.addedEntities.empty() || !objectsDelta.removedEntities.empty())
+      continue;
+    if (itState != _statesWithFailedGoals.begin())
+      _statesWithFailedGoals.splice(_statesWithFailedGoals.begin(), _statesWithFailedGoals, itState);
+    return itState;
+  }
+  return _statesWithFailedGoals.end();
+}
+
+
+} // End of namespace ogp
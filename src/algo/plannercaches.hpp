@@ -0,0 +1,127 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_PLANNERCACHES_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_PLANNERCACHES_HPP
+
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <orderedgoalsplanner/types/setofentities.hpp>
+#include <orderedgoalsplanner/types/setoffacts.hpp>
+#include <orderedgoalsplanner/util/extactminmaxvalueforfacts.hpp>
+#include "actiongroundings.hpp"
+#include "forwardsearch.hpp"
+#include "plancache.hpp"
+#include "threadpool.hpp"
+#include "transpositiontable.hpp"
+
+namespace ogp
+{
+struct Domain;
+struct Goal;
+struct Historical;
+struct Problem;
+
+
+/**
+ * Caches of the planner that are kept between the calls of a planner session.<br/>
+ * Everything is cleared when the domain changes.<br/>
+ * The goals that failed are memorized per world state, a world state being identified by its facts, its objects,
+ * its goal stack with the effect between the goals and the actions already done.<br/>
+ * The costs of the rollouts are memorized in a transposition table.<br/>
+ * The plans returned by the planner can be memorized in a plan cache, it is disabled by default.<br/>
+ * The actions grounded for the forward search are kept while the objects do not change.<br/>
+ * The groundings of the actions filtered by the static facts are kept while the static facts do not change.<br/>
+ * The pool of threads that evaluates the candidate actions is also owned here, it is kept when the caches are cleared.
+ */
+struct PlannerCaches
+{
+  /**
+   * @brief Get the min and max values of the fluents for a problem.<br/>
+   * The part that comes from the domain is computed only once per domain.
+   */
+  std::map<std::string, MinMaxValues> minMaxValuesForFacts(const Problem& pProblem,
+                                                           const Domain& pDomain);
+
+  /// Check if the resolution of a goal already failed in the current state of the problem.
+  bool hasGoalFailed(const Goal& pGoal,
+                     bool pTryToDoMoreOptimalSolution,
+                     const Problem& pProblem,
+                     const Historical* pGlobalHistorical);
+
+  /// Memorize that the resolution of a goal failed in the current state of the problem.
+  void notifyGoalFailure(const Goal& pGoal,
+                         bool pTryToDoMoreOptimalSolution,
+                         const Problem& pProblem,
+                         const Historical* pGlobalHistorical);
+
+  /**
+   * @brief Get the transposition table that memorizes the costs of the rollouts.<br/>
+   * The table is cleared if the min and max values of the fluents are not the ones of the previous call.
+   */
+  TranspositionTable& transpositionTable(const std::map<std::string, MinMaxValues>& pMinMaxValuesForFacts);
+
+  const TranspositionTable& transpositionTable() const { return _transpositionTable; }
+
+  PlanCache& planCache() { return _planCache; }
+  const PlanCache& planCache() const { return _planCache; }
+
+  ForwardSearchGrounding& forwardSearchGrounding() { return _forwardSearchGrounding; }
+  const ForwardSearchGrounding& forwardSearchGrounding() const { return _forwardSearchGrounding; }
+
+  /**
+   * @brief Get the groundings of the actions filtered by the static facts, updated for the current state of a problem.<br/>
+   * The groundings already computed are reused if the static facts did not change since the previous call.
+   */
+  ActionGroundings& actionGroundings(const Problem& pProblem,
+                                     const Domain& pDomain);
+
+  /// Set the number of threads that evaluate the candidate actions, the calling thread included.
+  void setNbOfThreads(std::size_t pNbOfThreads);
+
+  /// Get the pool of threads that evaluates the candidate actions, nullptr to evaluate them sequentially.
+  ThreadPool* threadPoolPtr() { return _threadPoolPtr.get(); }
+
+  /// Clear the caches if the domain is not the one the caches were computed for.
+  void refreshIfNeeded(const Domain& pDomain);
+
+  void clear();
+
+  /// Number of world states for which the failures of goals are memorized.
+  static const std::size_t maxNbOfStatesWithFailedGoals;
+
+private:
+  struct StateWithFailedGoals
+  {
+    /// Hash of the facts combined with the hash of the context, compared before the facts and the objects.
+    std::uint64_t hash;
+    SetOfFacts facts;
+    SetOfEntities objects;
+    std::set<std::string> failedGoals;
+  };
+
+  std::string _domainUuid;
+  bool _areMinMaxValuesOfDomainComputed = false;
+  std::map<std::string, MinMaxValues> _minMaxValuesOfDomain;
+  /// Most recently used state first.
+  std::list<StateWithFailedGoals> _statesWithFailedGoals;
+  TranspositionTable _transpositionTable;
+  /// Min and max values of the fluents for which the transposition table is filled.
+  std::map<std::string, MinMaxValues> _minMaxValuesOfTranspositionTable;
+  PlanCache _planCache;
+  ForwardSearchGrounding _forwardSearchGrounding;
+  std::unique_ptr<ActionGroundings> _actionGroundingsPtr;
+  std::unique_ptr<ThreadPool> _threadPoolPtr;
+  /// Buffer to compute the deltas between the facts.
+  std::vector<SetOfFacts::DeltaEntry> _deltaBuffer;
+
+  std::list<StateWithFailedGoals>::iterator _findState(const Problem& pProblem,
+                                                      std::uint64_t pStateHash);
+};
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_PLANNERCACHES_HPP
@@ -0,0 +1,215 @@
+#include "relaxedreachability.hpp"
+#include <list>
+#include <orderedgoalsplanner/types/condition.hpp>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/goal.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/types/worldstatemodification.hpp>
+
+namespace ogp
+{
+namespace
+{
+
+/// Action or event seen as a transition between predicates.
+struct RelaxedTransition
+{
+  RelaxedTransition(const std::string& pId,
+                    bool pIsAnAction)
+    : id(pId),
+      isAnAction(pIsAnAction),
+      requiredPredicates(),
+      addedPredicates(),
+      isReached(false)
+  {
+  }
+
+  std::string id;
+  bool isAnAction;
+  std::set<std::string> requiredPredicates;
+  std::set<std::string> addedPredicates;
+  bool isReached;
+};
+
+
+bool _isAnAbsenceOfValue(const Fact& pFact)
+{
+  return pFact.isValueNegated() ||
+      (pFact.value() && *pFact.value() == Fact::getUndefinedEntity());
+}
+
+
+/**
+ * Only the facts under conjunctions are extracted.<br/>
+ * The disjunctions, the implications, the universal quantifications, the negations and the comparisons
+ * can be satisfied without a specific fact, so they do not require anything.
+ */
+void _extractRequiredPredicates(std::set<std::string>& pRes,
+                                const Condition& pCondition)
+{
+  const auto* nodePtr = pCondition.fcNodePtr();
+  if (nodePtr != nullptr)
+  {
+    if (nodePtr->nodeType == ConditionNodeType::AND)
+    {
+      if (nodePtr->leftOperand)
+        _extractRequiredPredicates(pRes, *nodePtr->leftOperand);
+      if (nodePtr->rightOperand)
+        _extractRequiredPredicates(pRes, *nodePtr->rightOperand);
+    }
+    return;
+  }
+
+  const auto* existsPtr = pCondition.fcExistsPtr();
+  if (existsPtr != nullptr)
+  {
+    if (existsPtr->condition)
+      _extractRequiredPredicates(pRes, *existsPtr->condition);
+    return;
+  }
+
+  const auto* factPtr = pCondition.fcFactPtr();
+  if (factPtr != nullptr)
+  {
+    const auto& factOptional = factPtr->factOptional;
+    // The punctual facts are not stored in the world state, so their presence cannot be tracked
+    if (!factOptional.isFactNegated && !factOptional.fact.isPunctual() && !_isAnAbsenceOfValue(factOptional.fact))
+      pRes.insert(factOptional.fact.name());
+  }
+}
+
+
+void _extractAddedPredicates(std::set<std::string>& pRes,
+                             const std::unique_ptr<WorldStateModification>& pWorldStateModificationPtr)
+{
+  if (!pWorldStateModificationPtr)
+    return;
+  pWorldStateModificationPtr->forAllThatCanBeModified([&](const FactOptionalAndValueModification& pFactOptional) {
+    if (!pFactOptional.factOpt.isFactNegated && !_isAnAbsenceOfValue(pFactOptional.factOpt.fact))
+      pRes.insert(pFactOptional.factOpt.fact.name());
+    return ContinueOrBreak::CONTINUE;
+  });
+}
+
+}
+
+
+RelaxedReachability::RelaxedReachability(const Problem& pProblem,
+                                         const Domain& pDomain)
+  : _reachablePredicates(),
+    _unreachableActions(),
+    _unreachableEvents()
+{
+  for (const auto& currFact : pProblem.worldState.facts())
+    _reachablePredicates.insert(currFact.first.name());
+  for (const auto& currFact : pDomain.getTimelessFacts().setOfFacts().facts())
+    _reachablePredicates.insert(currFact.first.name());
+  // The derived predicates are expanded in the preconditions of the actions, so they are only found in the goals
+  for (const auto& currDerivedPredicate : pDomain.getOntology().derivedPredicates.nameToDerivedPredicate())
+    _reachablePredicates.insert(currDerivedPredicate.first);
+  _extractAddedPredicates(_reachablePredicates, pProblem.goalStack.effectBetweenGoals);
+
+  std::list<RelaxedTransition> transitions;
+  for (const auto& currAction : pDomain.actions())
+  {
+    const Action& action = currAction.second;
+    if (!action.canThisActionBeUsedByThePlanner)
+      continue;
+    auto& transition = transitions.emplace_back(currAction.first, true);
+    if (action.precondition)
+      _extractRequiredPredicates(transition.requiredPredicates, *action.precondition);
+    _extractAddedPredicates(transition.addedPredicates, action.effect.worldStateModification);
+    _extractAddedPredicates(transition.addedPredicates, action.effect.worldStateModificationAtStart);
+    _extractAddedPredicates(transition.addedPredicates, action.effect.potentialWorldStateModification);
+  }
+  for (const auto& currSetOfEvents : pDomain.getSetOfEvents())
+  {
+    for (const auto& currEvent : currSetOfEvents.second.events())
+    {
+      const Event& event = currEvent.second;
+      auto& transition = transitions.emplace_back(generateFullEventId(currSetOfEvents.first, currEvent.first), false);
+      if (event.precondition)
+        _extractRequiredPredicates(transition.requiredPredicates, *event.precondition);
+      _extractAddedPredicates(transition.addedPredicates, event.factsToModify);
+    }
+  }
+
+  // Fixpoint: the reachable predicates only grow, so each transition is reached at most once
+  bool somethingChanged = true;
+  while (somethingChanged)
+  {
+    somethingChanged = false;
+    for (auto& currTransition : transitions)
+    {
+      if (currTransition.isReached)
+        continue;
+      bool areRequiredPredicatesReachable = true;
+      for (const auto& currPredicate : currTransition.requiredPredicates)
+      {
+        if (_reachablePredicates.count(currPredicate) == 0)
+        {
+          areRequiredPredicatesReachable = false;
+          break;
+        }
+      }
+      if (!areRequiredPredicatesReachable)
+        continue;
+      currTransition.isReached = true;
+      for (const auto& currPredicate : currTransition.addedPredicates)
+        if (_reachablePredicates.insert(currPredicate).second)
+          somethingChanged = true;
+    }
+  }
+
+  for (const auto& currTransition : transitions)
+  {
+    if (currTransition.isReached)
+      continue;
+    if (currTransition.isAnAction)
+      _unreachableActions.insert(currTransition.id);
+    else
+      _unreachableEvents.insert(currTransition.id);
+  }
+}
+
+
+bool RelaxedReachability::canGoalBeReached(const Goal& pGoal) const
+{
+  return _areRequiredPredicatesReachable(&pGoal.objective());
+}
+
+
+std::set<ActionId> RelaxedReachability::filterActions(const std::set<ActionId>& pActionIds) const
+{
+  std::set<ActionId> res;
+  for (const auto& currActionId : pActionIds)
+    if (isActionReachable(currActionId))
+      res.insert(res.end(), currActionId);
+  return res;
+}
+
+
+std::set<FullEventId> RelaxedReachability::filterEvents(const std::set<FullEventId>& pFullEventIds) const
+{
+  std::set<FullEventId> res;
+  for (const auto& currFullEventId : pFullEventIds)
+    if (isEventReachable(currFullEventId))
+      res.insert(res.end(), currFullEventId);
+  return res;
+}
+
+
+bool RelaxedReachability::_areRequiredPredicatesReachable(const Condition* pConditionPtr) const
+{
+  if (pConditionPtr == nullptr)
+    return true;
+  std::set<std::string> requiredPredicates;
+  _extractRequiredPredicates(requiredPredicates, *pConditionPtr);
+  for (const auto& currPredicate : requiredPredicates)
+    if (_reachablePredicates.count(currPredicate) == 0)
+      return false;
+  return true;
+}
+
+
+} // End of namespace ogp
@@ -0,0 +1,61 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_RELAXEDREACHABILITY_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_RELAXEDREACHABILITY_HPP
+
+#include <set>
+#include <string>
+#include <orderedgoalsplanner/util/alias.hpp>
+
+namespace ogp
+{
+struct Condition;
+struct Domain;
+struct Goal;
+struct Problem;
+
+
+/**
+ * Reachability of the actions, of the events and of the goals in the delete relaxation of a problem.<br/>
+ * The relaxation is done at the level of the predicates: a predicate is reachable if a fact of it is in the world state,
+ * or if a reachable action or event can add a fact of it. An action or an event is reachable if all the predicates
+ * that its precondition requires are reachable.<br/>
+ * Only the facts that are mandatory and not negated are considered as required, so the analysis over-approximates
+ * what can happen: what is not reachable here can never happen from this world state, whatever the actions done.
+ */
+struct RelaxedReachability
+{
+  /**
+   * @brief Compute the reachability from the current state of a problem.
+   * @param[in] pProblem Problem to analyse.
+   * @param[in] pDomain Domain of the problem.
+   */
+  RelaxedReachability(const Problem& pProblem,
+                      const Domain& pDomain);
+
+  /// True if all the actions and all the events of the domain are reachable.
+  bool isEverythingReachable() const { return _unreachableActions.empty() && _unreachableEvents.empty(); }
+
+  bool isActionReachable(const ActionId& pActionId) const { return _unreachableActions.count(pActionId) == 0; }
+  bool isEventReachable(const FullEventId& pFullEventId) const { return _unreachableEvents.count(pFullEventId) == 0; }
+
+  /// True if all the predicates required by the objective of the goal are reachable.
+  bool canGoalBeReached(const Goal& pGoal) const;
+
+  /// Keep only the reachable actions of a set of actions.
+  std::set<ActionId> filterActions(const std::set<ActionId>& pActionIds) const;
+  /// Keep only the reachable events of a set of events.
+  std::set<FullEventId> filterEvents(const std::set<FullEventId>& pFullEventIds) const;
+
+private:
+  /// Predicates that are reachable, or whose reachability is not tracked.
+  std::set<std::string> _reachablePredicates;
+  std::set<ActionId> _unreachableActions;
+  std::set<FullEventId> _unreachableEvents;
+
+  bool _areRequiredPredicatesReachable(const Condition* pConditionPtr) const;
+};
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_RELAXEDREACHABILITY_HPP
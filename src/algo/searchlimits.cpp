@@ -0,0 +1,47 @@
+#include "searchlimits.hpp"
+
+namespace ogp
+{
+
+
+SearchLimits::SearchLimits(const PlanningBudget& pBudget)
+  : _budget(pBudget),
+    _nbOfExpansions(0),
+    _isTruncated(false),
+    _isCancelled(false)
+{
+}
+
+
+bool SearchLimits::isExhausted()
+{
+  if (!_isTruncated)
+  {
+    if (isCancelled())
+      _isTruncated = true;
+    else if (_budget.maxNbOfExpansions && _nbOfExpansions >= *_budget.maxNbOfExpansions)
+      _isTruncated = true;
+    else if (_budget.deadline && std::chrono::steady_clock::now() >= *_budget.deadline)
+      _isTruncated = true;
+  }
+  return _isTruncated;
+}
+
+
+bool SearchLimits::isCancelled()
+{
+  if (!_isCancelled && _budget.cancellationToken.isCancelled())
+    _isCancelled = true;
+  return _isCancelled;
+}
+
+
+PlanningStatus SearchLimits::status() const
+{
+  if (_isCancelled)
+    return PlanningStatus::CANCELLED;
+  return _isTruncated ? PlanningStatus::TRUNCATED : PlanningStatus::COMPLETED;
+}
+
+
+} // End of namespace ogp
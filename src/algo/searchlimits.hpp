@@ -0,0 +1,46 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_SEARCHLIMITS_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_SEARCHLIMITS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <orderedgoalsplanner/types/planningbudget.hpp>
+
+namespace ogp
+{
+
+
+/**
+ * Limits of a search, polled by the planner at its decision points.<br/>
+ * Once the limits are exhausted, the rollouts and the main descent are aborted and no other goal is tried.
+ * The goals that were not planned are kept, they are not considered as failed.<br/>
+ * Once cancelled, every part of the search is aborted.<br/>
+ * It can be shared by the threads that evaluate the candidate actions.
+ */
+struct SearchLimits
+{
+  SearchLimits(const PlanningBudget& pBudget);
+
+  void notifyExpansion() { ++_nbOfExpansions; }
+
+  /// Check if the limits are exhausted. A positive answer means that the search is truncated.
+  bool isExhausted();
+
+  /// Check if the search is cancelled.
+  bool isCancelled();
+
+  const CancellationToken& cancellationToken() const { return _budget.cancellationToken; }
+
+  PlanningStatus status() const;
+
+private:
+  const PlanningBudget& _budget;
+  std::atomic<std::size_t> _nbOfExpansions;
+  std::atomic<bool> _isTruncated;
+  std::atomic<bool> _isCancelled;
+};
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_SEARCHLIMITS_HPP
@@ -0,0 +1,129 @@
+#include "threadpool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace ogp
+{
+namespace
+{
+
+struct ParallelForState
+{
+  ParallelForState(std::size_t pNbOfTasks,
+                   const std::function<void(std::size_t)>& pTask)
+    : nbOfTasks(pNbOfTasks),
+      task(pTask),
+      nextTask(0),
+      nbOfTasksDone(0),
+      exception()
+  {
+  }
+
+  /// Run the tasks not already taken by another thread.
+  void runTasks()
+  {
+    for (std::size_t i = nextTask++; i < nbOfTasks; i = nextTask++)
+    {
+      try
+      {
+        task(i);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!exception)
+          exception = std::current_exception();
+      }
+      if (++nbOfTasksDone == nbOfTasks)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        allTasksDone.notify_all();
+      }
+    }
+  }
+
+  const std::size_t nbOfTasks;
+  const std::function<void(std::size_t)>& task;
+  std::atomic<std::size_t> nextTask;
+  std::atomic<std::size_t> nbOfTasksDone;
+  std::exception_ptr exception;
+  std::mutex mutex;
+  std::condition_variable allTasksDone;
+};
+
+}
+
+
+ThreadPool::ThreadPool(std::size_t pNbOfWorkers)
+  : _workers(),
+    _jobs(),
+    _mutex(),
+    _jobAvailable(),
+    _isStopping(false)
+{
+  _workers.reserve(pNbOfWorkers);
+  for (std::size_t i = 0; i < pNbOfWorkers; ++i)
+    _workers.emplace_back([this] { _runWorker(); });
+}
+
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _isStopping = true;
+  }
+  _jobAvailable.notify_all();
+  for (auto& currWorker : _workers)
+    currWorker.join();
+}
+
+
+void ThreadPool::parallelFor(std::size_t pNbOfTasks,
+                             const std::function<void(std::size_t)>& pTask)
+{
+  if (pNbOfTasks == 0)
+    return;
+  auto state = std::make_shared<ParallelForState>(pNbOfTasks, pTask);
+  auto nbOfHelpers = std::min(pNbOfTasks - 1, _workers.size());
+  if (nbOfHelpers > 0)
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      for (std::size_t i = 0; i < nbOfHelpers; ++i)
+        _jobs.emplace_back([state] { state->runTasks(); });
+    }
+    _jobAvailable.notify_all();
+  }
+
+  state->runTasks();
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->allTasksDone.wait(lock, [&] { return state->nbOfTasksDone == pNbOfTasks; });
+  }
+  if (state->exception)
+    std::rethrow_exception(state->exception);
+}
+
+
+void ThreadPool::_runWorker()
+{
+  while (true)
+  {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _jobAvailable.wait(lock, [this] { return _isStopping || !_jobs.empty(); });
+      if (_jobs.empty())
+        return;
+      job = std::move(_jobs.front());
+      _jobs.pop_front();
+    }
+    job();
+  }
+}
+
+
+} // End of namespace ogp
@@ -0,0 +1,54 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_THREADPOOL_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_THREADPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ogp
+{
+
+
+/**
+ * Pool of threads to run independent tasks.<br/>
+ * The tasks of a parallelFor are taken one by one by the first available thread, the calling thread included,
+ * so a slow task does not delay the other tasks and the nested or concurrent calls cannot deadlock.
+ */
+struct ThreadPool
+{
+  /// Construct a pool with pNbOfWorkers threads in addition of the calling thread.
+  ThreadPool(std::size_t pNbOfWorkers);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  std::size_t nbOfWorkers() const { return _workers.size(); }
+
+  /**
+   * @brief Call pTask for each index from 0 to pNbOfTasks - 1 and wait for the end of all the calls.
+   * @param[in] pNbOfTasks Number of tasks.
+   * @param[in] pTask Task to call with the index. The first exception thrown is rethrown in the calling thread.
+   */
+  void parallelFor(std::size_t pNbOfTasks,
+                   const std::function<void(std::size_t)>& pTask);
+
+private:
+  std::vector<std::thread> _workers;
+  std::deque<std::function<void()>> _jobs;
+  std::mutex _mutex;
+  std::condition_variable _jobAvailable;
+  bool _isStopping;
+
+  void _runWorker();
+};
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_THREADPOOL_HPP
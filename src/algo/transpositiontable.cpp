@@ -0,0 +1,69 @@
+#include "transpositiontable.hpp"
+#include <orderedgoalsplanner/types/goal.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include "../util/hash.hpp"
+
+namespace ogp
+{
+
+const std::size_t TranspositionTable::defaultMaxNbOfEntries = 4096;
+
+
+TranspositionTable::TranspositionTable(std::size_t pMaxNbOfEntries)
+  : _cache(pMaxNbOfEntries)
+{
+}
+
+
+TranspositionTable::Key TranspositionTable::computeKey(const Problem& pProblem,
+                                                       const Action* pPreviousActionPtr,
+                                                       const Goal& pGoal)
+{
+  // The objects are not hashed, they rarely change during a search and they are compared on a hit
+  Key res{pProblem.worldState.hash(), pProblem.goalStack.hash(), pProblem.historical.hash()};
+  combineHash(res.contextFingerprint, reinterpret_cast<std::uintptr_t>(pPreviousActionPtr));
+  combineHash(res.contextFingerprint, hashStr(pGoal.toPddl(0)));
+  return res;
+}
+
+
+std::optional<PlanCost> TranspositionTable::find(const Key& pKey,
+                                                 const Problem& pProblem,
+                                                 const std::string& pPreviousActionId,
+                                                 const Goal& pGoal)
+{
+  const auto context = contextToStr(pPreviousActionId, pGoal);
+  auto entryOpt = _cache.find(pKey, [&](const Entry& pEntry) {
+    return pEntry.state.isStateOf(pProblem, context);
+  });
+  if (entryOpt)
+    return entryOpt->planCost;
+  return {};
+}
+
+
+void TranspositionTable::insert(const Key& pKey,
+                                CachedProblemState pState,
+                                const PlanCost& pPlanCost)
+{
+  _cache.insert(pKey, Entry{pPlanCost, std::move(pState)});
+}
+
+
+std::string TranspositionTable::contextToStr(const std::string& pPreviousActionId,
+                                              const Goal& pGoal)
+{
+  return pPreviousActionId + "\n" + pGoal.toPddl(0);
+}
+
+
+std::size_t TranspositionTable::KeyHasher::operator()(const Key& pKey) const
+{
+  auto res = pKey.worldStateHash;
+  combineHash(res, pKey.goalStackHash);
+  combineHash(res, pKey.contextFingerprint);
+  return static_cast<std::size_t>(res);
+}
+
+
+} // End of namespace ogp
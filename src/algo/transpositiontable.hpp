@@ -0,0 +1,121 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_ALGO_TRANSPOSITIONTABLE_HPP
+#define ORDEREDGOALSPLANNER_SRC_ALGO_TRANSPOSITIONTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include "cachedproblemstate.hpp"
+#include "lrucache.hpp"
+#include "plancost.hpp"
+
+namespace ogp
+{
+struct Action;
+struct Domain;
+struct Goal;
+struct Problem;
+
+
+/**
+ * Memoization of the costs of the rollouts that compare the candidate actions.<br/>
+ * A rollout is identified by the state of the problem it starts from and by the action done just before it,
+ * so the candidate actions that lead to the same state share the same rollout.<br/>
+ * The entries are searched by hashes and the state is compared on a hit, so a collision is a miss.<br/>
+ * The number of entries is bounded, the least recently used entry is evicted first.<br/>
+ * The costs are only valid for one domain and for one set of min and max values of the fluents,
+ * so the table has to be cleared when one of them changes.<br/>
+ * All the functions are thread-safe.
+ */
+struct TranspositionTable
+{
+  /// Identifier of the start of a rollout.
+  struct Key
+  {
+    /// Hash of the facts of the world state.
+    std::uint64_t worldStateHash;
+    /// Hash of the goals to satisfy.
+    std::uint64_t goalStackHash;
+    /// Fingerprint of the historical, of the action done before the rollout and of its goal.
+    std::uint64_t contextFingerprint;
+
+    bool operator==(const Key& pOther) const
+    {
+      return worldStateHash == pOther.worldStateHash && goalStackHash == pOther.goalStackHash &&
+          contextFingerprint == pOther.contextFingerprint;
+    }
+  };
+
+  TranspositionTable(std::size_t pMaxNbOfEntries = defaultMaxNbOfEntries);
+
+  /**
+   * @brief Compute the key of a rollout.
+   * @param[in] pProblem Problem at the start of the rollout.
+   * @param[in] pDomain Domain of the problem.
+   * @param[in] pPreviousActionPtr Action done just before the rollout.
+   * @param[in] pGoal Goal for which the previous action was done.
+   * @return The key of the rollout.
+   */
+  static Key computeKey(const Problem& pProblem,
+                        const Action* pPreviousActionPtr,
+                        const Goal& pGoal);
+
+  /**
+   * @brief Get the cost memorized for a rollout and count a hit or a miss.
+   * @param[in] pKey Key of the rollout.
+   * @param[in] pProblem Problem at the start of the rollout.
+   * @param[in] pPreviousActionId Identifier of the action done just before the rollout.
+   * @param[in] pGoal Goal for which the previous action was done.
+   * @return The cost memorized if the entry of the key was computed for the same state.
+   */
+  std::optional<PlanCost> find(const Key& pKey,
+                               const Problem& pProblem,
+                               const std::string& pPreviousActionId,
+                               const Goal& pGoal);
+
+  /**
+   * @brief Memorize the cost of a rollout, the least recently used entry is evicted if the table is full.
+   * @param[in] pKey Key of the rollout.
+   * @param[in] pState State at the start of the rollout, with the context returned by contextToStr.
+   * @param[in] pPlanCost Cost of the rollout.
+   */
+  void insert(const Key& pKey,
+              CachedProblemState pState,
+              const PlanCost& pPlanCost);
+
+  /// Convert the action done just before a rollout and its goal to the context of a cached state.
+  static std::string contextToStr(const std::string& pPreviousActionId,
+                                  const Goal& pGoal);
+
+  /// Remove all the entries and reset the counters.
+  void clear() { _cache.clear(); }
+
+  std::size_t size() const { return _cache.size(); }
+  std::size_t nbOfHits() const { return _cache.nbOfHits(); }
+  std::size_t nbOfMisses() const { return _cache.nbOfMisses(); }
+  std::size_t maxNbOfEntries() const { return _cache.maxNbOfEntries(); }
+
+  /// Default maximum number of entries.
+  static const std::size_t defaultMaxNbOfEntries;
+
+private:
+  struct KeyHasher
+  {
+    std::size_t operator()(const Key& pKey) const;
+  };
+
+  /// Cost of a rollout with the state it was computed for.
+  struct Entry
+  {
+    PlanCost planCost;
+    CachedProblemState state;
+  };
+
+  LruCache<Key, Entry, KeyHasher> _cache;
+};
+
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_ALGO_TRANSPOSITIONTABLE_HPP
@@ -12,8 +12,16 @@
 #include "types/factsalreadychecked.hpp"
 #include "types/treeofalreadydonepaths.hpp"
 #include "algo/actiondataforparallelisation.hpp"
+#include "algo/actiongroundings.hpp"
 #include "algo/converttoparallelplan.hpp"
+#include "algo/forwardsearch.hpp"
+#include "algo/groundedstripsmodel.hpp"
 #include "algo/notifyactiondone.hpp"
+#include "algo/plannercaches.hpp"
+#include "algo/relaxedreachability.hpp"
+#include "algo/searchlimits.hpp"
+#include "algo/threadpool.hpp"
+#include "algo/transpositiontable.hpp"
 
 namespace ogp
 {
@@ -69,28 +77,6 @@ PossibleEffect _merge(PossibleEffect pEff1,
   return PossibleEffect::NOT_SATISFIED;
 }
 
-struct PlanCost
-{
-  bool success = true;
-  std::size_t nbOfGoalsNotSatisfied = 0;
-  std::size_t nbOfGoalsSatisfied = 0;
-  Number totalCost = 0;
-  Number costForFirstGoal = 0;
-
-  bool isBetterThan(const PlanCost& pOther) const
-  {
-    if (success != pOther.success)
-      return success;
-    if (nbOfGoalsNotSatisfied != pOther.nbOfGoalsNotSatisfied)
-      return nbOfGoalsNotSatisfied > pOther.nbOfGoalsNotSatisfied;
-    if (nbOfGoalsSatisfied != pOther.nbOfGoalsSatisfied)
-      return nbOfGoalsSatisfied > pOther.nbOfGoalsSatisfied;
-    if (costForFirstGoal != pOther.costForFirstGoal)
-      return costForFirstGoal < pOther.costForFirstGoal;
-    return totalCost < pOther.totalCost;
-  }
-};
-
 struct PotentialNextActionComparisonCache
 {
   PlanCost currentCost;
@@ -166,7 +152,8 @@ struct PotentialNextAction
   ParameterValuesWithConstraints parameters;
 
   std::list<ActionInvocationWithPtr> toActionInvocations(const SetOfEntities& pConstants,
-                                                         const SetOfEntities& pObjects);
+                                                         const SetOfEntities& pObjects,
+                                                         const ActionGroundings::Groundings* pGroundingsPtr = nullptr);
 };
 
 
@@ -215,26 +202,30 @@ std::list<ActionInvocationWithGoal> _planForMoreImportantGoalPossible(Problem& p
                                                                       const Historical* pGlobalHistorical,
                                                                       LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr,
                                                                       const ActionPtrWithGoal* pPreviousActionPtr,
-                                                                      std::size_t pNbOfPotentialRetries);
+                                                                      std::size_t pNbOfPotentialRetries,
+                                                                      PlannerCaches* pCachesPtr = nullptr,
+                                                                      SearchLimits* pSearchLimitsPtr = nullptr,
+                                                                      TranspositionTable* pTranspositionTablePtr = nullptr,
+                                                                      bool pIsARollout = false);
 
 void _getPreferInContextStatistics(std::size_t& nbOfPreconditionsSatisfied,
                                    std::size_t& nbOfPreconditionsNotSatisfied,
                                    const Action& pAction,
-                                   const std::map<Fact, bool>& pFacts)
+                                   const SetOfFacts& pFacts)
 {
   auto onFact = [&](const FactOptionalAndValueModification& pFactOptional,
                     bool) -> ContinueOrBreak
   {
     if (pFactOptional.factOpt.isFactNegated)
     {
-      if (pFacts.count(pFactOptional.factOpt.fact) == 0)
+      if (!pFacts.contains(pFactOptional.factOpt.fact))
         ++nbOfPreconditionsSatisfied;
       else
         ++nbOfPreconditionsNotSatisfied;
     }
     else
     {
-      if (pFacts.count(pFactOptional.factOpt.fact) > 0)
+      if (pFacts.contains(pFactOptional.factOpt.fact))
         ++nbOfPreconditionsSatisfied;
       else
         ++nbOfPreconditionsNotSatisfied;
@@ -248,7 +239,8 @@ void _getPreferInContextStatistics(std::size_t& nbOfPreconditionsSatisfied,
 
 
 std::list<ActionInvocationWithPtr> PotentialNextAction::toActionInvocations(const SetOfEntities& pConstants,
-                                                                            const SetOfEntities& pObjects)
+                                                                            const SetOfEntities& pObjects,
+                                                                            const ActionGroundings::Groundings* pGroundingsPtr)
 {
   std::list<ActionInvocationWithPtr> res;
   if (parameters.empty())
@@ -282,11 +274,33 @@ std::list<ActionInvocationWithPtr> PotentialNextAction::toActionInvocations(cons
     }
   }
 
+  if (pGroundingsPtr != nullptr)
+  {
+    // Remove the values that are in no grounding, so that the cartesian product is done on less values
+    for (std::size_t i = 0; i < pGroundingsPtr->parameters.size(); ++i)
+    {
+      auto itParam = parameters.find(pGroundingsPtr->parameters[i]);
+      if (itParam == parameters.end() || itParam->second.empty())
+        continue;
+      const auto& possibleValues = pGroundingsPtr->possibleValues[i];
+      for (auto itEntity = itParam->second.begin(); itEntity != itParam->second.end(); )
+      {
+        if (possibleValues.count(itEntity->first.value) == 0)
+          itEntity = itParam->second.erase(itEntity);
+        else
+          ++itEntity;
+      }
+      if (itParam->second.empty())
+        return res;
+    }
+  }
+
   std::list<std::map<Parameter, Entity>> parameterPossibilities;
   unfoldMapWithSet(parameterPossibilities, parameters);
 
   for (auto& currParams : parameterPossibilities)
-    res.emplace_back(ActionInvocation(actionId, std::move(currParams)), actionPtr);
+    if (pGroundingsPtr == nullptr || pGroundingsPtr->contains(currParams))
+      res.emplace_back(ActionInvocation(actionId, std::move(currParams)), actionPtr);
   return res;
 }
 
@@ -325,10 +339,10 @@ bool ActionInvocationWithPtr::isMoreImportantThan(const ActionInvocationWithPtr&
   // Compare according to prefer in context
   std::size_t nbOfPreferInContextSatisfied = 0;
   std::size_t nbOfPreferInContextNotSatisfied = 0;
-  _getPreferInContextStatistics(nbOfPreferInContextSatisfied, nbOfPreferInContextNotSatisfied, action, pProblem.worldState.facts());
+  _getPreferInContextStatistics(nbOfPreferInContextSatisfied, nbOfPreferInContextNotSatisfied, action, pProblem.worldState.factsMapping());
   std::size_t otherNbOfPreconditionsSatisfied = 0;
   std::size_t otherNbOfPreconditionsNotSatisfied = 0;
-  _getPreferInContextStatistics(otherNbOfPreconditionsSatisfied, otherNbOfPreconditionsNotSatisfied, otherAction, pProblem.worldState.facts());
+  _getPreferInContextStatistics(otherNbOfPreconditionsSatisfied, otherNbOfPreconditionsNotSatisfied, otherAction, pProblem.worldState.factsMapping());
   if (nbOfPreferInContextSatisfied != otherNbOfPreconditionsSatisfied)
     return nbOfPreferInContextSatisfied > otherNbOfPreconditionsSatisfied;
   if (nbOfPreferInContextNotSatisfied != otherNbOfPreconditionsNotSatisfied)
@@ -810,7 +824,8 @@ PlanCost _extractPlanCost(
     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
     Historical* pGlobalHistorical,
     LookForAnActionOutputInfos& pLookForAnActionOutputInfos,
-    const ActionPtrWithGoal& pPreviousAction)
+    const ActionPtrWithGoal& pPreviousAction,
+    SearchLimits* pSearchLimitsPtr)
 {
   PlanCost res;
   if (pPreviousAction.actionPtr != nullptr)
@@ -823,7 +838,7 @@ PlanCost _extractPlanCost(
   bool shouldBreak = false;
   while (!pProblem.goalStack.goals().empty())
   {
-    if (shouldBreak)
+    if (shouldBreak || (pSearchLimitsPtr != nullptr && pSearchLimitsPtr->isCancelled()))
     {
       res.success = false;
       break;
@@ -832,7 +847,8 @@ PlanCost _extractPlanCost(
     const SetOfCallbacks callbacks;
     auto subPlan = _planForMoreImportantGoalPossible(pProblem, pDomain, callbacks, false,
                                                      pMinMaxValuesForFacts, pNow, pGlobalHistorical,
-                                                     &pLookForAnActionOutputInfos, &pPreviousAction, 10);
+                                                     &pLookForAnActionOutputInfos, &pPreviousAction, 10,
+                                                     nullptr, pSearchLimitsPtr, nullptr, true);
     if (subPlan.empty())
       break;
     const auto& actions = pDomain.getActions();
@@ -866,63 +882,109 @@ PlanCost _extractPlanCost(
 }
 
 
+PlanCost _extractPlanCostAfterAction(
+    Problem& pProblem,
+    const Domain& pDomain,
+    const std::map<std::string, MinMaxValues>& pMinMaxValuesForFacts,
+    const ActionInvocationWithPtr& pAction,
+    const Goal& pCurrentGoal,
+    SearchLimits* pSearchLimitsPtr,
+    TranspositionTable* pTranspositionTablePtr)
+{
+  ActionInvocationWithGoal oneStepOfPlannerResult(pAction.actionInvocation.actionId, pAction.actionInvocation.parameters, {}, 0);
+  std::unique_ptr<std::chrono::steady_clock::time_point> now;
+  auto checkpoint = pProblem.checkpoint();
+  bool goalChanged = false;
+  LookForAnActionOutputInfos lookForAnActionOutputInfos;
+  updateProblemForNextPotentialPlannerResult(pProblem, goalChanged, oneStepOfPlannerResult, pDomain, now, nullptr, &lookForAnActionOutputInfos);
+  ActionPtrWithGoal actionPtrWithGoal(pAction.actionPtr, pCurrentGoal);
+
+  // The rollout only depends on the state reached if the action did not already satisfy or fail a goal
+  std::optional<TranspositionTable::Key> keyOpt;
+  if (pTranspositionTablePtr != nullptr && !lookForAnActionOutputInfos.hasAGoalBeenNotified())
+  {
+    keyOpt = TranspositionTable::computeKey(pProblem, pAction.actionPtr, pCurrentGoal);
+    auto planCostOpt = pTranspositionTablePtr->find(*keyOpt, pProblem, pAction.actionInvocation.actionId, pCurrentGoal);
+    if (planCostOpt)
+    {
+      pProblem.rollbackTo(checkpoint);
+      return *planCostOpt;
+    }
+  }
+
+  // The state is memorized before the rollout modifies the problem
+  std::optional<CachedProblemState> stateOpt;
+  if (keyOpt)
+    stateOpt.emplace(pProblem, TranspositionTable::contextToStr(pAction.actionInvocation.actionId, pCurrentGoal));
+  auto res = _extractPlanCost(pProblem, pDomain, pMinMaxValuesForFacts, now, nullptr,
+                              lookForAnActionOutputInfos, actionPtrWithGoal, pSearchLimitsPtr);
+  pProblem.rollbackTo(checkpoint);
+  // The costs of aborted rollouts are not memorized
+  if (keyOpt && (pSearchLimitsPtr == nullptr || !pSearchLimitsPtr->isExhausted()))
+    pTranspositionTablePtr->insert(*keyOpt, std::move(*stateOpt), res);
+  return res;
+}
+
+
+/// Check if the choice between two candidate actions can be done by comparing the costs of their rollouts.
+bool _areCostsToCompare(const ActionInvocationWithPtr& pAction1,
+                        const ActionInvocationWithPtr& pAction2)
+{
+  return pAction1.actionPtr != nullptr &&
+      pAction2.actionPtr != nullptr &&
+      (pAction1.actionPtr->effect != pAction2.actionPtr->effect ||
+       pAction1.actionInvocation.parameters != pAction2.actionInvocation.parameters);
+}
+
+
 bool _isMoreOptimalNextAction(
     std::optional<PotentialNextActionComparisonCache>& pPotentialNextActionComparisonCacheOpt,
     bool& pNextInPlanCanBeAnEvent,
     const ActionInvocationWithPtr& pNewPotentialNextAction,
     const std::optional<ActionInvocationWithPtr>& pCurrentNextAction,
-    const Problem& pProblem,
+    Problem& pProblem,
     const Domain& pDomain,
     const std::map<std::string, MinMaxValues>& pMinMaxValuesForFacts,
     const DataRelatedToOptimisation& pDataRelatedToOptimisation,
     std::size_t pLength,
     const Goal& pCurrentGoal,
-    const Historical* pGlobalHistorical)
+    const Historical* pGlobalHistorical,
+    SearchLimits* pSearchLimitsPtr,
+    TranspositionTable* pTranspositionTablePtr,
+    const std::map<std::string, PlanCost>& pPrecomputedPlanCosts)
 {
   if (pDataRelatedToOptimisation.tryToDoMoreOptimalSolution &&
       pLength == 0 &&
       pCurrentNextAction &&
-      pCurrentNextAction->actionPtr != nullptr &&
-      pNewPotentialNextAction.actionPtr != nullptr &&
-      (pNewPotentialNextAction.actionPtr->effect != pCurrentNextAction->actionPtr->effect ||
-       pNewPotentialNextAction.actionInvocation.parameters != pCurrentNextAction->actionInvocation.parameters))
+      _areCostsToCompare(pNewPotentialNextAction, *pCurrentNextAction) &&
+      (pSearchLimitsPtr == nullptr || !pSearchLimitsPtr->isExhausted()))
   {
     auto& currentNextAction = *pCurrentNextAction;
-    ActionInvocationWithGoal oneStepOfPlannerResult1(pNewPotentialNextAction.actionInvocation.actionId, pNewPotentialNextAction.actionInvocation.parameters, {}, 0);
-    ActionInvocationWithGoal oneStepOfPlannerResult2(currentNextAction.actionInvocation.actionId, currentNextAction.actionInvocation.parameters, {}, 0);
-    std::unique_ptr<std::chrono::steady_clock::time_point> now;
-
-    PlanCost newCost;
-    {
-      auto localProblem1 = pProblem;
-      bool goalChanged = false;
-      LookForAnActionOutputInfos lookForAnActionOutputInfos;
-      updateProblemForNextPotentialPlannerResult(localProblem1, goalChanged, oneStepOfPlannerResult1, pDomain, now, nullptr, &lookForAnActionOutputInfos);
-      ActionPtrWithGoal actionPtrWithGoal(pNewPotentialNextAction.actionPtr, pCurrentGoal);
-      newCost = _extractPlanCost(localProblem1, pDomain, pMinMaxValuesForFacts, now, nullptr,
-                                 lookForAnActionOutputInfos, actionPtrWithGoal);
-    }
+    auto planCostOf = [&](const ActionInvocationWithPtr& pAction) {
+      auto itPlanCost = pPrecomputedPlanCosts.find(pAction.actionInvocation.toStr());
+      if (itPlanCost != pPrecomputedPlanCosts.end())
+        return itPlanCost->second;
+      return _extractPlanCostAfterAction(pProblem, pDomain, pMinMaxValuesForFacts, pAction, pCurrentGoal,
+                                         pSearchLimitsPtr, pTranspositionTablePtr);
+    };
 
+    PlanCost newCost = planCostOf(pNewPotentialNextAction);
     if (!pPotentialNextActionComparisonCacheOpt)
     {
-      auto localProblem2 = pProblem;
-      bool goalChanged = false;
-      LookForAnActionOutputInfos lookForAnActionOutputInfos;
-      updateProblemForNextPotentialPlannerResult(localProblem2, goalChanged, oneStepOfPlannerResult2, pDomain, now, nullptr, &lookForAnActionOutputInfos);
       pPotentialNextActionComparisonCacheOpt = PotentialNextActionComparisonCache();
-      ActionPtrWithGoal actionPtrWithGoal(currentNextAction.actionPtr, pCurrentGoal);
-      pPotentialNextActionComparisonCacheOpt->currentCost = _extractPlanCost(localProblem2, pDomain, pMinMaxValuesForFacts, now, nullptr,
-                                                                             lookForAnActionOutputInfos, actionPtrWithGoal);
+      pPotentialNextActionComparisonCacheOpt->currentCost = planCostOf(currentNextAction);
     }
 
-    if (newCost.isBetterThan(pPotentialNextActionComparisonCacheOpt->currentCost))
+    // The costs of aborted rollouts are not comparable
+    bool areCostsComparable = pSearchLimitsPtr == nullptr || !pSearchLimitsPtr->isExhausted();
+    if (areCostsComparable && newCost.isBetterThan(pPotentialNextActionComparisonCacheOpt->currentCost))
     {
       pPotentialNextActionComparisonCacheOpt->currentCost = newCost;
       pPotentialNextActionComparisonCacheOpt->effectsWithWorseCosts.push_back(&currentNextAction.actionPtr->effect);
       pNextInPlanCanBeAnEvent = pNewPotentialNextAction.nextStepIsAnEvent(pDataRelatedToOptimisation.parameterToEntitiesFromEvent);
       return true;
     }
-    if (pPotentialNextActionComparisonCacheOpt->currentCost.isBetterThan(newCost))
+    if (areCostsComparable && pPotentialNextActionComparisonCacheOpt->currentCost.isBetterThan(newCost))
     {
       pPotentialNextActionComparisonCacheOpt->effectsWithWorseCosts.push_back(&pNewPotentialNextAction.actionPtr->effect);
       return false;
@@ -946,14 +1008,19 @@ ActionId _findFirstActionForAGoal(
     bool& pNextInPlanCanBeAnEvent,
     TreeOfAlreadyDonePath& pTreeOfAlreadyDonePath,
     const Goal& pGoal,
-    const Problem& pProblem,
+    Problem& pProblem,
     const Domain& pDomain,
     bool pTryToDoMoreOptimalSolution,
     const std::map<std::string, MinMaxValues>& pMinMaxValuesForFacts,
     std::size_t pLength,
     const std::set<std::string>& pFirstActionInvocationsAlreadyDone,
     const Historical* pGlobalHistorical,
-    const ActionPtrWithGoal* pPreviousActionPtr)
+    const ActionPtrWithGoal* pPreviousActionPtr,
+    SearchLimits* pSearchLimitsPtr,
+    TranspositionTable* pTranspositionTablePtr,
+    const RelaxedReachability* pRelaxedReachabilityPtr,
+    ActionGroundings* pActionGroundingsPtr,
+    ThreadPool* pThreadPoolPtr)
 {
   std::optional<ActionInvocationWithPtr> res;
   std::set<ActionId> actionIdsToSkip;
@@ -963,13 +1030,27 @@ ActionId _findFirstActionForAGoal(
     actionIdsToSkip = pPreviousActionPtr->actionPtr->actionsSuccessionsWithoutInterestCache;
   std::optional<PotentialNextActionComparisonCache> potentialNextActionComparisonCacheOpt;
 
+  // The actions and the events that can never happen from the current world state are not explored
+  std::optional<std::set<ActionId>> reachableActionIdsOpt;
+  std::optional<std::set<FullEventId>> reachableFullEventIdsOpt;
+  if (pRelaxedReachabilityPtr != nullptr && !pRelaxedReachabilityPtr->isEverythingReachable())
+  {
+    reachableActionIdsOpt = pRelaxedReachabilityPtr->filterActions(pGoal.getActionsPredecessors());
+    reachableFullEventIdsOpt = pRelaxedReachabilityPtr->filterEvents(pGoal.getEventsPredecessors());
+  }
   ResearchContext context(pGoal, pProblem, pDomain,
-                          pGoal.getActionsPredecessors(), pGoal.getEventsPredecessors());
+                          reachableActionIdsOpt ? *reachableActionIdsOpt : pGoal.getActionsPredecessors(),
+                          reachableFullEventIdsOpt ? *reachableFullEventIdsOpt : pGoal.getEventsPredecessors());
 
+  // The candidates are collected before to be compared, so that their rollouts can be done in parallel
+  std::list<DataRelatedToOptimisation> dataRelatedToOptimisationOfActions;
+  std::vector<std::pair<ActionInvocationWithPtr, const DataRelatedToOptimisation*>> candidates;
   auto& ontology = pDomain.getOntology();
   auto& domainActions = pDomain.actions();
   for (const ActionId& currActionId : context.actionIds)
   {
+    if (pSearchLimitsPtr != nullptr && pSearchLimitsPtr->isCancelled())
+      return "";
     if (actionIdsToSkip.count(currActionId) > 0)
       continue;
 
@@ -979,12 +1060,15 @@ ActionId _findFirstActionForAGoal(
       const Action& action = itAction->second;
       if (!action.canThisActionBeUsedByThePlanner)
         continue;
+      const auto* groundingsPtr = pActionGroundingsPtr != nullptr ? pActionGroundingsPtr->getGroundingsPtr(currActionId) : nullptr;
+      if (groundingsPtr != nullptr && groundingsPtr->empty())
+        continue; // All the groundings of the action are statically impossible
       auto* newTreePtr = pTreeOfAlreadyDonePath.getNextActionTreeIfNotAnExistingLeaf(currActionId);
       if (newTreePtr != nullptr) // To skip leaf of already seen path
       {
         FactsAlreadyChecked factsAlreadyChecked;
         auto newPotRes = PotentialNextAction(currActionId, action);
-        DataRelatedToOptimisation dataRelatedToOptimisation;
+        auto& dataRelatedToOptimisation = dataRelatedToOptimisationOfActions.emplace_back();
         dataRelatedToOptimisation.tryToDoMoreOptimalSolution = pTryToDoMoreOptimalSolution;
         if (_lookForAPossibleEffect(newPotRes.parameters, dataRelatedToOptimisation, *newTreePtr,
                                     action.effect.worldStateModification, action.effect.potentialWorldStateModification,
@@ -992,20 +1076,66 @@ ActionId _findFirstActionForAGoal(
             (!action.precondition || action.precondition->isTrue(pProblem.worldState, ontology.constants, pProblem.objects, {}, {}, {}, &newPotRes.parameters)))
         {
           const auto& constants = pDomain.getOntology().constants;
-          auto actionInvocations = newPotRes.toActionInvocations(constants, pProblem.objects);
+          auto actionInvocations = newPotRes.toActionInvocations(constants, pProblem.objects, groundingsPtr);
           for (auto& currActionInvocation : actionInvocations)
           {
             if (!pFirstActionInvocationsAlreadyDone.empty() && pFirstActionInvocationsAlreadyDone.count(currActionInvocation.actionInvocation.toStr()) > 0)
               continue;
-            if (_isMoreOptimalNextAction(potentialNextActionComparisonCacheOpt, pNextInPlanCanBeAnEvent,
-                                         currActionInvocation, res, pProblem, pDomain,
-                                         pMinMaxValuesForFacts, dataRelatedToOptimisation, pLength, pGoal, pGlobalHistorical))
-              res.emplace(currActionInvocation);
+            candidates.emplace_back(std::move(currActionInvocation), &dataRelatedToOptimisation);
           }
         }
+        else
+        {
+          dataRelatedToOptimisationOfActions.pop_back();
+        }
+      }
+    }
+  }
+
+  std::map<std::string, PlanCost> precomputedPlanCosts;
+  if (pThreadPoolPtr != nullptr && pTryToDoMoreOptimalSolution && pLength == 0 &&
+      (pSearchLimitsPtr == nullptr || !pSearchLimitsPtr->isExhausted()))
+  {
+    // The costs are only compared if two candidates differ, and then every candidate differs from one of them
+    auto itCandidateWithAction = std::find_if(candidates.begin(), candidates.end(), [](const auto& pCandidate) {
+      return pCandidate.first.actionPtr != nullptr;
+    });
+    bool areCostsCompared = itCandidateWithAction != candidates.end() &&
+        std::any_of(candidates.begin(), candidates.end(), [&](const auto& pCandidate) {
+          return _areCostsToCompare(pCandidate.first, itCandidateWithAction->first);
+        });
+    std::vector<std::pair<const ActionInvocationWithPtr*, std::string>> candidatesToEvaluate;
+    if (areCostsCompared)
+    {
+      std::set<std::string> invocationsToEvaluate;
+      for (const auto& currCandidate : candidates)
+      {
+        auto invocationStr = currCandidate.first.actionInvocation.toStr();
+        if (currCandidate.first.actionPtr != nullptr && invocationsToEvaluate.insert(invocationStr).second)
+          candidatesToEvaluate.emplace_back(&currCandidate.first, std::move(invocationStr));
       }
     }
+
+    std::vector<PlanCost> planCosts(candidatesToEvaluate.size());
+    pThreadPoolPtr->parallelFor(candidatesToEvaluate.size(), [&](std::size_t pIndex) {
+      // Each rollout works on its own copy of the problem
+      auto problemForRollout = pProblem;
+      planCosts[pIndex] = _extractPlanCostAfterAction(problemForRollout, pDomain, pMinMaxValuesForFacts,
+                                                      *candidatesToEvaluate[pIndex].first, pGoal,
+                                                      pSearchLimitsPtr, pTranspositionTablePtr);
+    });
+    for (std::size_t i = 0; i < candidatesToEvaluate.size(); ++i)
+      precomputedPlanCosts.emplace(std::move(candidatesToEvaluate[i].second), planCosts[i]);
   }
+
+  // The reduction is done in the order of the candidates, so the result does not depend on the threads
+  for (const auto& currCandidate : candidates)
+    if (_isMoreOptimalNextAction(potentialNextActionComparisonCacheOpt, pNextInPlanCanBeAnEvent,
+                                 currCandidate.first, res, pProblem, pDomain,
+                                 pMinMaxValuesForFacts, *currCandidate.second, pLength, pGoal, pGlobalHistorical,
+                                 pSearchLimitsPtr, pTranspositionTablePtr, precomputedPlanCosts))
+      res.emplace(currCandidate.first);
+
   if (res)
   {
     pParameters = std::move(res->actionInvocation.parameters);
@@ -1027,8 +1157,20 @@ bool _goalToPlanRec(
     const Historical* pGlobalHistorical,
     const Goal& pGoal,
     int pPriority,
-    const ActionPtrWithGoal* pPreviousActionPtr)
+    const ActionPtrWithGoal* pPreviousActionPtr,
+    SearchLimits* pSearchLimitsPtr,
+    TranspositionTable* pTranspositionTablePtr,
+    const RelaxedReachability* pRelaxedReachabilityPtr,
+    ActionGroundings* pActionGroundingsPtr,
+    ThreadPool* pThreadPoolPtr)
 {
+  if (pSearchLimitsPtr != nullptr)
+  {
+    // If the budget is exhausted, the rollouts and the main descent are aborted before expanding a new node
+    if (pSearchLimitsPtr->isExhausted())
+      return false;
+    pSearchLimitsPtr->notifyExpansion();
+  }
   TreeOfAlreadyDonePath treeOfAlreadyDonePath;
 
   std::unique_ptr<ActionInvocationWithGoal> potentialRes;
@@ -1038,7 +1180,9 @@ bool _goalToPlanRec(
     auto actionId =
         _findFirstActionForAGoal(parameters, nextInPlanCanBeAnEvent, treeOfAlreadyDonePath, pGoal, pProblem,
                                  pDomain, pTryToDoMoreOptimalSolution, pMinMaxValuesForFacts, 0,
-                                 pFirstActionInvocationsAlreadyDone, pGlobalHistorical, pPreviousActionPtr);
+                                 pFirstActionInvocationsAlreadyDone, pGlobalHistorical, pPreviousActionPtr,
+                                 pSearchLimitsPtr, pTranspositionTablePtr, pRelaxedReachabilityPtr,
+                                 pActionGroundingsPtr, pThreadPoolPtr);
     if (!actionId.empty())
       potentialRes = std::make_unique<ActionInvocationWithGoal>(actionId, parameters, pGoal.clone(), pPriority);
   }
@@ -1059,17 +1203,13 @@ bool _goalToPlanRec(
       const auto& fact = factOpt.fact;
       if (currFoAVm.vm == ValueModification::INCREASE || currFoAVm.vm == ValueModification::DECREASE)
       {
-        auto fluentValue = pProblem.worldState.factsMapping().getFluentValue(fact);
-        if (fluentValue)
+        auto fluentValueNumber = pProblem.worldState.factsMapping().getFluentNumber(fact);
+        if (fluentValueNumber)
         {
-          auto fluentValueNumber = fluentValue->toNumber();
-          if (fluentValueNumber)
-          {
-            if (currFoAVm.vm == ValueModification::INCREASE)
-              factToMinMaxValuesSoFar[fact.name()].max = fluentValueNumber;
-            else if (currFoAVm.vm == ValueModification::DECREASE)
-              factToMinMaxValuesSoFar[fact.name()].min = fluentValueNumber;
-          }
+          if (currFoAVm.vm == ValueModification::INCREASE)
+            factToMinMaxValuesSoFar[fact.name()].max = fluentValueNumber;
+          else if (currFoAVm.vm == ValueModification::DECREASE)
+            factToMinMaxValuesSoFar[fact.name()].min = fluentValueNumber;
         }
       }
     }
@@ -1092,20 +1232,23 @@ bool _goalToPlanRec(
     }
 
 
-    auto problemForPlanCost = pProblem;
+    auto checkpoint = pProblem.checkpoint();
     bool goalChanged = false;
     const auto& ontology = pDomain.getOntology();
-    updateProblemForNextPotentialPlannerResultWithAction(problemForPlanCost, goalChanged,
+    updateProblemForNextPotentialPlannerResultWithAction(pProblem, goalChanged,
                                                          *potentialRes, *potActionPtr,
                                                          pDomain, pNow, nullptr, nullptr);
     ActionPtrWithGoal previousAction(potActionPtr, pGoal);
     auto* previousActionPtr = nextInPlanCanBeAnEvent ? nullptr : &previousAction;
     std::set<std::string> firstActionInvocationsAlreadyDone;
-    if (problemForPlanCost.worldState.isGoalSatisfied(pGoal, ontology.constants, problemForPlanCost.objects) ||
-        _goalToPlanRec(pActionInvocations, problemForPlanCost, pActionAlreadyInPlan,
+    bool isGoalReached = pProblem.worldState.isGoalSatisfied(pGoal, ontology.constants, pProblem.objects) ||
+        _goalToPlanRec(pActionInvocations, pProblem, pActionAlreadyInPlan,
                        firstActionInvocationsAlreadyDone,
                        pDomain, pTryToDoMoreOptimalSolution, pMinMaxValuesForFacts, pNow,
-                       nullptr, pGoal, pPriority, previousActionPtr))
+                       nullptr, pGoal, pPriority, previousActionPtr, pSearchLimitsPtr, pTranspositionTablePtr,
+                       pRelaxedReachabilityPtr, pActionGroundingsPtr, pThreadPoolPtr);
+    pProblem.rollbackTo(checkpoint);
+    if (isGoalReached)
     {
       potentialRes->fromGoal->notifyActivity();
       pActionInvocations.emplace_front(std::move(*potentialRes));
@@ -1124,11 +1267,20 @@ std::list<ActionInvocationWithGoal> _planForMoreImportantGoalPossible(Problem& p
                                                                       const Historical* pGlobalHistorical,
                                                                       LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr,
                                                                       const ActionPtrWithGoal* pPreviousActionPtr,
-                                                                      std::size_t pNbOfPotentialRetries)
+                                                                      std::size_t pNbOfPotentialRetries,
+                                                                      PlannerCaches* pCachesPtr,
+                                                                      SearchLimits* pSearchLimitsPtr,
+                                                                      TranspositionTable* pTranspositionTablePtr,
+                                                                      bool pIsARollout)
 {
   const auto& ontology = pDomain.getOntology();
   auto problemBeforePlanning = pProblem;
   std::list<ActionInvocationWithGoal> res;
+  std::optional<RelaxedReachability> relaxedReachabilityOpt;
+  // The groundings are kept between the calls if there are caches
+  std::optional<ActionGroundings> localActionGroundingsOpt;
+  ActionGroundings* actionGroundingsPtr = nullptr;
+  auto* threadPoolPtr = pCachesPtr != nullptr ? pCachesPtr->threadPoolPtr() : nullptr;
   pProblem.goalStack.refreshIfNeeded(pDomain);
   pProblem.goalStack.iterateOnGoalsAndRemoveNonPersistent(
         [&]() {
@@ -1141,16 +1293,53 @@ std::list<ActionInvocationWithGoal> _planForMoreImportantGoalPossible(Problem& p
             pProblem.worldState.updateImmutableFacts(ontology);
         },
         [&](const Goal& pGoal, int pPriority){
+            // Stop the iteration on the goals without considering the goal as failed
+            if (pSearchLimitsPtr != nullptr && pSearchLimitsPtr->isExhausted())
+              return true;
+            if (pCachesPtr != nullptr && pCachesPtr->hasGoalFailed(pGoal, pTryToDoMoreOptimalSolution, pProblem, pGlobalHistorical))
+              return false;
+            // The rollouts only estimate a cost, so they do not pay for the analyses at each of their steps
+            if (!pIsARollout)
+            {
+              // Between the goals, the world state only changes by the effect between goals that is taken into account
+              if (!relaxedReachabilityOpt)
+                relaxedReachabilityOpt.emplace(pProblem, pDomain);
+              if (actionGroundingsPtr == nullptr)
+              {
+                if (pCachesPtr != nullptr)
+                {
+                  actionGroundingsPtr = &pCachesPtr->actionGroundings(pProblem, pDomain);
+                }
+                else
+                {
+                  actionGroundingsPtr = &localActionGroundingsOpt.emplace(pDomain);
+                  actionGroundingsPtr->update(pProblem.worldState, pProblem.goalStack.effectBetweenGoals.get(), pProblem.objects);
+                }
+              }
+            }
+            if (relaxedReachabilityOpt && !relaxedReachabilityOpt->canGoalBeReached(pGoal))
+            {
+              if (pCachesPtr != nullptr)
+                pCachesPtr->notifyGoalFailure(pGoal, pTryToDoMoreOptimalSolution, pProblem, pGlobalHistorical);
+              return false;
+            }
+            // The search applies and undoes the actions on this copy because the goals of pProblem are being iterated
+            auto problemForSearch = pProblem;
             std::set<std::string> firstActionInvocationsAlreadyDone;
             std::size_t firstActionInvocationsAlreadyDoneLastSize = 0;
             for (std::size_t i = 0; i < pNbOfPotentialRetries; ++i)
             {
               std::map<std::string, ExecutionOfFatValuesCache> actionAlreadyInPlan;
-              if (_goalToPlanRec(res, pProblem, actionAlreadyInPlan,
+              if (_goalToPlanRec(res, problemForSearch, actionAlreadyInPlan,
                                  firstActionInvocationsAlreadyDone,
                                  pDomain, pTryToDoMoreOptimalSolution, pMinMaxValuesForFacts,
                                  pNow, pGlobalHistorical, pGoal, pPriority,
-                                 pPreviousActionPtr))
+                                 pPreviousActionPtr, pSearchLimitsPtr, pTranspositionTablePtr,
+                                 relaxedReachabilityOpt ? &*relaxedReachabilityOpt : nullptr,
+                                 actionGroundingsPtr, threadPoolPtr))
+                return true;
+              // The goal is kept and not memorized as a failure because the search was truncated
+              if (pSearchLimitsPtr != nullptr && pSearchLimitsPtr->isExhausted())
                 return true;
 
               auto newSize = firstActionInvocationsAlreadyDone.size();
@@ -1158,6 +1347,8 @@ std::list<ActionInvocationWithGoal> _planForMoreImportantGoalPossible(Problem& p
                 break;
               firstActionInvocationsAlreadyDoneLastSize = newSize;
             }
+            if (pCachesPtr != nullptr)
+              pCachesPtr->notifyGoalFailure(pGoal, pTryToDoMoreOptimalSolution, pProblem, pGlobalHistorical);
             return false;
           },
         pProblem.worldState, ontology.constants, pProblem.objects, pNow,
@@ -1165,7 +1356,8 @@ std::list<ActionInvocationWithGoal> _planForMoreImportantGoalPossible(Problem& p
   if (!res.empty() && res.front().fromGoal)
   {
     auto goalToKeepSatisfied = *res.front().fromGoal;
-    removeNotMandatoryActions(res, pDomain, problemBeforePlanning, goalToKeepSatisfied);
+    removeNotMandatoryActions(res, pDomain, problemBeforePlanning, goalToKeepSatisfied,
+                              pSearchLimitsPtr != nullptr ? &pSearchLimitsPtr->cancellationToken() : nullptr);
   }
   return res;
 }
@@ -1213,6 +1405,290 @@ bool _applyAction(WorldState& pWorldState,
   return somethingChanged;
 }
 
+
+/**
+ * @brief Remove the actions of a plan, from the last one to the first one, if the goal is still satisfied without them.
+ * @param[in, out] pPlan Plan to prune.
+ * @param[in] pRestoreStateBeforeAction Callback to restore the state as it was before an action of the plan.
+ * @param[in] pApplyAction Callback to apply an action to the state, it returns false if the action is not applicable.
+ * @param[in] pIsGoalSatisfied Callback to check if the goal is satisfied in the state.
+ * @param[in] pCancellationTokenPtr Token to stop the pruning, the actions already removed stay removed.
+ */
+void _removeActionsNotNeededToSatisfyTheGoal(std::list<ActionInvocationWithGoal>& pPlan,
+                                             const std::function<void(std::size_t)>& pRestoreStateBeforeAction,
+                                             const std::function<bool(std::size_t)>& pApplyAction,
+                                             const std::function<bool()>& pIsGoalSatisfied,
+                                             const CancellationToken* pCancellationTokenPtr)
+{
+  auto planSize = pPlan.size();
+  std::vector<bool> removed(planSize, false);
+  auto itPlan = --pPlan.end();
+  for (std::size_t idx = planSize; idx > 0; )
+  {
+    if (pCancellationTokenPtr != nullptr && pCancellationTokenPtr->isCancelled())
+      return;
+    --idx;
+    pRestoreStateBeforeAction(idx);
+    bool isStillValid = true;
+    for (std::size_t nextIdx = idx + 1; nextIdx < planSize; ++nextIdx)
+    {
+      if (removed[nextIdx])
+        continue;
+      if (!pApplyAction(nextIdx))
+      {
+        isStillValid = false;
+        break;
+      }
+    }
+
+    if (isStillValid && pIsGoalSatisfied())
+    {
+      removed[idx] = true;
+      itPlan = pPlan.erase(itPlan);
+    }
+     --itPlan;
+  }
+}
+
+
+/**
+ * @brief Plan for the goal on top of the goal stack with a forward search.<br/>
+ * The result is empty if the forward search cannot be used for this goal, so that the backward chaining
+ * manages the goal, for example to skip it or to remove it from the goal stack.
+ */
+std::list<ActionInvocationWithGoal> _planForMostImportantGoalWithForwardSearch(const Problem& pProblem,
+                                                                              const Domain& pDomain,
+                                                                              const SearchStrategy& pSearchStrategy,
+                                                                              SearchLimits* pSearchLimitsPtr,
+                                                                              ForwardSearchGrounding* pGroundingPtr)
+{
+  for (auto itGoalGroup = pProblem.goalStack.goals().rbegin(); itGoalGroup != pProblem.goalStack.goals().rend(); ++itGoalGroup)
+  {
+    if (itGoalGroup->second.empty())
+      continue;
+    const auto& goal = itGoalGroup->second.front();
+    if (goal.isOneStepTowards() ||
+        pProblem.worldState.isGoalSatisfied(goal, pDomain.getOntology().constants, pProblem.objects))
+      return {};
+    auto planOpt = planWithForwardSearch(pProblem, pDomain, goal, itGoalGroup->first, pSearchStrategy, pSearchLimitsPtr,
+                                         pGroundingPtr);
+    if (!planOpt)
+      return {};
+    // Like the plans of the backward chaining, the plan does not contain the actions that are not needed
+    removeNotMandatoryActions(*planOpt, pDomain, pProblem, goal,
+                              pSearchLimitsPtr != nullptr ? &pSearchLimitsPtr->cancellationToken() : nullptr);
+    return std::move(*planOpt);
+  }
+  return {};
+}
+
+
+/// Plan for the most important goal with the forward search of a strategy, or with the backward chaining if it cannot.
+std::list<ActionInvocationWithGoal> _planForMoreImportantGoalPossibleWithSearchStrategy(Problem& pProblem,
+                                                                                        const Domain& pDomain,
+                                                                                        const SetOfCallbacks& pCallbacks,
+                                                                                        bool pTryToDoMoreOptimalSolution,
+                                                                                        const std::map<std::string, MinMaxValues>& pMinMaxValuesForFacts,
+                                                                                        const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                                        const Historical* pGlobalHistorical,
+                                                                                        LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr,
+                                                                                        PlannerCaches* pCachesPtr,
+                                                                                        SearchLimits* pSearchLimitsPtr,
+                                                                                        TranspositionTable* pTranspositionTablePtr,
+                                                                                        const SearchStrategy* pSearchStrategyPtr)
+{
+  if (pSearchStrategyPtr != nullptr)
+  {
+    auto plan = _planForMostImportantGoalWithForwardSearch(pProblem, pDomain, *pSearchStrategyPtr, pSearchLimitsPtr,
+                                                           pCachesPtr != nullptr ? &pCachesPtr->forwardSearchGrounding() : nullptr);
+    if (!plan.empty())
+      return plan;
+  }
+  return _planForMoreImportantGoalPossible(pProblem, pDomain, pCallbacks, pTryToDoMoreOptimalSolution,
+                                           pMinMaxValuesForFacts, pNow, pGlobalHistorical,
+                                           pLookForAnActionOutputInfosPtr, nullptr, 100, pCachesPtr,
+                                           pSearchLimitsPtr, pTranspositionTablePtr);
+}
+
+
+/**
+ * @brief Check if an action of a previous plan can still be done as the next action of the plan.<br/>
+ * Its precondition has to be satisfied and it has to be for the most important goal that is not satisfied yet,
+ * otherwise the planner could choose another action.
+ */
+bool _isStillTheNextActionOfThePlan(const ActionInvocationWithGoal& pAction,
+                                    const Problem& pProblem,
+                                    const Domain& pDomain)
+{
+  if (!pAction.fromGoal)
+    return false;
+  const auto* actionPtr = pDomain.getActionPtr(pAction.actionInvocation.actionId);
+  if (actionPtr == nullptr)
+    return false;
+
+  const auto& constants = pDomain.getOntology().constants;
+  const Goal* mostImportantGoalPtr = nullptr;
+  for (auto itGoalGroup = pProblem.goalStack.goals().rbegin();
+       itGoalGroup != pProblem.goalStack.goals().rend() && mostImportantGoalPtr == nullptr; ++itGoalGroup)
+    for (const auto& currGoal : itGoalGroup->second)
+      if (!pProblem.worldState.isGoalSatisfied(currGoal, constants, pProblem.objects))
+      {
+        mostImportantGoalPtr = &currGoal;
+        break;
+      }
+  if (mostImportantGoalPtr == nullptr || mostImportantGoalPtr->toPddl(0) != pAction.fromGoal->toPddl(0))
+    return false;
+
+  ActionDataForParallelisation actionData(*actionPtr, ActionInvocationWithGoal(pAction));
+  const auto* conditionPtr = actionData.getConditionWithoutParameterPtr();
+  return conditionPtr == nullptr || conditionPtr->isTrue(pProblem.worldState, constants, pProblem.objects);
+}
+
+
+std::list<ActionInvocationWithGoal> _planForEveryGoals(Problem& pProblem,
+                                                       const Domain& pDomain,
+                                                       const SetOfCallbacks& pCallbacks,
+                                                       const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                       Historical* pGlobalHistorical,
+                                                       std::list<Goal>* pGoalsDonePtr,
+                                                       PlannerCaches* pCachesPtr,
+                                                       SearchLimits* pSearchLimitsPtr = nullptr,
+                                                       const std::list<ActionInvocationWithGoal>* pPreviousPlanPtr = nullptr,
+                                                       std::size_t* pNbOfReusedActionsPtr = nullptr,
+                                                       const SearchStrategy* pSearchStrategyPtr = nullptr)
+{
+  const bool tryToDoMoreOptimalSolution = true;
+  std::map<std::string, std::size_t> actionAlreadyInPlan;
+  std::list<ActionInvocationWithGoal> res;
+  LookForAnActionOutputInfos lookForAnActionOutputInfos;
+
+  // The valid prefix of the previous plan is simulated like the actions found by the search
+  // The effect between the goals is applied by the search only, so the previous plan cannot be checked without it
+  if (pPreviousPlanPtr != nullptr && !pProblem.goalStack.effectBetweenGoals)
+  {
+    pProblem.goalStack.refreshIfNeeded(pDomain);
+    for (const auto& currAction : *pPreviousPlanPtr)
+    {
+      if (!_isStillTheNextActionOfThePlan(currAction, pProblem, pDomain))
+        break;
+      ++actionAlreadyInPlan[currAction.actionInvocation.toStr()];
+      bool goalChanged = false;
+      updateProblemForNextPotentialPlannerResult(pProblem, goalChanged, currAction, pDomain, pNow, pGlobalHistorical,
+                                                 &lookForAnActionOutputInfos);
+      res.emplace_back(currAction);
+    }
+  }
+  if (pNbOfReusedActionsPtr != nullptr)
+    *pNbOfReusedActionsPtr = res.size();
+
+  auto minMaxValuesForFacts = pCachesPtr != nullptr ?
+        pCachesPtr->minMaxValuesForFacts(pProblem, pDomain) : ogp::extractMinMaxValuesForFacts(pProblem, pDomain);
+  // The costs of the rollouts are memorized for the time of the call, or for the session if there is one
+  TranspositionTable localTranspositionTable;
+  auto& transpositionTable = pCachesPtr != nullptr ?
+        pCachesPtr->transpositionTable(minMaxValuesForFacts) : localTranspositionTable;
+  while (!pProblem.goalStack.goals().empty())
+  {
+    // The plan found so far is returned if the budget is exhausted
+    if (pSearchLimitsPtr != nullptr && pSearchLimitsPtr->isExhausted())
+      break;
+    auto subPlan = _planForMoreImportantGoalPossibleWithSearchStrategy(pProblem, pDomain, pCallbacks, tryToDoMoreOptimalSolution,
+                                                                       minMaxValuesForFacts, pNow, pGlobalHistorical,
+                                                                       &lookForAnActionOutputInfos, pCachesPtr,
+                                                                       pSearchLimitsPtr, &transpositionTable, pSearchStrategyPtr);
+    if (subPlan.empty())
+      break;
+    for (auto& currActionInSubPlan : subPlan)
+    {
+      const auto& actionToDoStr = currActionInSubPlan.actionInvocation.toStr();
+      auto itAlreadyFoundAction = actionAlreadyInPlan.find(actionToDoStr);
+      if (itAlreadyFoundAction == actionAlreadyInPlan.end())
+      {
+        actionAlreadyInPlan[actionToDoStr] = 1;
+      }
+      else
+      {
+        if (itAlreadyFoundAction->second > 10)
+          break;
+        ++itAlreadyFoundAction->second;
+      }
+      bool goalChanged = false;
+      updateProblemForNextPotentialPlannerResult(pProblem, goalChanged, currActionInSubPlan, pDomain, pNow, pGlobalHistorical,
+                                                 &lookForAnActionOutputInfos);
+      res.emplace_back(std::move(currActionInSubPlan));
+      if (goalChanged)
+        break;
+    }
+  }
+  if (pGoalsDonePtr != nullptr)
+    lookForAnActionOutputInfos.moveGoalsDone(*pGoalsDonePtr);
+  return res;
+}
+
+
+ActionsToDoInParallel _actionsToDoInParallelNow(Problem& pProblem,
+                                                const Domain& pDomain,
+                                                const SetOfCallbacks& pCallbacks,
+                                                const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                Historical* pGlobalHistorical,
+                                                PlannerCaches* pCachesPtr,
+                                                SearchLimits* pSearchLimitsPtr = nullptr,
+                                                const SearchStrategy* pSearchStrategyPtr = nullptr)
+{
+  pProblem.goalStack.refreshIfNeeded(pDomain);
+  std::list<Goal> goalsDone;
+  auto problemForPlanResolution = pProblem;
+  auto sequentialPlan = _planForEveryGoals(problemForPlanResolution, pDomain, pCallbacks,
+                                           pNow, pGlobalHistorical, &goalsDone, pCachesPtr, pSearchLimitsPtr,
+                                           nullptr, nullptr, pSearchStrategyPtr);
+  auto parallelPlan = toParallelPlan(sequentialPlan, true, pProblem, pDomain, goalsDone, pNow,
+                                     pSearchLimitsPtr != nullptr ? &pSearchLimitsPtr->cancellationToken() : nullptr);
+  if (!parallelPlan.actionsToDoInParallel.empty())
+    return parallelPlan.actionsToDoInParallel.front();
+  return {};
+}
+
+
+std::list<ActionInvocationWithGoal> _planForMoreImportantGoalPossibleInASession(PlannerCaches& pCaches,
+                                                                                Problem& pProblem,
+                                                                                const Domain& pDomain,
+                                                                                const SetOfCallbacks& pCallbacks,
+                                                                                bool pTryToDoMoreOptimalSolution,
+                                                                                const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                                const Historical* pGlobalHistorical,
+                                                                                LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr,
+                                                                                SearchLimits* pSearchLimitsPtr,
+                                                                                const SearchStrategy* pSearchStrategyPtr = nullptr)
+{
+  pCaches.refreshIfNeeded(pDomain);
+  auto& planCache = pCaches.planCache();
+  std::optional<PlanCache::Key> planKeyOpt;
+  std::optional<CachedProblemState> stateBeforeOpt;
+  if (pLookForAnActionOutputInfosPtr == nullptr)
+  {
+    planKeyOpt = planCache.computeKey(pProblem, pDomain, pTryToDoMoreOptimalSolution, pNow, pGlobalHistorical);
+    if (planKeyOpt)
+    {
+      auto context = PlanCache::contextToStr(pDomain, pTryToDoMoreOptimalSolution, pGlobalHistorical, pSearchStrategyPtr);
+      auto planOpt = planCache.find(*planKeyOpt, pProblem, context);
+      if (planOpt)
+        return std::move(*planOpt);
+      stateBeforeOpt.emplace(pProblem, std::move(context));
+    }
+  }
+
+  auto minMaxValuesForFacts = pCaches.minMaxValuesForFacts(pProblem, pDomain);
+  auto& transpositionTable = pCaches.transpositionTable(minMaxValuesForFacts);
+  auto res = _planForMoreImportantGoalPossibleWithSearchStrategy(pProblem, pDomain, pCallbacks, pTryToDoMoreOptimalSolution,
+                                                                 minMaxValuesForFacts, pNow, pGlobalHistorical,
+                                                                 pLookForAnActionOutputInfosPtr, &pCaches,
+                                                                 pSearchLimitsPtr, &transpositionTable, pSearchStrategyPtr);
+  // A plan truncated by the budget is not memorized, the same call with more budget can find a better plan
+  if (planKeyOpt && (pSearchLimitsPtr == nullptr || pSearchLimitsPtr->status() == PlanningStatus::COMPLETED))
+    planCache.insertIfProblemIsUnchanged(*planKeyOpt, std::move(*stateBeforeOpt), pProblem, res);
+  return res;
+}
+
 }
 
 
@@ -1225,9 +1701,56 @@ std::list<ActionInvocationWithGoal> planForMoreImportantGoalPossible(Problem& pP
                                                                      LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr)
 {
   auto minMaxValuesForFacts = ogp::extractMinMaxValuesForFacts(pProblem, pDomain);
+  TranspositionTable transpositionTable;
   return _planForMoreImportantGoalPossible(pProblem, pDomain, pCallbacks, pTryToDoMoreOptimalSolution,
                                            minMaxValuesForFacts, pNow,
-                                           pGlobalHistorical, pLookForAnActionOutputInfosPtr, nullptr, 100);
+                                           pGlobalHistorical, pLookForAnActionOutputInfosPtr, nullptr, 100,
+                                           nullptr, nullptr, &transpositionTable);
+}
+
+
+std::list<ActionInvocationWithGoal> planForMoreImportantGoalPossible(Problem& pProblem,
+                                                                     const Domain& pDomain,
+                                                                     const SetOfCallbacks& pCallbacks,
+                                                                     bool pTryToDoMoreOptimalSolution,
+                                                                     const PlanningBudget& pBudget,
+                                                                     PlanningStatus& pStatus,
+                                                                     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                     const Historical* pGlobalHistorical,
+                                                                     LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr)
+{
+  SearchLimits searchLimits(pBudget);
+  auto minMaxValuesForFacts = ogp::extractMinMaxValuesForFacts(pProblem, pDomain);
+  TranspositionTable transpositionTable;
+  auto res = _planForMoreImportantGoalPossible(pProblem, pDomain, pCallbacks, pTryToDoMoreOptimalSolution,
+                                               minMaxValuesForFacts, pNow,
+                                               pGlobalHistorical, pLookForAnActionOutputInfosPtr, nullptr, 100,
+                                               nullptr, &searchLimits, &transpositionTable);
+  pStatus = searchLimits.status();
+  return res;
+}
+
+
+std::list<ActionInvocationWithGoal> planForMoreImportantGoalPossible(Problem& pProblem,
+                                                                     const Domain& pDomain,
+                                                                     const SetOfCallbacks& pCallbacks,
+                                                                     bool pTryToDoMoreOptimalSolution,
+                                                                     const SearchStrategy& pSearchStrategy,
+                                                                     const PlanningBudget& pBudget,
+                                                                     PlanningStatus& pStatus,
+                                                                     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                     const Historical* pGlobalHistorical,
+                                                                     LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr)
+{
+  SearchLimits searchLimits(pBudget);
+  auto minMaxValuesForFacts = ogp::extractMinMaxValuesForFacts(pProblem, pDomain);
+  TranspositionTable transpositionTable;
+  auto res = _planForMoreImportantGoalPossibleWithSearchStrategy(pProblem, pDomain, pCallbacks, pTryToDoMoreOptimalSolution,
+                                                                 minMaxValuesForFacts, pNow, pGlobalHistorical,
+                                                                 pLookForAnActionOutputInfosPtr, nullptr,
+                                                                 &searchLimits, &transpositionTable, &pSearchStrategy);
+  pStatus = searchLimits.status();
+  return res;
 }
 
 
@@ -1238,15 +1761,41 @@ ActionsToDoInParallel actionsToDoInParallelNow(
     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
     Historical* pGlobalHistorical)
 {
-  pProblem.goalStack.refreshIfNeeded(pDomain);
-  std::list<Goal> goalsDone;
-  auto problemForPlanResolution = pProblem;
-  auto sequentialPlan = planForEveryGoals(problemForPlanResolution, pDomain, pCallbacks,
-                                          pNow, pGlobalHistorical, &goalsDone);
-  auto parallelPlan = toParallelPlan(sequentialPlan, true, pProblem, pDomain, goalsDone, pNow);
-  if (!parallelPlan.actionsToDoInParallel.empty())
-    return parallelPlan.actionsToDoInParallel.front();
-  return {};
+  return _actionsToDoInParallelNow(pProblem, pDomain, pCallbacks, pNow, pGlobalHistorical, nullptr);
+}
+
+
+ActionsToDoInParallel actionsToDoInParallelNow(
+    Problem& pProblem,
+    const Domain& pDomain,
+    const SetOfCallbacks& pCallbacks,
+    const PlanningBudget& pBudget,
+    PlanningStatus& pStatus,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    Historical* pGlobalHistorical)
+{
+  SearchLimits searchLimits(pBudget);
+  auto res = _actionsToDoInParallelNow(pProblem, pDomain, pCallbacks, pNow, pGlobalHistorical, nullptr, &searchLimits);
+  pStatus = searchLimits.status();
+  return res;
+}
+
+
+ActionsToDoInParallel actionsToDoInParallelNow(
+    Problem& pProblem,
+    const Domain& pDomain,
+    const SetOfCallbacks& pCallbacks,
+    const SearchStrategy& pSearchStrategy,
+    const PlanningBudget& pBudget,
+    PlanningStatus& pStatus,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    Historical* pGlobalHistorical)
+{
+  SearchLimits searchLimits(pBudget);
+  auto res = _actionsToDoInParallelNow(pProblem, pDomain, pCallbacks, pNow, pGlobalHistorical, nullptr, &searchLimits,
+                                       &pSearchStrategy);
+  pStatus = searchLimits.status();
+  return res;
 }
 
 
@@ -1305,60 +1854,86 @@ std::list<ActionInvocationWithGoal> planForEveryGoals(
     Historical* pGlobalHistorical,
     std::list<Goal>* pGoalsDonePtr)
 {
-  const bool tryToDoMoreOptimalSolution = true;
-  std::map<std::string, std::size_t> actionAlreadyInPlan;
-  std::list<ActionInvocationWithGoal> res;
-  LookForAnActionOutputInfos lookForAnActionOutputInfos;
-  auto minMaxValuesForFacts = ogp::extractMinMaxValuesForFacts(pProblem, pDomain);
-  while (!pProblem.goalStack.goals().empty())
-  {
-    auto subPlan = _planForMoreImportantGoalPossible(pProblem, pDomain, pCallbacks, tryToDoMoreOptimalSolution,
-                                                     minMaxValuesForFacts, pNow, pGlobalHistorical,
-                                                     &lookForAnActionOutputInfos, nullptr, 100);
-    if (subPlan.empty())
-      break;
-    for (auto& currActionInSubPlan : subPlan)
-    {
-      const auto& actionToDoStr = currActionInSubPlan.actionInvocation.toStr();
-      auto itAlreadyFoundAction = actionAlreadyInPlan.find(actionToDoStr);
-      if (itAlreadyFoundAction == actionAlreadyInPlan.end())
-      {
-        actionAlreadyInPlan[actionToDoStr] = 1;
-      }
-      else
-      {
-        if (itAlreadyFoundAction->second > 10)
-          break;
-        ++itAlreadyFoundAction->second;
-      }
-      bool goalChanged = false;
-      updateProblemForNextPotentialPlannerResult(pProblem, goalChanged, currActionInSubPlan, pDomain, pNow, pGlobalHistorical,
-                                                 &lookForAnActionOutputInfos);
-      res.emplace_back(std::move(currActionInSubPlan));
-      if (goalChanged)
-        break;
-    }
-  }
-  if (pGoalsDonePtr != nullptr)
-    lookForAnActionOutputInfos.moveGoalsDone(*pGoalsDonePtr);
+  return _planForEveryGoals(pProblem, pDomain, pCallbacks, pNow, pGlobalHistorical, pGoalsDonePtr, nullptr);
+}
+
+
+std::list<ActionInvocationWithGoal> planForEveryGoals(
+    Problem& pProblem,
+    const Domain& pDomain,
+    const SetOfCallbacks& pCallbacks,
+    const PlanningBudget& pBudget,
+    PlanningStatus& pStatus,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    Historical* pGlobalHistorical,
+    std::list<Goal>* pGoalsDonePtr)
+{
+  SearchLimits searchLimits(pBudget);
+  auto res = _planForEveryGoals(pProblem, pDomain, pCallbacks, pNow, pGlobalHistorical, pGoalsDonePtr, nullptr,
+                                &searchLimits);
+  pStatus = searchLimits.status();
   return res;
 }
 
 
+std::list<ActionInvocationWithGoal> planForEveryGoals(
+    Problem& pProblem,
+    const Domain& pDomain,
+    const SetOfCallbacks& pCallbacks,
+    const SearchStrategy& pSearchStrategy,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    Historical* pGlobalHistorical,
+    std::list<Goal>* pGoalsDonePtr)
+{
+  return _planForEveryGoals(pProblem, pDomain, pCallbacks, pNow, pGlobalHistorical, pGoalsDonePtr, nullptr,
+                            nullptr, nullptr, nullptr, &pSearchStrategy);
+}
+
+
+std::list<ActionInvocationWithGoal> planForEveryGoals(
+    Problem& pProblem,
+    const Domain& pDomain,
+    const SetOfCallbacks& pCallbacks,
+    const SearchStrategy& pSearchStrategy,
+    const PlanningBudget& pBudget,
+    PlanningStatus& pStatus,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    Historical* pGlobalHistorical,
+    std::list<Goal>* pGoalsDonePtr)
+{
+  SearchLimits searchLimits(pBudget);
+  auto res = _planForEveryGoals(pProblem, pDomain, pCallbacks, pNow, pGlobalHistorical, pGoalsDonePtr, nullptr,
+                                &searchLimits, nullptr, nullptr, &pSearchStrategy);
+  pStatus = searchLimits.status();
+  return res;
+}
+
+
+std::list<ActionInvocationWithGoal> replanForEveryGoals(
+    Problem& pProblem,
+    const Domain& pDomain,
+    const SetOfCallbacks& pCallbacks,
+    const std::list<ActionInvocationWithGoal>& pPreviousPlan,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    Historical* pGlobalHistorical,
+    std::list<Goal>* pGoalsDonePtr,
+    std::size_t* pNbOfReusedActionsPtr)
+{
+  return _planForEveryGoals(pProblem, pDomain, pCallbacks, pNow, pGlobalHistorical, pGoalsDonePtr, nullptr,
+                            nullptr, &pPreviousPlan, pNbOfReusedActionsPtr);
+}
+
+
 void removeNotMandatoryActions(std::list<ActionInvocationWithGoal>& pPlan,
                                const Domain& pDomain,
                                const Problem& pProblem,
-                               const Goal& pGoal)
+                               const Goal& pGoal,
+                               const CancellationToken* pCancellationTokenPtr)
 {
   auto planSize = pPlan.size();
   if (planSize < 2)
     return;
 
-  std::unique_ptr<std::chrono::steady_clock::time_point> now;
-  std::vector<WorldState> worldStateBeforeAction;
-  worldStateBeforeAction.reserve(planSize);
-  auto worldStateForPrefix = pProblem.worldState;
-
   std::list<ActionDataForParallelisation> planWithCache;
   const auto& actions = pDomain.actions();
   for (const auto& currAction : pPlan)
@@ -1366,45 +1941,57 @@ void removeNotMandatoryActions(std::list<ActionInvocationWithGoal>& pPlan,
     auto itAction = actions.find(currAction.actionInvocation.actionId);
     if (itAction == actions.end())
       throw std::runtime_error("ActionId \"" + currAction.actionInvocation.actionId + "\" not found while pruning a plan");
-
-    ActionDataForParallelisation actDataPorParallelisation(itAction->second, ActionInvocationWithGoal(currAction));
-    worldStateBeforeAction.emplace_back(worldStateForPrefix);
-    _applyAction(worldStateForPrefix, pProblem.objects, actDataPorParallelisation, pDomain, now);
-    planWithCache.emplace_back(std::move(actDataPorParallelisation));
+    planWithCache.emplace_back(itAction->second, ActionInvocationWithGoal(currAction));
   }
 
-  std::vector<bool> removed(planSize, false);
-  std::vector<std::list<ActionDataForParallelisation>::iterator> cacheIters;
-  cacheIters.reserve(planWithCache.size());
-  for (auto itCache = planWithCache.begin(); itCache != planWithCache.end(); ++itCache)
-    cacheIters.emplace_back(itCache);
-
-  const auto& constants = pDomain.getOntology().constants;
-  auto itPlan = --pPlan.end();
-  for (std::size_t idx = planSize; idx > 0; )
+  // Fast path: the plan is validated on bitsets if the actions and the goal are STRIPS
+  if (GroundedStripsModel::canBeUsedFor(pDomain))
   {
-    --idx;
-    auto& worldStateForValidation = worldStateBeforeAction[idx];
-    bool isStillValid = true;
-    for (std::size_t nextIdx = idx + 1; nextIdx < planSize; ++nextIdx)
+    auto stripsModel = GroundedStripsModel::tryToCompile(planWithCache, pGoal, pProblem.worldState, pDomain);
+    if (stripsModel)
     {
-      if (removed[nextIdx])
-        continue;
-      if (!_applyAction(worldStateForValidation, pProblem.objects, *cacheIters[nextIdx], pDomain, now))
+      std::vector<StripsBitset> stateBeforeAction;
+      stateBeforeAction.reserve(planSize);
+      auto state = stripsModel->initialState();
+      for (std::size_t idx = 0; idx < planSize; ++idx)
       {
-        isStillValid = false;
-        break;
+        stateBeforeAction.emplace_back(state);
+        stripsModel->applyAction(state, idx);
       }
-    }
 
-    if (isStillValid &&
-        worldStateForValidation.isGoalSatisfied(pGoal, constants, pProblem.objects))
-    {
-      removed[idx] = true;
-      itPlan = pPlan.erase(itPlan);
+      _removeActionsNotNeededToSatisfyTheGoal(
+            pPlan,
+            [&](std::size_t pIdx) { state = stateBeforeAction[pIdx]; },
+            [&](std::size_t pIdx) { return stripsModel->applyAction(state, pIdx); },
+            [&]() { return stripsModel->isGoalSatisfied(state); },
+            pCancellationTokenPtr);
+      return;
     }
-     --itPlan;
   }
+
+  std::unique_ptr<std::chrono::steady_clock::time_point> now;
+  // One world state with a checkpoint before each action instead of one copy of the world state per action
+  auto worldState = pProblem.worldState;
+  std::vector<WorldState::Checkpoint> checkpointBeforeAction;
+  checkpointBeforeAction.reserve(planSize);
+
+  std::vector<std::list<ActionDataForParallelisation>::iterator> cacheIters;
+  cacheIters.reserve(planWithCache.size());
+  for (auto itCache = planWithCache.begin(); itCache != planWithCache.end(); ++itCache)
+  {
+    checkpointBeforeAction.emplace_back(worldState.checkpoint());
+    _applyAction(worldState, pProblem.objects, *itCache, pDomain, now);
+    cacheIters.emplace_back(itCache);
+  }
+
+  const auto& constants = pDomain.getOntology().constants;
+  _removeActionsNotNeededToSatisfyTheGoal(
+        pPlan,
+        // It also undoes the actions applied to validate the previous index
+        [&](std::size_t pIdx) { worldState.rollbackTo(checkpointBeforeAction[pIdx]); },
+        [&](std::size_t pIdx) { return _applyAction(worldState, pProblem.objects, *cacheIters[pIdx], pDomain, now); },
+        [&]() { return worldState.isGoalSatisfied(pGoal, constants, pProblem.objects); },
+        pCancellationTokenPtr);
 }
 
 
@@ -1550,4 +2137,222 @@ bool evaluate
 }
 
 
+
+PlannerSession::PlannerSession(const Domain& pDomain,
+                               Problem& pProblem)
+  : _domain(pDomain),
+    _problem(pProblem),
+    _caches(std::make_unique<PlannerCaches>())
+{
+}
+
+
+PlannerSession::~PlannerSession() = default;
+
+
+std::list<ActionInvocationWithGoal> PlannerSession::planForMoreImportantGoalPossible(const SetOfCallbacks& pCallbacks,
+                                                                                     bool pTryToDoMoreOptimalSolution,
+                                                                                     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                                     const Historical* pGlobalHistorical,
+                                                                                     LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr)
+{
+  return _planForMoreImportantGoalPossibleInASession(*_caches, _problem, _domain, pCallbacks, pTryToDoMoreOptimalSolution,
+                                                     pNow, pGlobalHistorical, pLookForAnActionOutputInfosPtr, nullptr);
+}
+
+
+std::list<ActionInvocationWithGoal> PlannerSession::planForMoreImportantGoalPossible(const SetOfCallbacks& pCallbacks,
+                                                                                     bool pTryToDoMoreOptimalSolution,
+                                                                                     const PlanningBudget& pBudget,
+                                                                                     PlanningStatus& pStatus,
+                                                                                     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                                     const Historical* pGlobalHistorical,
+                                                                                     LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr)
+{
+  SearchLimits searchLimits(pBudget);
+  auto res = _planForMoreImportantGoalPossibleInASession(*_caches, _problem, _domain, pCallbacks, pTryToDoMoreOptimalSolution,
+                                                         pNow, pGlobalHistorical, pLookForAnActionOutputInfosPtr, &searchLimits);
+  pStatus = searchLimits.status();
+  return res;
+}
+
+
+std::list<ActionInvocationWithGoal> PlannerSession::planForMoreImportantGoalPossible(const SetOfCallbacks& pCallbacks,
+                                                                                     bool pTryToDoMoreOptimalSolution,
+                                                                                     const SearchStrategy& pSearchStrategy,
+                                                                                     const PlanningBudget& pBudget,
+                                                                                     PlanningStatus& pStatus,
+                                                                                     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                                     const Historical* pGlobalHistorical,
+                                                                                     LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr)
+{
+  SearchLimits searchLimits(pBudget);
+  auto res = _planForMoreImportantGoalPossibleInASession(*_caches, _problem, _domain, pCallbacks, pTryToDoMoreOptimalSolution,
+                                                         pNow, pGlobalHistorical, pLookForAnActionOutputInfosPtr, &searchLimits,
+                                                         &pSearchStrategy);
+  pStatus = searchLimits.status();
+  return res;
+}
+
+
+std::list<ActionInvocationWithGoal> PlannerSession::planForEveryGoals(const SetOfCallbacks& pCallbacks,
+                                                                      const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                      Historical* pGlobalHistorical,
+                                                                      std::list<Goal>* pGoalsDonePtr)
+{
+  _caches->refreshIfNeeded(_domain);
+  return _planForEveryGoals(_problem, _domain, pCallbacks, pNow, pGlobalHistorical, pGoalsDonePtr, &*_caches);
+}
+
+
+std::list<ActionInvocationWithGoal> PlannerSession::planForEveryGoals(const SetOfCallbacks& pCallbacks,
+                                                                      const PlanningBudget& pBudget,
+                                                                      PlanningStatus& pStatus,
+                                                                      const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                      Historical* pGlobalHistorical,
+                                                                      std::list<Goal>* pGoalsDonePtr)
+{
+  _caches->refreshIfNeeded(_domain);
+  SearchLimits searchLimits(pBudget);
+  auto res = _planForEveryGoals(_problem, _domain, pCallbacks, pNow, pGlobalHistorical, pGoalsDonePtr, &*_caches,
+                                &searchLimits);
+  pStatus = searchLimits.status();
+  return res;
+}
+
+
+std::list<ActionInvocationWithGoal> PlannerSession::planForEveryGoals(const SetOfCallbacks& pCallbacks,
+                                                                      const SearchStrategy& pSearchStrategy,
+                                                                      const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                      Historical* pGlobalHistorical,
+                                                                      std::list<Goal>* pGoalsDonePtr)
+{
+  _caches->refreshIfNeeded(_domain);
+  return _planForEveryGoals(_problem, _domain, pCallbacks, pNow, pGlobalHistorical, pGoalsDonePtr, &*_caches,
+                            nullptr, nullptr, nullptr, &pSearchStrategy);
+}
+
+
+std::list<ActionInvocationWithGoal> PlannerSession::planForEveryGoals(const SetOfCallbacks& pCallbacks,
+                                                                      const SearchStrategy& pSearchStrategy,
+                                                                      const PlanningBudget& pBudget,
+                                                                      PlanningStatus& pStatus,
+                                                                      const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                      Historical* pGlobalHistorical,
+                                                                      std::list<Goal>* pGoalsDonePtr)
+{
+  _caches->refreshIfNeeded(_domain);
+  SearchLimits searchLimits(pBudget);
+  auto res = _planForEveryGoals(_problem, _domain, pCallbacks, pNow, pGlobalHistorical, pGoalsDonePtr, &*_caches,
+                                &searchLimits, nullptr, nullptr, &pSearchStrategy);
+  pStatus = searchLimits.status();
+  return res;
+}
+
+
+std::list<ActionInvocationWithGoal> PlannerSession::replanForEveryGoals(const SetOfCallbacks& pCallbacks,
+                                                                        const std::list<ActionInvocationWithGoal>& pPreviousPlan,
+                                                                        const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                                        Historical* pGlobalHistorical,
+                                                                        std::list<Goal>* pGoalsDonePtr,
+                                                                        std::size_t* pNbOfReusedActionsPtr)
+{
+  _caches->refreshIfNeeded(_domain);
+  return _planForEveryGoals(_problem, _domain, pCallbacks, pNow, pGlobalHistorical, pGoalsDonePtr, &*_caches,
+                            nullptr, &pPreviousPlan, pNbOfReusedActionsPtr);
+}
+
+
+ActionsToDoInParallel PlannerSession::actionsToDoInParallelNow(const SetOfCallbacks& pCallbacks,
+                                                               const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                               Historical* pGlobalHistorical)
+{
+  _caches->refreshIfNeeded(_domain);
+  return _actionsToDoInParallelNow(_problem, _domain, pCallbacks, pNow, pGlobalHistorical, &*_caches);
+}
+
+
+ActionsToDoInParallel PlannerSession::actionsToDoInParallelNow(const SetOfCallbacks& pCallbacks,
+                                                               const PlanningBudget& pBudget,
+                                                               PlanningStatus& pStatus,
+                                                               const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                               Historical* pGlobalHistorical)
+{
+  _caches->refreshIfNeeded(_domain);
+  SearchLimits searchLimits(pBudget);
+  auto res = _actionsToDoInParallelNow(_problem, _domain, pCallbacks, pNow, pGlobalHistorical, &*_caches, &searchLimits);
+  pStatus = searchLimits.status();
+  return res;
+}
+
+
+ActionsToDoInParallel PlannerSession::actionsToDoInParallelNow(const SetOfCallbacks& pCallbacks,
+                                                               const SearchStrategy& pSearchStrategy,
+                                                               const PlanningBudget& pBudget,
+                                                               PlanningStatus& pStatus,
+                                                               const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                                               Historical* pGlobalHistorical)
+{
+  _caches->refreshIfNeeded(_domain);
+  SearchLimits searchLimits(pBudget);
+  auto res = _actionsToDoInParallelNow(_problem, _domain, pCallbacks, pNow, pGlobalHistorical, &*_caches, &searchLimits,
+                                       &pSearchStrategy);
+  pStatus = searchLimits.status();
+  return res;
+}
+
+
+void PlannerSession::clearCaches()
+{
+  _caches->clear();
+}
+
+
+CacheStatistics PlannerSession::transpositionTableStatistics() const
+{
+  const auto& transpositionTable = _caches->transpositionTable();
+  CacheStatistics res;
+  res.nbOfHits = transpositionTable.nbOfHits();
+  res.nbOfMisses = transpositionTable.nbOfMisses();
+  res.nbOfEntries = transpositionTable.size();
+  res.maxNbOfEntries = transpositionTable.maxNbOfEntries();
+  return res;
+}
+
+
+void PlannerSession::setPlanCacheCapacity(std::size_t pMaxNbOfPlans)
+{
+  _caches->planCache().setMaxNbOfPlans(pMaxNbOfPlans);
+}
+
+
+CacheStatistics PlannerSession::planCacheStatistics() const
+{
+  const auto& planCache = _caches->planCache();
+  CacheStatistics res;
+  res.nbOfHits = planCache.nbOfHits();
+  res.nbOfMisses = planCache.nbOfMisses();
+  res.nbOfEntries = planCache.size();
+  res.maxNbOfEntries = planCache.maxNbOfPlans();
+  return res;
+}
+
+
+CacheStatistics PlannerSession::forwardSearchGroundingStatistics() const
+{
+  const auto& grounding = _caches->forwardSearchGrounding();
+  CacheStatistics res;
+  res.nbOfHits = grounding.nbOfHits();
+  res.nbOfMisses = grounding.nbOfMisses();
+  res.nbOfEntries = grounding.groundActions.size();
+  res.maxNbOfEntries = grounding.maxNbOfGroundActions();
+  return res;
+}
+
+
+void PlannerSession::setNbOfThreadsToEvaluateCandidateActions(std::size_t pNbOfThreads)
+{
+  _caches->setNbOfThreads(pNbOfThreads);
+}
+
 } // !ogp
@@ -483,7 +483,7 @@ ContinueOrBreak ConditionNode::forAll(const std::function<ContinueOrBreak (const
                                       bool pIgnoreValue,
                                       bool pOnlyMandatoryFacts) const
 {
-  if (pOnlyMandatoryFacts && nodeType == ConditionNodeType::OR)
+  if (pOnlyMandatoryFacts && (nodeType == ConditionNodeType::OR || nodeType == ConditionNodeType::IMPLY))
     return ContinueOrBreak::CONTINUE;
   bool ignoreValue = pIgnoreValue || (nodeType != ConditionNodeType::AND &&
       nodeType != ConditionNodeType::OR && nodeType != ConditionNodeType::IMPLY);
@@ -710,6 +710,15 @@ bool ConditionNode::isTrue(const WorldState& pWorldState,
         if (rightNbPtr != nullptr)
         {
           const auto& factsMapping = pWorldState.factsMapping();
+          auto leftNbOpt = factsMapping.getFluentNumber(leftFact);
+          if (leftNbOpt)
+          {
+            bool res = compNb(*leftNbOpt, rightNbPtr->nb, canBeSuperior(nodeType), canBeEqual(nodeType));
+            if (!pIsWrappingExpressionNegated)
+              return res;
+            return !res;
+          }
+
           auto leftFactMatchingInWs = factsMapping.find(leftFact);
           for (const auto& currWsFact : leftFactMatchingInWs)
           {
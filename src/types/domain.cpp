@@ -30,6 +30,7 @@ struct ActionWithConditionAndFactFacts
     : actionId(pActionId),
       action(pAction),
       factsFromCondition(),
+      mandatoryFactsFromCondition(),
       factsFromEffect(),
       invertSuccessionsFromActions(),
       invertSuccessionsFromEvents()
@@ -40,7 +41,7 @@ struct ActionWithConditionAndFactFacts
   {
     for (auto& effectOptFact : factsFromEffect)
       if (!effectOptFact.factOpt.fact.hasAParameter(false))
-        for (auto& otherCondOptFact : pOther.factsFromCondition)
+        for (auto& otherCondOptFact : pOther.mandatoryFactsFromCondition)
           if (effectOptFact.factOpt.isFactNegated != otherCondOptFact.factOpt.isFactNegated &&
               effectOptFact.factOpt.fact == otherCondOptFact.factOpt.fact)
             return true;
@@ -61,7 +62,7 @@ struct ActionWithConditionAndFactFacts
             return true;
 
       if (!effectOptFact.factOpt.fact.value() || !effectOptFact.factOpt.fact.value()->isAParameterToFill())
-        for (auto& otherCondOptFact : pOther.factsFromCondition)
+        for (auto& otherCondOptFact : pOther.mandatoryFactsFromCondition)
           if (effectOptFact.factOpt.isFactNegated != otherCondOptFact.factOpt.isFactNegated &&
               effectOptFact.factOpt.fact == otherCondOptFact.factOpt.fact)
             return false;
@@ -88,6 +89,8 @@ struct ActionWithConditionAndFactFacts
   ActionId actionId;
   Action& action;
   std::set<FactOptionalAndValueModification> factsFromCondition;
+  /// Facts of the condition that are needed whatever the alternatives of the condition.
+  std::set<FactOptionalAndValueModification> mandatoryFactsFromCondition;
   std::set<FactOptionalAndValueModification> factsFromEffect;
   std::set<ActionId> invertSuccessionsFromActions;
   std::set<FullEventId> invertSuccessionsFromEvents;
@@ -357,6 +360,11 @@ void Domain::_updateSuccessions()
 
     ActionWithConditionAndFactFacts tmpData(currAction.first, action);
     tmpData.factsFromCondition = action.precondition ? action.precondition->getAllOptFacts() : std::set<FactOptionalAndValueModification>();
+    if (action.precondition)
+      action.precondition->forAll([&](const FactOptionalAndValueModification& pFactOptional, bool) {
+        tmpData.mandatoryFactsFromCondition.insert(pFactOptional);
+        return ContinueOrBreak::CONTINUE;
+      }, false, false, true);
     tmpData.factsFromEffect = action.effect.getAllOptFactsThatCanBeModified();
     action.updateSuccessionCache(*this, currAction.first, tmpData.factsFromCondition);
     actionTmpData.emplace(currAction.first, std::move(tmpData));
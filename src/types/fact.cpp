@@ -1,9 +1,12 @@
 #include <orderedgoalsplanner/types/fact.hpp>
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <assert.h>
 #include <optional>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 #include <orderedgoalsplanner/types/factoptional.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
 #include <orderedgoalsplanner/types/parameter.hpp>
@@ -23,6 +26,30 @@ Fact _expressionParsedToFact(const ExpressionParsed& pExpressionParsed,
                              bool pIsOkIfValueIsMissing,
                              const std::map<std::string, Entity>* pParameterNamesToEntityPtr);
 
+/**
+ * Intern a fact signature.<br/>
+ * The signatures only depend on the predicates and on the types, so the number of interned signatures stays small.
+ * Each thread keeps the signatures it already interned, so the lock is only taken the first time a thread sees a signature.
+ * @return The interned signature. The reference stays valid until the end of the process.
+ */
+const std::string& _internFactSignature(const std::string& pSignature)
+{
+  thread_local std::unordered_map<std::string, const std::string*> signaturesOfThisThread;
+  auto it = signaturesOfThisThread.find(pSignature);
+  if (it != signaturesOfThisThread.end())
+    return *it->second;
+
+  static std::mutex mutex;
+  static std::unordered_set<std::string> signatures;
+  const std::string* resPtr = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    resPtr = &*signatures.insert(pSignature).first;
+  }
+  signaturesOfThisThread.emplace(pSignature, resPtr);
+  return *resPtr;
+}
+
 void _entitiesToStr(std::string& pStr,
                     const std::vector<FactArgument>& pParameters)
 {
@@ -289,12 +316,11 @@ Fact::Fact(const std::string& pStr,
            std::size_t pBeginPos,
            std::size_t* pResPos,
            bool pIsOkIfValueIsMissing)
-  : predicate("_not_set", pStrPddlFormated, pOntology.types),
-    _name(),
+  : _predicatePtr(),
     _arguments(),
     _value(),
     _isValueNegated(false),
-    _factSignature()
+    _factSignaturePtr(nullptr)
 {
   std::size_t pos = pBeginPos;
   try
@@ -339,22 +365,19 @@ Fact::Fact(const std::string& pName,
            const std::vector<Parameter>& pParameters,
            bool pIsOkIfValueIsMissing,
            const std::map<std::string, Entity>* pParameterNamesToEntityPtr)
-  : predicate("_not_set", true, pOntology.types),
-    _name(pName),
+  : _predicatePtr(pOntology.nameToPredicateSharedPtr(pName)),
     _arguments(pArguments),
     _value(),
     _isValueNegated(pIsValueNegated),
-    _factSignature()
+    _factSignaturePtr(nullptr)
 {
-  auto* predicatePtr = pOntology.nameToPredicatePtr(_name);
-  if (predicatePtr == nullptr)
+  if (!_predicatePtr)
     throw std::runtime_error("\"" + pName + "\" is not a predicate name or a derived predicate name");
 
-  predicate = *predicatePtr;
   if (!pValueStr.empty())
     _value = Entity::fromUsage(pValueStr, pOntology, pObjects, pParameters, pParameterNamesToEntityPtr);
-  else if (pIsOkIfValueIsMissing && predicate.value)
-    _value = Entity(Entity::anyEntityValue(), predicate.value);
+  else if (pIsOkIfValueIsMissing && _predicatePtr->value)
+    _value = Entity(Entity::anyEntityValue(), _predicatePtr->value);
   _finalizeInisilizationAndValidityChecks(pIsOkIfValueIsMissing);
   _resetFactSignatureCache();
 }
@@ -365,18 +388,15 @@ Fact::Fact(std::string pName,
            bool pIsValueNegated,
            const Ontology& pOntology,
            bool pIsOkIfValueIsMissing)
-  : predicate("_not_set", true, pOntology.types),
-    _name(std::move(pName)),
+  : _predicatePtr(pOntology.nameToPredicateSharedPtr(pName)),
     _arguments(std::move(pArguments)),
     _value(std::move(pValue)),
     _isValueNegated(pIsValueNegated),
-    _factSignature()
+    _factSignaturePtr(nullptr)
 {
-  auto* predicatePtr = pOntology.nameToPredicatePtr(_name);
-  if (predicatePtr == nullptr)
-    throw std::runtime_error("\"" + _name + "\" is not a predicate name");
+  if (!_predicatePtr)
+    throw std::runtime_error("\"" + pName + "\" is not a predicate name");
 
-  predicate = *predicatePtr;
   _finalizeInisilizationAndValidityChecks(pIsOkIfValueIsMissing);
   _resetFactSignatureCache();
 }
@@ -387,66 +407,59 @@ Fact::~Fact()
 }
 
 Fact::Fact(const Fact& pOther)
-  : predicate(pOther.predicate),
-    _name(pOther._name),
+  : _predicatePtr(pOther._predicatePtr),
     _arguments(pOther._arguments),
     _value(pOther._value),
     _isValueNegated(pOther._isValueNegated),
-    _factSignature(pOther._factSignature)
+    _factSignaturePtr(pOther._factSignaturePtr)
 {
 }
 
 Fact::Fact(Fact&& pOther) noexcept
-  : predicate(std::move(pOther.predicate)),
-    _name(std::move(pOther._name)),
+  : _predicatePtr(pOther._predicatePtr), // Copied to keep the moved fact valid
     _arguments(std::move(pOther._arguments)),
     _value(std::move(pOther._value)),
     _isValueNegated(std::move(pOther._isValueNegated)),
-    _factSignature(std::move(pOther._factSignature))
+    _factSignaturePtr(pOther._factSignaturePtr)
 {
 }
 
 Fact& Fact::operator=(const Fact& pOther) {
-  predicate = pOther.predicate;
-  _name = pOther._name;
+  _predicatePtr = pOther._predicatePtr;
   _arguments = pOther._arguments;
   _value = pOther._value;
   _isValueNegated = pOther._isValueNegated;
-  _factSignature = pOther._factSignature;
+  _factSignaturePtr = pOther._factSignaturePtr;
   return *this;
 }
 
 Fact& Fact::operator=(Fact&& pOther) noexcept {
-    predicate = std::move(pOther.predicate);
-    _name = std::move(pOther._name);
+    _predicatePtr = pOther._predicatePtr;
     _arguments = std::move(pOther._arguments);
     _value = std::move(pOther._value);
     _isValueNegated = std::move(pOther._isValueNegated);
-    _factSignature = std::move(pOther._factSignature);
+    _factSignaturePtr = pOther._factSignaturePtr;
     return *this;
 }
 
 
 bool Fact::operator<(const Fact& pOther) const
 {
-  if (_name != pOther._name)
-    return _name < pOther._name;
+  if (name() != pOther.name())
+    return name() < pOther.name();
   if (_value != pOther._value)
     return _value < pOther._value;
   if (_isValueNegated != pOther._isValueNegated)
     return _isValueNegated < pOther._isValueNegated;
-  std::string paramStr;
-  _entitiesToStr(paramStr, _arguments);
-  std::string otherParamStr;
-  _entitiesToStr(otherParamStr, pOther._arguments);
-  return paramStr < otherParamStr;
+  return std::lexicographical_compare(_arguments.begin(), _arguments.end(),
+                                      pOther._arguments.begin(), pOther._arguments.end());
 }
 
 bool Fact::operator==(const Fact& pOther) const
 {
-  return _name == pOther._name && _arguments == pOther._arguments &&
+  return name() == pOther.name() && _arguments == pOther._arguments &&
       _value == pOther._value && _isValueNegated == pOther._isValueNegated &&
-      predicate == pOther.predicate;
+      (_predicatePtr == pOther._predicatePtr || *_predicatePtr == *pOther._predicatePtr);
 }
 
 
@@ -461,7 +474,7 @@ bool Fact::areEqualWithoutValueConsideration(const Fact& pFact,
                                               const ParameterValuesWithConstraints* pOtherFactParametersToConsiderAsAnyValuePtr2,
                                               const SetOfFacts* pSetOfFactsPtr) const
 {
-  if (pFact._name != _name ||
+  if (pFact.name() != name() ||
       pFact._arguments.size() != _arguments.size())
     return false;
 
@@ -484,7 +497,7 @@ bool Fact::areEqualWithoutValueConsideration(const Fact& pFact,
 bool Fact::areEqualWithoutAnArgConsideration(const Fact& pFact,
                                              const std::string& pArgToIgnore) const
 {
-  if (pFact._name != _name ||
+  if (pFact.name() != name() ||
       pFact._arguments.size() != _arguments.size() ||
       pFact._value != _value)
     return false;
@@ -507,7 +520,7 @@ bool Fact::areEqualWithoutAnArgConsideration(const Fact& pFact,
 bool Fact::areEqualWithoutArgsAndValueConsideration(const Fact& pFact,
                                                      const std::list<Parameter>* pParametersToIgnorePtr) const
 {
-  if (pFact._name != _name ||
+  if (pFact.name() != name() ||
       pFact._arguments.size() != _arguments.size())
     return false;
 
@@ -547,7 +560,7 @@ bool Fact::areEqualWithoutArgsAndValueConsideration(const Fact& pFact,
 bool Fact::areEqualExceptAnyParameters(const Fact& pOther,
                                        bool pIgnoreValue) const
 {
-  if (_name != pOther._name || _arguments.size() != pOther._arguments.size())
+  if (name() != pOther.name() || _arguments.size() != pOther._arguments.size())
     return false;
 
   auto itParam = _arguments.begin();
@@ -582,7 +595,7 @@ bool Fact::areEqualExceptAnyEntities(const Fact& pOther,
                                      const std::vector<Parameter>* pThisFactParametersToConsiderAsAnyValuePtr,
                                      const SetOfFacts* pSetOfFactsPtr) const
 {
-  if (_name != pOther._name || _arguments.size() != pOther._arguments.size())
+  if (name() != pOther.name() || _arguments.size() != pOther._arguments.size())
     return false;
 
   auto itParam = _arguments.begin();
@@ -623,7 +636,7 @@ bool Fact::areEqualExceptAnyEntitiesAndValue(const Fact& pOther,
                                              const ParameterValuesWithConstraints* pOtherFactParametersToConsiderAsAnyValuePtr2,
                                              const SetOfFacts* pSetOfFactsPtr) const
 {
-  if (_name != pOther._name || _arguments.size() != pOther._arguments.size())
+  if (name() != pOther.name() || _arguments.size() != pOther._arguments.size())
     return false;
 
   auto itParam = _arguments.begin();
@@ -647,7 +660,7 @@ bool Fact::areEqualExceptAnyEntitiesAndValue(const Fact& pOther,
 
 bool Fact::areEqualExceptParametersAndValue(const Fact& pOther) const
 {
-  if (_name != pOther._name || _arguments.size() != pOther._arguments.size())
+  if (name() != pOther.name() || _arguments.size() != pOther._arguments.size())
     return false;
 
   auto itParam = _arguments.begin();
@@ -665,7 +678,7 @@ bool Fact::areEqualExceptParametersAndValue(const Fact& pOther) const
 
 bool Fact::doesFactEffectOfSuccessorGiveAnInterestForSuccessor(const Fact& pFact) const
 {
-  if (pFact._name != _name ||
+  if (pFact.name() != name() ||
       (pFact._arguments.size() != _arguments.size() &&
        pFact._value.has_value() == _value.has_value()))
     return true;
@@ -689,7 +702,7 @@ bool Fact::doesFactEffectOfSuccessorGiveAnInterestForSuccessor(const Fact& pFact
 bool Fact::isPunctual() const
 {
   const auto& punctualPrefix = getPunctualPrefix();
-  return _name.compare(0, punctualPrefix.size(), punctualPrefix) == 0;
+  return name().compare(0, punctualPrefix.size(), punctualPrefix) == 0;
 }
 
 
@@ -761,7 +774,7 @@ std::optional<Entity> Fact::tryToExtractArgumentFromExample(const Parameter& pPa
                                                             const Fact& pExampleFact,
                                                             const SetOfFacts* pSetOfFactsPtr) const
 {
-  if (_name != pExampleFact._name ||
+  if (name() != pExampleFact.name() ||
       _isValueNegated != pExampleFact._isValueNegated ||
       _arguments.size() != pExampleFact._arguments.size())
     return {};
@@ -789,7 +802,7 @@ std::optional<Entity> Fact::tryToExtractArgumentFromExampleWithoutValueConsidera
     const Fact& pExampleFact,
     const SetOfFacts* pSetOfFactsPtr) const
 {
-  if (_name != pExampleFact._name ||
+  if (name() != pExampleFact.name() ||
       _isValueNegated != pExampleFact._isValueNegated ||
       _arguments.size() != pExampleFact._arguments.size())
     return {};
@@ -841,7 +854,7 @@ void Fact::replaceArguments(const ParameterValuesWithConstraints& pCurrentArgume
 std::string Fact::toPddl(bool pInEffectContext,
                          bool pPrintAnyValue) const
 {
-  std::string res = "(" + _name;
+  std::string res = "(" + name();
   if (!_arguments.empty())
   {
     res += " ";
@@ -876,7 +889,7 @@ std::string Fact::toPddl(bool pInEffectContext,
 
 std::string Fact::toStr(bool pPrintAnyValue) const
 {
-  std::string res = _name;
+  std::string res = name();
   if (!_arguments.empty())
   {
     res += "(";
@@ -1038,7 +1051,7 @@ bool Fact::filterPossibilities(const Fact& pOtherFact,
                                const ParameterValuesWithConstraints& pParameters,
                                const SetOfFacts* pSetOfFactsPtr) const
 {
-  if (pOtherFact._name != _name ||
+  if (pOtherFact.name() != name() ||
       pOtherFact._arguments.size() != _arguments.size())
     return false;
 
@@ -1125,7 +1138,7 @@ bool Fact::isInOtherFact(const Fact& pOtherFact,
                          const ParameterValuesWithConstraints* pParametersToModifyInPlacePtr,
                          const SetOfFacts* pSetOfFactsPtr) const
 {
-  if (pOtherFact._name != _name ||
+  if (pOtherFact.name() != name() ||
       pOtherFact._arguments.size() != _arguments.size())
     return false;
 
@@ -1246,22 +1259,22 @@ void Fact::replaceArgument(const Entity& pCurrent,
 
 std::map<Parameter, Entity> Fact::extratParameterToArguments() const
 {
-  if (_arguments.size() == predicate.parameters.size())
+  if (_arguments.size() == _predicatePtr->parameters.size())
   {
     std::map<Parameter, Entity> res;
     for (auto i = 0; i < _arguments.size(); ++i)
     {
       if (!_arguments[i].isEntity())
         throw std::runtime_error("Cannot extract fluent argument \"" + _arguments[i].toStr() + "\" as an entity from fact: " + toStr());
-      res.emplace(predicate.parameters[i], _arguments[i].entity());
+      res.emplace(_predicatePtr->parameters[i], _arguments[i].entity());
     }
 
-    if (_value && predicate.value)
+    if (_value && _predicatePtr->value)
     {
-      res.emplace(Parameter::fromType(predicate.value), *_value);
+      res.emplace(Parameter::fromType(_predicatePtr->value), *_value);
       return res;
     }
-    if (!_value && !predicate.value)
+    if (!_value && !_predicatePtr->value)
       return res;
     throw std::runtime_error("Value difference between fact and predicate: " + toStr());
   }
@@ -1269,19 +1282,19 @@ std::map<Parameter, Entity> Fact::extratParameterToArguments() const
 }
 
 
-std::string Fact::factSignature() const
+const std::string& Fact::factSignature() const
 {
-  if (_factSignature != "")
-    return _factSignature;
+  if (_factSignaturePtr != nullptr)
+    return *_factSignaturePtr;
 
   if (ORDEREDGOALSPLANNER_DEBUG_FOR_TESTS)
     throw std::runtime_error("_factSignature2 is not set");
-  return _generateFactSignature();
+  return _internFactSignature(_generateFactSignature());
 }
 
 std::string Fact::_generateFactSignature() const
 {
-  auto res = _name;
+  auto res = name();
   res += "(";
   bool firstArg = true;
   for (const auto& currArg : _arguments)
@@ -1332,7 +1345,7 @@ void Fact::generateSignaturesWithRelatedTypes(
           newRes += ", ";
         newRes += currElt->name;
       }
-      pSignatureCallback(_name + "(" + newRes + ")");
+      pSignatureCallback(name() + "(" + newRes + ")");
       return;
     }
 
@@ -1373,7 +1386,7 @@ void Fact::setValueFromStr(const std::string& pValueStr)
   if (_value)
     _value->value = pValueStr;
   else
-    _value = Entity(pValueStr, predicate.value);
+    _value = Entity(pValueStr, _predicatePtr->value);
   _resetFactSignatureCache();
 }
 
@@ -1391,10 +1404,24 @@ bool Fact::isCompleteWithAnyEntityValue() const
 
 void Fact::toImmutable()
 {
-  if (!predicate.isImmutable())
+  if (!_predicatePtr->isImmutable())
   {
-    predicate = predicate.createImmutableCopy();
-    _name = predicate.name;
+    _predicatePtr = std::make_shared<const Predicate>(_predicatePtr->createImmutableCopy());
+    _resetFactSignatureCache();
+  }
+}
+
+void Fact::toImmutable(const Ontology& pOntology)
+{
+  if (!_predicatePtr->isImmutable())
+  {
+    auto immutablePredicatePtr = pOntology.nameToPredicateSharedPtr(Predicate::getImmutablePrefix() + name());
+    if (!immutablePredicatePtr)
+    {
+      toImmutable();
+      return;
+    }
+    _predicatePtr = std::move(immutablePredicatePtr);
     _resetFactSignatureCache();
   }
 }
@@ -1415,35 +1442,50 @@ const std::string& Fact::getPunctualPrefix()
 
 void Fact::_resetFactSignatureCache()
 {
-  _factSignature = _generateFactSignature();
+  _factSignaturePtr = &_internFactSignature(_generateFactSignature());
 }
 
 
 void Fact::_finalizeInisilizationAndValidityChecks(bool pIsOkIfValueIsMissing)
 {
   static const bool inEffectContext = false;
-  if (predicate.parameters.size() != _arguments.size())
-    throw std::runtime_error("The fact \"" + toPddl(inEffectContext) + "\" does not have the same number of parameters than the associated predicate \"" + predicate.toPddl() + "\"");
+  // The predicate is shared with the ontology, it is copied only if the types have to be narrowed for this fact
+  std::shared_ptr<Predicate> narrowedPredicatePtr;
+  auto getPredicateToNarrow = [&]() -> Predicate& {
+    if (!narrowedPredicatePtr)
+      narrowedPredicatePtr = std::make_shared<Predicate>(*_predicatePtr);
+    return *narrowedPredicatePtr;
+  };
+  auto getPredicate = [&]() -> const Predicate& {
+    return narrowedPredicatePtr ? *narrowedPredicatePtr : *_predicatePtr;
+  };
+
+  if (getPredicate().parameters.size() != _arguments.size())
+    throw std::runtime_error("The fact \"" + toPddl(inEffectContext) + "\" does not have the same number of parameters than the associated predicate \"" + getPredicate().toPddl() + "\"");
   for (auto i = 0; i < _arguments.size(); ++i)
   {
-    if (!predicate.parameters[i].type)
-      throw std::runtime_error("\"" + predicate.parameters[i].name + "\" does not have a type, in fact predicate \"" + predicate.toPddl() + "\"");
+    const auto& currParameter = getPredicate().parameters[i];
+    if (!currParameter.type)
+      throw std::runtime_error("\"" + currParameter.name + "\" does not have a type, in fact predicate \"" + getPredicate().toPddl() + "\"");
     auto currArgType = _arguments[i].type();
     if (!currArgType && !_arguments[i].isAnyEntity())
       throw std::runtime_error("\"" + _arguments[i].toStr() + "\" does not have a type");
     if (_arguments[i].isAParameterToFill())
     {
-      predicate.parameters[i].type = Type::getSmallerType(currArgType, predicate.parameters[i].type);
-      _arguments[i].entity().type = predicate.parameters[i].type;
+      auto smallerType = Type::getSmallerType(currArgType, currParameter.type);
+      if (smallerType != currParameter.type)
+        getPredicateToNarrow().parameters[i].type = smallerType;
+      _arguments[i].entity().type = smallerType;
       continue;
     }
-    if (_arguments[i].isFluent() && !_arguments[i].fluent()->predicate.value)
-      throw std::runtime_error("The fluent \"" + _arguments[i].toPddl() + "\" used as parameter of \"" + predicate.toPddl() + "\" does not return a value");
-    if (!currArgType || !currArgType->isA(*predicate.parameters[i].type))
-      throw std::runtime_error("\"" + _arguments[i].toStr() + "\" is not a \"" + predicate.parameters[i].type->name + "\" for predicate: \"" + predicate.toPddl() + "\"");
+    if (_arguments[i].isFluent() && !_arguments[i].fluent()->predicate().value)
+      throw std::runtime_error("The fluent \"" + _arguments[i].toPddl() + "\" used as parameter of \"" + getPredicate().toPddl() + "\" does not return a value");
+    if (!currArgType || !currArgType->isA(*currParameter.type))
+      throw std::runtime_error("\"" + _arguments[i].toStr() + "\" is not a \"" + currParameter.type->name + "\" for predicate: \"" + getPredicate().toPddl() + "\"");
   }
 
-  if (predicate.value)
+  const auto& predicateValue = getPredicate().value;
+  if (predicateValue)
   {
     if (_value)
     {
@@ -1452,25 +1494,30 @@ void Fact::_finalizeInisilizationAndValidityChecks(bool pIsOkIfValueIsMissing)
 
       if (_value->isAParameterToFill())
       {
-        predicate.value = Type::getSmallerType(_value->type, predicate.value);
-        _value->type = predicate.value;
+        auto smallerType = Type::getSmallerType(_value->type, predicateValue);
+        if (smallerType != predicateValue)
+          getPredicateToNarrow().value = smallerType;
+        _value->type = smallerType;
       }
       else
       {
-        if (!_value->type->isA(*predicate.value))
-          throw std::runtime_error("\"" + _value->toStr() + "\" is not a \"" + predicate.value->name + "\" for predicate: \"" + predicate.toPddl() + "\"");
+        if (!_value->type->isA(*predicateValue))
+          throw std::runtime_error("\"" + _value->toStr() + "\" is not a \"" + predicateValue->name + "\" for predicate: \"" + getPredicate().toPddl() + "\"");
       }
     }
     else if (!pIsOkIfValueIsMissing)
     {
-      throw std::runtime_error("The value of this fluent \"" + toPddl(inEffectContext) + "\" is missing. The associated function is \"" + predicate.toPddl() + "\"");
+      throw std::runtime_error("The value of this fluent \"" + toPddl(inEffectContext) + "\" is missing. The associated function is \"" + getPredicate().toPddl() + "\"");
     }
 
   }
   else if (_value)
   {
-    throw std::runtime_error("This fact \"" + toPddl(inEffectContext) + "\" should not have a value. The associated predicate is \"" + predicate.toPddl() + "\"");
+    throw std::runtime_error("This fact \"" + toPddl(inEffectContext) + "\" should not have a value. The associated predicate is \"" + getPredicate().toPddl() + "\"");
   }
+
+  if (narrowedPredicatePtr)
+    _predicatePtr = std::move(narrowedPredicatePtr);
 }
 
 
@@ -129,7 +129,7 @@ std::shared_ptr<Type> FactArgument::type() const
   if (_entity)
     return _entity->type;
   if (_fluentArg)
-    return _fluentArg->predicate.value;
+    return _fluentArg->predicate().value;
   return {};
 }
 
@@ -0,0 +1,128 @@
+#include <orderedgoalsplanner/types/factid.hpp>
+#include <stdexcept>
+#include <orderedgoalsplanner/types/fact.hpp>
+
+namespace ogp
+{
+namespace
+{
+
+void _combineSymbolInHash(std::size_t& pHash,
+                          SymbolId pSymbolId)
+{
+  pHash ^= pSymbolId + 0x9e3779b9 + (pHash << 6) + (pHash >> 2);
+}
+
+}
+
+
+SymbolId FactIdTable::getOrCreateSymbolId(const std::string& pStr)
+{
+  auto insertionRes = _strToSymbolId.emplace(pStr, static_cast<SymbolId>(_symbolIdToStr.size()));
+  if (insertionRes.second)
+    _symbolIdToStr.emplace_back(pStr);
+  return insertionRes.first->second;
+}
+
+
+std::optional<SymbolId> FactIdTable::getSymbolId(const std::string& pStr) const
+{
+  auto it = _strToSymbolId.find(pStr);
+  if (it != _strToSymbolId.end())
+    return it->second;
+  return {};
+}
+
+
+const std::string& FactIdTable::symbolToStr(SymbolId pSymbolId) const
+{
+  if (pSymbolId >= _symbolIdToStr.size())
+    throw std::runtime_error("Unknown symbol identifier: " + std::to_string(pSymbolId));
+  return _symbolIdToStr[pSymbolId];
+}
+
+
+std::optional<FactId> FactIdTable::getOrCreateFactId(const Fact& pFact)
+{
+  if (!isGround(pFact))
+    return {};
+  auto factIdOpt = getFactId(pFact);
+  if (factIdOpt)
+    return factIdOpt;
+
+  std::vector<SymbolId> symbols;
+  symbols.reserve(pFact.arguments().size() + 1);
+  symbols.emplace_back(getOrCreateSymbolId(pFact.name()));
+  for (const auto& currArg : pFact.arguments())
+    symbols.emplace_back(getOrCreateSymbolId(currArg.entity().value));
+
+  std::size_t atomHash = symbols.size();
+  for (const auto& currSymbol : symbols)
+    _combineSymbolInHash(atomHash, currSymbol);
+  auto newFactId = static_cast<FactId>(_factIdToSymbols.size());
+  _factIdToSymbols.emplace_back(std::move(symbols));
+  _atomHashToFactIds.emplace(atomHash, newFactId);
+  return newFactId;
+}
+
+
+std::optional<FactId> FactIdTable::getFactId(const Fact& pFact) const
+{
+  if (!isGround(pFact))
+    return {};
+  auto atomHashOpt = _getAtomHash(pFact);
+  if (!atomHashOpt)
+    return {};
+
+  const auto& arguments = pFact.arguments();
+  auto itRange = _atomHashToFactIds.equal_range(*atomHashOpt);
+  for (auto it = itRange.first; it != itRange.second; ++it)
+  {
+    const auto& symbols = _factIdToSymbols[it->second];
+    if (symbols.size() != arguments.size() + 1 ||
+        _symbolIdToStr[symbols[0]] != pFact.name())
+      continue;
+    bool areArgumentsEqual = true;
+    for (std::size_t i = 0; i < arguments.size(); ++i)
+    {
+      if (_symbolIdToStr[symbols[i + 1]] != arguments[i].entity().value)
+      {
+        areArgumentsEqual = false;
+        break;
+      }
+    }
+    if (areArgumentsEqual)
+      return it->second;
+  }
+  return {};
+}
+
+
+bool FactIdTable::isGround(const Fact& pFact)
+{
+  for (const auto& currArg : pFact.arguments())
+    if (!currArg.isEntity() || currArg.isAParameterToFill())
+      return false;
+  return true;
+}
+
+
+std::optional<std::size_t> FactIdTable::_getAtomHash(const Fact& pFact) const
+{
+  std::size_t res = pFact.arguments().size() + 1;
+  auto predicateSymbolOpt = getSymbolId(pFact.name());
+  if (!predicateSymbolOpt)
+    return {};
+  _combineSymbolInHash(res, *predicateSymbolOpt);
+  for (const auto& currArg : pFact.arguments())
+  {
+    auto argSymbolOpt = getSymbolId(currArg.entity().value);
+    if (!argSymbolOpt)
+      return {};
+    _combineSymbolInHash(res, *argSymbolOpt);
+  }
+  return res;
+}
+
+
+} // !ogp
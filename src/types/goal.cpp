@@ -20,6 +20,47 @@ std::unique_ptr<Condition> _sanitizeGoalObjective(std::unique_ptr<Condition> pOb
   return pObjective;
 }
 
+
+bool _addWatchedPredicates(std::set<std::string>& pRes,
+                           const Fact& pFact)
+{
+  pRes.insert(pFact.name());
+  for (const auto& currArg : pFact.arguments())
+    if (currArg.isFluent())
+      _addWatchedPredicates(pRes, *currArg.fluent());
+  return true;
+}
+
+/// Get the predicates that the satisfaction of a condition depends on, false if it also depends on the entities.
+bool _addWatchedPredicates(std::set<std::string>& pRes,
+                           const Condition& pCondition)
+{
+  const auto* nodePtr = pCondition.fcNodePtr();
+  if (nodePtr != nullptr)
+    return (!nodePtr->leftOperand || _addWatchedPredicates(pRes, *nodePtr->leftOperand)) &&
+        (!nodePtr->rightOperand || _addWatchedPredicates(pRes, *nodePtr->rightOperand));
+
+  const auto* notPtr = pCondition.fcNotPtr();
+  if (notPtr != nullptr)
+    return !notPtr->condition || _addWatchedPredicates(pRes, *notPtr->condition);
+
+  const auto* factPtr = pCondition.fcFactPtr();
+  if (factPtr != nullptr)
+    return _addWatchedPredicates(pRes, factPtr->factOptional.fact);
+
+  // The quantifiers iterate over the entities, so they do not only depend on the facts
+  return pCondition.fcNbPtr() != nullptr;
+}
+
+
+std::vector<std::string> _watchedPredicatesOf(const Condition& pObjective)
+{
+  std::set<std::string> res;
+  if (!_addWatchedPredicates(res, pObjective))
+    return {};
+  return std::vector<std::string>(res.begin(), res.end());
+}
+
 }
 
 Goal::Goal(std::unique_ptr<Condition> pObjective,
@@ -38,9 +79,13 @@ Goal::Goal(std::unique_ptr<Condition> pObjective,
     _cacheOfActionsThatCanSatisfyThisGoal(),
     _cacheOfEventsIdThatCanSatisfyThisGoal(),
     _cacheOfActionsPredecessors(),
-    _cacheOfEventsPredecessors()
+    _cacheOfEventsPredecessors(),
+    _watchedPredicates(),
+    _satisfactionCache(),
+    _satisfactionCacheMutex()
 {
   assert(_objective);
+  _watchedPredicates = _watchedPredicatesOf(*_objective);
 }
 
 
@@ -57,7 +102,10 @@ Goal::Goal(const Goal& pOther,
     _cacheOfActionsThatCanSatisfyThisGoal(pOther._cacheOfActionsThatCanSatisfyThisGoal),
     _cacheOfEventsIdThatCanSatisfyThisGoal(pOther._cacheOfEventsIdThatCanSatisfyThisGoal),
     _cacheOfActionsPredecessors(pOther._cacheOfActionsPredecessors),
-    _cacheOfEventsPredecessors(pOther._cacheOfEventsPredecessors)
+    _cacheOfEventsPredecessors(pOther._cacheOfEventsPredecessors),
+    _watchedPredicates(pOther._watchedPredicates),
+    _satisfactionCache(pParametersPtr == nullptr ? pOther._getSatisfactionCache() : SatisfactionCache()),
+    _satisfactionCacheMutex()
 {
 }
 
@@ -91,6 +139,10 @@ void Goal::operator=(const Goal& pOther)
   _cacheOfEventsIdThatCanSatisfyThisGoal = pOther._cacheOfEventsIdThatCanSatisfyThisGoal;
   _cacheOfActionsPredecessors = pOther._cacheOfActionsPredecessors;
   _cacheOfEventsPredecessors = pOther._cacheOfEventsPredecessors;
+  _watchedPredicates = pOther._watchedPredicates;
+  auto satisfactionCache = pOther._getSatisfactionCache();
+  std::lock_guard<std::mutex> lock(_satisfactionCacheMutex);
+  _satisfactionCache = satisfactionCache;
 }
 
 bool Goal::operator==(const Goal& pOther) const
@@ -301,6 +353,13 @@ bool Goal::canDeductionSatisfyThisGoal(const ActionId& pDeductionId) const
 }
 
 
+Goal::SatisfactionCache Goal::_getSatisfactionCache() const
+{
+  std::lock_guard<std::mutex> lock(_satisfactionCacheMutex);
+  return _satisfactionCache;
+}
+
+
 const std::string& Goal::getPersistFunctionName()
 {
   static const std::string persistFunctionName = "persist";
@@ -1,12 +1,14 @@
 #include <orderedgoalsplanner/types/goalstack.hpp>
 #include <map>
 #include <sstream>
+#include <stdexcept>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/actioninvocationwithgoal.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
 #include <orderedgoalsplanner/types/setofevents.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 #include <orderedgoalsplanner/types/lookforanactionoutputinfos.hpp>
+#include "../util/hash.hpp"
 
 
 namespace ogp
@@ -22,6 +24,7 @@ GoalStack::GoalStack(const GoalStack& pOther)
 
 GoalStack& GoalStack::operator=(const GoalStack& pOther)
 {
+  _saveGoalsBeforeModification();
   if (pOther.effectBetweenGoals)
     effectBetweenGoals = pOther.effectBetweenGoals->clone(nullptr);
   else
@@ -40,6 +43,7 @@ bool GoalStack::notifyActionDone(Problem& pProblem,
                                  const Domain& pDomain,
                                  LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr)
 {
+  _saveGoalsBeforeModification();
   bool goalChanged = false;
 
   // Remove current goal if it was one step towards
@@ -92,6 +96,7 @@ bool GoalStack::_iterateOnGoalsAndRemoveNonPersistent(
     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
     LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr)
 {
+  _saveGoalsBeforeModification();
   bool res = false;
   if (pLookForAnActionOutputInfosPtr != nullptr)
     pLookForAnActionOutputInfosPtr->setType(PlannerStepType::FINISHED_ON_SUCCESS);
@@ -227,6 +232,7 @@ void GoalStack::setGoals(const std::map<int, std::vector<Goal>>& pGoals,
 {
   if (_goals != pGoals)
   {
+    _saveGoalsBeforeModification();
     _currentGoalPtr = nullptr;
     {
       _goals = pGoals;
@@ -281,6 +287,7 @@ bool GoalStack::_addGoals(const std::map<int, std::vector<Goal>>& pGoals,
 {
   if (pGoals.empty())
     return false;
+  _saveGoalsBeforeModification();
   // Sub goalChanged object to notify about removed goals
   bool goalChanged = false;
   for (auto& currGoals : pGoals)
@@ -302,6 +309,7 @@ void GoalStack::pushFrontGoal(const Goal& pGoal,
                               const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
                               int pPriority)
 {
+  _saveGoalsBeforeModification();
   {
     auto& existingGoals = _goals[pPriority];
     existingGoals.insert(existingGoals.begin(), pGoal);
@@ -318,6 +326,7 @@ void GoalStack::pushBackGoal(const Goal& pGoal,
                              const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
                              int pPriority)
 {
+  _saveGoalsBeforeModification();
   {
     auto& existingGoals = _goals[pPriority];
     existingGoals.push_back(pGoal);
@@ -336,6 +345,7 @@ void GoalStack::changeGoalPriority(const std::string& pGoalStr,
                                    const SetOfEntities& pObjects,
                                    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
 {
+  _saveGoalsBeforeModification();
   std::unique_ptr<Goal> goalToMove;
   bool goalChanged = false;
   for (auto itGroup = _goals.begin(); itGroup != _goals.end(); )
@@ -386,6 +396,7 @@ void GoalStack::clearGoals(const WorldState& pWorldState,
   if (_goals.empty())
     return;
 
+  _saveGoalsBeforeModification();
   _goals.clear();
   _removeNoStackableGoals(pWorldState, pConstants, pObjects, pNow);
   onGoalsChanged(_goals);
@@ -405,6 +416,7 @@ bool GoalStack::removeGoals(const std::string& pGoalGroupId,
     {
       if (it->getGoalGroupId() == pGoalGroupId)
       {
+        _saveGoalsBeforeModification();
         it = itGroup->second.erase(it);
         goalChanged = true;
       }
@@ -415,9 +427,14 @@ bool GoalStack::removeGoals(const std::string& pGoalGroupId,
     }
 
     if (itGroup->second.empty())
+    {
+      _saveGoalsBeforeModification();
       itGroup = _goals.erase(itGroup);
+    }
     else
+    {
       ++itGroup;
+    }
   }
   if (goalChanged)
   {
@@ -452,6 +469,7 @@ std::map<int, std::vector<Goal>> GoalStack::getNotSatisfiedGoals(const WorldStat
 
 void GoalStack::refreshIfNeeded(const Domain& pDomain)
 {
+  // No need to save the goals for the checkpoints because it only refreshes caches that depend on the domain
   for (auto& currGoalsGroup : _goals)
     for (Goal& currGoal : currGoalsGroup.second)
       currGoal.refreshIfNeeded(pDomain);
@@ -523,6 +541,27 @@ bool GoalStack::isOrderedGoals() const
 }
 
 
+std::uint64_t GoalStack::hash() const
+{
+  std::uint64_t res = 0;
+  for (const auto& currGoalsWithPriority : _goals)
+  {
+    combineHash(res, static_cast<std::uint64_t>(currGoalsWithPriority.first));
+    for (const auto& currGoal : currGoalsWithPriority.second)
+    {
+      combineHash(res, hashStr(currGoal.toPddl(0)));
+      combineHash(res, hashStr(currGoal.getGoalGroupId()));
+      combineHash(res, currGoal.isPersistent() ? 1 : 0);
+      combineHash(res, currGoal.isOneStepTowards() ? 1 : 0);
+      combineHash(res, static_cast<std::uint64_t>(currGoal.getMaxTimeToKeepInactive()));
+      combineHash(res, currGoal.getInactiveSince() ? 1 : 0);
+    }
+  }
+  combineHash(res, effectBetweenGoals ? hashStr(effectBetweenGoals->toStr()) : 0);
+  return res;
+}
+
+
 void GoalStack::_removeNoStackableGoalsAndNotifyGoalsChanged(
     const WorldState& pWorldState,
     const SetOfEntities& pConstants,
@@ -561,18 +600,24 @@ bool GoalStack::_removeNoStackableGoals(const WorldState& pWorldState,
 
       if (!itGoal->isInactiveForTooLong(pNow))
       {
+        if (pNow)
+          _saveGoalsBeforeModification();
         itGoal->setInactiveSinceIfNotAlreadySet(pNow);
         ++itGoal;
       }
       else
       {
+        _saveGoalsBeforeModification();
         itGoal = itGoalsGroup->second.erase(itGoal);
         res = true;
       }
     }
 
     if (itGoalsGroup->second.empty())
+    {
+      _saveGoalsBeforeModification();
       itGoalsGroup = _goals.erase(itGoalsGroup);
+    }
   }
 
   return res;
@@ -580,4 +625,65 @@ bool GoalStack::_removeNoStackableGoals(const WorldState& pWorldState,
 
 
 
+GoalStack::Checkpoint GoalStack::checkpoint()
+{
+  Checkpoint res{_goalsBeforeCheckpoints.size()};
+  _goalsBeforeCheckpoints.emplace_back();
+  return res;
+}
+
+
+void GoalStack::rollbackTo(const Checkpoint& pCheckpoint)
+{
+  if (pCheckpoint.nbOfOpenCheckpointsBefore >= _goalsBeforeCheckpoints.size())
+    throw std::runtime_error("Cannot rollback to a checkpoint that is already closed");
+  const auto& snapshotPtr = _goalsBeforeCheckpoints[pCheckpoint.nbOfOpenCheckpointsBefore];
+  if (snapshotPtr)
+  {
+    _goals = snapshotPtr->goals;
+    _currentGoalPtr = nullptr;
+    if (snapshotPtr->currentGoalPosition)
+      _currentGoalPtr = &_goals[snapshotPtr->currentGoalPosition->first][snapshotPtr->currentGoalPosition->second];
+  }
+  _goalsBeforeCheckpoints.resize(pCheckpoint.nbOfOpenCheckpointsBefore);
+}
+
+
+void GoalStack::releaseCheckpoint(const Checkpoint& pCheckpoint)
+{
+  if (pCheckpoint.nbOfOpenCheckpointsBefore >= _goalsBeforeCheckpoints.size())
+    throw std::runtime_error("Cannot release a checkpoint that is already closed");
+  // The previous checkpoint was not modified before this checkpoint so it has the same snapshot
+  if (pCheckpoint.nbOfOpenCheckpointsBefore > 0)
+  {
+    auto& previousSnapshotPtr = _goalsBeforeCheckpoints[pCheckpoint.nbOfOpenCheckpointsBefore - 1];
+    if (!previousSnapshotPtr)
+      previousSnapshotPtr = _goalsBeforeCheckpoints[pCheckpoint.nbOfOpenCheckpointsBefore];
+  }
+  _goalsBeforeCheckpoints.resize(pCheckpoint.nbOfOpenCheckpointsBefore);
+}
+
+
+void GoalStack::_saveGoalsBeforeModification()
+{
+  if (_goalsBeforeCheckpoints.empty() || _goalsBeforeCheckpoints.back())
+    return;
+
+  auto snapshot = std::make_shared<GoalsSnapshot>();
+  snapshot->goals = _goals;
+  if (_currentGoalPtr != nullptr)
+  {
+    for (const auto& currGoalsGroup : _goals)
+      for (std::size_t i = 0; i < currGoalsGroup.second.size(); ++i)
+        if (&currGoalsGroup.second[i] == _currentGoalPtr)
+          snapshot->currentGoalPosition.emplace(currGoalsGroup.first, i);
+  }
+
+  // All the checkpoints not saved yet were opened after the last modification so they share the same snapshot
+  std::shared_ptr<const GoalsSnapshot> snapshotPtr = std::move(snapshot);
+  for (auto it = _goalsBeforeCheckpoints.rbegin(); it != _goalsBeforeCheckpoints.rend() && !*it; ++it)
+    *it = snapshotPtr;
+}
+
+
 } // !ogp
@@ -1,10 +1,31 @@
 #include <orderedgoalsplanner/types/historical.hpp>
+#include <stdexcept>
+#include "../util/hash.hpp"
 
 
 namespace ogp
 {
 
 
+Historical::Historical(const Historical& pOther)
+  : _mutexPtr(pOther._mutexPtr),
+    _actionToNumberOfTimeAleardyDone(pOther._actionToNumberOfTimeAleardyDone),
+    _trail(),
+    _nbOfOpenCheckpoints(0)
+{
+}
+
+
+Historical& Historical::operator=(const Historical& pOther)
+{
+  _mutexPtr = pOther._mutexPtr;
+  _actionToNumberOfTimeAleardyDone = pOther._actionToNumberOfTimeAleardyDone;
+  _trail.clear();
+  _nbOfOpenCheckpoints = 0;
+  return *this;
+}
+
+
 void Historical::setMutex(std::shared_ptr<std::mutex> pMutex)
 {
   _mutexPtr = std::move(pMutex);
@@ -28,6 +49,8 @@ void Historical::_notifyActionDone(const ActionId& pActionId)
 {
   _actionToNumberOfTimeAleardyDone.emplace(pActionId, 0);
   ++_actionToNumberOfTimeAleardyDone[pActionId];
+  if (_nbOfOpenCheckpoints > 0)
+    _trail.push_back(pActionId);
 }
 
 
@@ -65,4 +88,84 @@ std::size_t Historical::_getNbOfTimeAnActionHasAlreadyBeenDone(const ActionId& p
 }
 
 
+std::uint64_t Historical::hash() const
+{
+  if (_mutexPtr)
+  {
+    std::lock_guard<std::mutex> lock(*_mutexPtr);
+    return _hash();
+  }
+  return _hash();
+}
+
+std::uint64_t Historical::_hash() const
+{
+  std::uint64_t res = 0;
+  for (const auto& currActionToNumberOfTime : _actionToNumberOfTimeAleardyDone)
+  {
+    combineHash(res, hashStr(currActionToNumberOfTime.first));
+    combineHash(res, static_cast<std::uint64_t>(currActionToNumberOfTime.second));
+  }
+  return res;
+}
+
+
+std::string Historical::toStr() const
+{
+  if (_mutexPtr)
+  {
+    std::lock_guard<std::mutex> lock(*_mutexPtr);
+    return _toStr();
+  }
+  return _toStr();
+}
+
+std::string Historical::_toStr() const
+{
+  std::string res;
+  for (const auto& currActionToNumberOfTime : _actionToNumberOfTimeAleardyDone)
+  {
+    if (!res.empty())
+      res += ", ";
+    res += currActionToNumberOfTime.first + ": " + std::to_string(currActionToNumberOfTime.second);
+  }
+  return res;
+}
+
+
+Historical::Checkpoint Historical::checkpoint()
+{
+  return Checkpoint{_trail.size(), _nbOfOpenCheckpoints++};
+}
+
+
+void Historical::rollbackTo(const Checkpoint& pCheckpoint)
+{
+  if (pCheckpoint.nbOfOpenCheckpointsBefore >= _nbOfOpenCheckpoints)
+    throw std::runtime_error("Cannot rollback to a checkpoint that is already closed");
+  std::unique_lock<std::mutex> lock;
+  if (_mutexPtr)
+    lock = std::unique_lock<std::mutex>(*_mutexPtr);
+  while (_trail.size() > pCheckpoint.trailSize)
+  {
+    auto it = _actionToNumberOfTimeAleardyDone.find(_trail.back());
+    if (it != _actionToNumberOfTimeAleardyDone.end() && --it->second == 0)
+      _actionToNumberOfTimeAleardyDone.erase(it);
+    _trail.pop_back();
+  }
+  releaseCheckpoint(pCheckpoint);
+}
+
+
+void Historical::releaseCheckpoint(const Checkpoint& pCheckpoint)
+{
+  if (pCheckpoint.nbOfOpenCheckpointsBefore >= _nbOfOpenCheckpoints)
+    throw std::runtime_error("Cannot release a checkpoint that is already closed");
+  _nbOfOpenCheckpoints = pCheckpoint.nbOfOpenCheckpointsBefore;
+  // The outer checkpoints still need the trail
+  if (_nbOfOpenCheckpoints == 0)
+    _trail.clear();
+}
+
+
 } // !ogp
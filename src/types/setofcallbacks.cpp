@@ -1,5 +1,6 @@
 #include <orderedgoalsplanner/types/setofcallbacks.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
+#include "../algo/incrementalmatcher.hpp"
 
 namespace ogp
 {
@@ -60,10 +61,28 @@ void MutableSetOfCallbacks::remove(const CallbackId& pCallbackId)
 
 SetOfCallbacks::SetOfCallbacks(const std::map<CallbackId, ConditionToCallback>& pCallbacks)
   : _callbacks(pCallbacks),
-    _conditionsToIds()
+    _conditionsToIds(),
+    _callbackIdToIncrementalMatcher()
 {
   for (const auto& currCallback : _callbacks)
+  {
     _addLinks(_conditionsToIds, currCallback.second, currCallback.first);
+    if (currCallback.second.condition)
+    {
+      auto incrementalMatcher = IncrementalMatcher::tryToCompile(*currCallback.second.condition, currCallback.second.parameters);
+      if (incrementalMatcher)
+        _callbackIdToIncrementalMatcher.emplace(currCallback.first, std::move(incrementalMatcher));
+    }
+  }
+}
+
+
+const IncrementalMatcher* SetOfCallbacks::incrementalMatcher(const CallbackId& pCallbackId) const
+{
+  auto it = _callbackIdToIncrementalMatcher.find(pCallbackId);
+  if (it != _callbackIdToIncrementalMatcher.end())
+    return &*it->second;
+  return nullptr;
 }
 
 
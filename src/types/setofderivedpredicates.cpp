@@ -1,12 +1,23 @@
 #include <orderedgoalsplanner/types/setofderivedpredicates.hpp>
+#include <atomic>
 #include <orderedgoalsplanner/types/derivedpredicate.hpp>
 
 
 namespace ogp
 {
+namespace
+{
+std::uint64_t _newVersion()
+{
+  static std::atomic<std::uint64_t> lastVersion{0};
+  return ++lastVersion;
+}
+}
 
 SetOfDerivedPredicates::SetOfDerivedPredicates()
-    : _nameToDerivedPredicate()
+    : _nameToDerivedPredicate(),
+      _nameToPredicate(),
+      _version(_newVersion())
 {
 }
 
@@ -20,6 +31,9 @@ void SetOfDerivedPredicates::addDerivedPredicate(const DerivedPredicate& pDerive
 {
   _nameToDerivedPredicate.erase(pDerivedPredicate.predicate.name);
   _nameToDerivedPredicate.emplace(pDerivedPredicate.predicate.name, pDerivedPredicate);
+  _nameToPredicate.erase(pDerivedPredicate.predicate.name);
+  _nameToPredicate.emplace(pDerivedPredicate.predicate.name, std::make_shared<const Predicate>(pDerivedPredicate.predicate));
+  _version = _newVersion();
 }
 
 
@@ -31,6 +45,14 @@ const Predicate* SetOfDerivedPredicates::nameToPredicatePtr(const std::string& p
   return nullptr;
 }
 
+std::shared_ptr<const Predicate> SetOfDerivedPredicates::nameToPredicateSharedPtr(const std::string& pPredicateName) const
+{
+  auto it = _nameToPredicate.find(pPredicateName);
+  if (it != _nameToPredicate.end())
+    return it->second;
+  return {};
+}
+
 std::unique_ptr<Condition> SetOfDerivedPredicates::optFactToConditionPtr(const FactOptional& pFactOptional,
                                                                          bool pAutoAddImmutablePredicates) const
 {
@@ -1,12 +1,14 @@
 #include <orderedgoalsplanner/types/setofevents.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
+#include "../algo/incrementalmatcher.hpp"
 
 namespace ogp
 {
 
 SetOfEvents::SetOfEvents(const Event& pEvent)
   : _events(),
-    _reachableEventLinks()
+    _reachableEventLinks(),
+    _eventIdToIncrementalMatcher()
 {
   add(pEvent);
 }
@@ -22,9 +24,23 @@ EventId SetOfEvents::add(const Event& pEvent,
   auto newId = incrementLastNumberUntilAConditionIsSatisfied(pEventId, isIdOkForInsertion);
   _events.emplace(newId, pEvent);
   if (pEvent.precondition)
+  {
     _reachableEventLinks.add(*pEvent.precondition, newId);
+    auto incrementalMatcher = IncrementalMatcher::tryToCompile(*pEvent.precondition, pEvent.parameters);
+    if (incrementalMatcher)
+      _eventIdToIncrementalMatcher.emplace(newId, std::move(incrementalMatcher));
+  }
   return newId;
 }
 
 
+const IncrementalMatcher* SetOfEvents::incrementalMatcher(const EventId& pEventId) const
+{
+  auto it = _eventIdToIncrementalMatcher.find(pEventId);
+  if (it != _eventIdToIncrementalMatcher.end())
+    return &*it->second;
+  return nullptr;
+}
+
+
 } // !ogp
@@ -1,58 +1,412 @@
 #include <orderedgoalsplanner/types/setoffacts.hpp>
 #include <stdexcept>
+#include <unordered_map>
 #include <orderedgoalsplanner/types/fact.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
 #include <orderedgoalsplanner/util/alias.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 #include "expressionParsed.hpp"
+#include "../util/hash.hpp"
 
 namespace ogp
 {
 namespace
 {
-std::string _getExactCall(const Fact& pFact)
+bool _areValuesEquivalent(const std::optional<Entity>& pValue1,
+                          const std::optional<Entity>& pValue2)
 {
-  auto res = pFact.name();
-  res += "(";
-  bool firstArg = true;
+  if (!pValue1 || !pValue2)
+    return !pValue1 && !pValue2;
+  return !(*pValue1 < *pValue2) && !(*pValue2 < *pValue1);
+}
+
+/// Hash of the arguments of a ground fact. The facts of a chunk have the same predicate, so it is the hash of their atom.
+std::uint64_t _hashOfArguments(const Fact& pFact)
+{
+  std::uint64_t res = pFact.arguments().size();
   for (const auto& currArg : pFact.arguments())
+    combineHash(res, hashStr(currArg.entity().value));
+  return res;
+}
+
+/// Check if two ground facts have the same arguments.
+bool _haveTheSameArguments(const Fact& pFact1,
+                           const Fact& pFact2)
+{
+  const auto& arguments1 = pFact1.arguments();
+  const auto& arguments2 = pFact2.arguments();
+  if (arguments1.size() != arguments2.size())
+    return false;
+  for (std::size_t i = 0; i < arguments1.size(); ++i)
+    if (arguments1[i].entity().value != arguments2[i].entity().value)
+      return false;
+  return true;
+}
+
+/// Key of a fact in the Zobrist hash of a set of facts.
+std::uint64_t _zobristKey(const Fact& pFact,
+                          const std::optional<std::uint64_t>& pAtomHashOpt)
+{
+  if (!pAtomHashOpt)
+    return hashStr(pFact.toStr());
+  auto res = hashStr(pFact.name());
+  combineHash(res, *pAtomHashOpt);
+  if (pFact.value())
+  {
+    combineHash(res, hashStr(pFact.value()->value));
+    combineHash(res, pFact.isValueNegated() ? 1 : 0);
+  }
+  return res;
+}
+
+/// Add the entities held by a fact (in its arguments, in its fluent arguments and in its value) that are not already in the result.
+void _extractEntitiesHeldByAFact(std::vector<const std::string*>& pRes,
+                                 const Fact& pFact)
+{
+  auto addEntity = [&](const Entity& pEntity) {
+    if (pEntity.isAParameterToFill())
+      return;
+    for (const auto* currEntityPtr : pRes)
+      if (*currEntityPtr == pEntity.value)
+        return;
+    pRes.push_back(&pEntity.value);
+  };
+
+  for (const auto& currArg : pFact.arguments())
+  {
+    if (currArg.isEntity())
+      addEntity(currArg.entity());
+    else if (currArg.fluent() != nullptr)
+      _extractEntitiesHeldByAFact(pRes, *currArg.fluent());
+  }
+  if (pFact.value())
+    addEntity(*pFact.value());
+}
+}
+
+
+
+/**
+ * Slots of facts in their insertion order.<br/>
+ * A removed slot is replaced by a tombstone so that the order of the other slots is kept.
+ * The tombstones are compacted when they become the majority, so a removal costs O(1) amortized.
+ * While a checkpoint is open the positions must stay stable, so the compaction is postponed.
+ */
+struct SetOfFacts::PostingList
+{
+  std::vector<FactSlot> slots;
+  /// Slot to its position in slots.
+  std::unordered_map<FactSlot, std::size_t> slotToPosition;
+
+  bool empty() const { return slotToPosition.empty(); }
+  bool contains(FactSlot pSlot) const { return slotToPosition.count(pSlot) > 0; }
+
+  void add(FactSlot pSlot)
+  {
+    slotToPosition.emplace(pSlot, slots.size());
+    slots.push_back(pSlot);
+  }
+
+  /// Put back a removed slot at the position it had.
+  void restore(FactSlot pSlot,
+               std::size_t pPosition)
+  {
+    if (slots.size() <= pPosition)
+      slots.resize(pPosition + 1, _removedSlot);
+    slots[pPosition] = pSlot;
+    slotToPosition.emplace(pSlot, pPosition);
+  }
+
+  /// Remove a slot and return the position it had.
+  std::size_t remove(FactSlot pSlot,
+                     bool pCanCompact)
   {
-    auto currArgType = currArg.type();
-    if (currArgType && currArg.isEntity())
+    auto it = slotToPosition.find(pSlot);
+    if (it == slotToPosition.end())
+      throw std::runtime_error("The slot to remove is not in the posting list");
+    auto res = it->second;
+    slots[res] = _removedSlot;
+    slotToPosition.erase(it);
+    while (!slots.empty() && slots.back() == _removedSlot)
+      slots.pop_back();
+    if (pCanCompact && slots.size() > 2 * slotToPosition.size() + 8)
+      _compact();
+    return res;
+  }
+
+private:
+  void _compact()
+  {
+    std::size_t newPosition = 0;
+    for (const auto& currSlot : slots)
     {
-      if (firstArg)
-        firstArg = false;
-      else
-        res += ", ";
-      res += currArg.entity().value;
+      if (currSlot == _removedSlot)
+        continue;
+      slots[newPosition] = currSlot;
+      slotToPosition[currSlot] = newPosition;
+      ++newPosition;
     }
+    slots.resize(newPosition);
   }
-  res += ")";
-  return res;
+};
+
+
+/// Facts of a ground atom (= all the values of a predicate applied to the same arguments).
+struct SetOfFacts::AtomFacts
+{
+  PostingList facts;
+  /// Value of the atom if it is a number.
+  std::optional<Number> number;
+};
+
+
+/// Posting lists of the facts that have a signature.
+struct SetOfFacts::SignatureIndex
+{
+  SignatureIndex(std::size_t pNbOfArgs)
+   : all(),
+     argIdToArgValueToFacts(pNbOfArgs),
+     fluentValueToFacts()
+  {
+  }
+  PostingList all;
+  std::vector<std::unordered_map<std::string, PostingList>> argIdToArgValueToFacts;
+  std::unordered_map<std::string, PostingList> fluentValueToFacts;
+};
+
+
+/// Facts of a predicate with their indexes.
+struct SetOfFacts::Chunk
+{
+  Chunk() = default;
+  /// Copy the facts and make the slots point to the copied facts.
+  Chunk(const Chunk& pOther)
+    : facts(pOther.facts),
+      slotToFact(pOther.slotToFact.size(), nullptr),
+      freeSlots(pOther.freeSlots),
+      atomHashToFacts(pOther.atomHashToFacts),
+      signatureToIndex(pOther.signatureToIndex),
+      entityToFacts(pOther.entityToFacts)
+  {
+    for (const auto& currFact : facts)
+      slotToFact[currFact.second.slot] = &currFact.first;
+  }
+
+  std::map<Fact, FactRecord> facts;
+  /// Slot to the fact stored in facts, nullptr for a free slot.
+  std::vector<const Fact*> slotToFact;
+  std::vector<FactSlot> freeSlots;
+  /// Hash of the arguments of a ground atom to the facts of this atom. Different atoms can share a hash.
+  std::unordered_multimap<std::uint64_t, AtomFacts> atomHashToFacts;
+  std::unordered_map<std::string, SignatureIndex> signatureToIndex;
+  /// Value of an entity to the facts holding this entity
+  std::unordered_map<std::string, PostingList> entityToFacts;
+
+  FactSlot newSlot()
+  {
+    if (!freeSlots.empty())
+    {
+      auto res = freeSlots.back();
+      freeSlots.pop_back();
+      return res;
+    }
+    slotToFact.push_back(nullptr);
+    return static_cast<FactSlot>(slotToFact.size() - 1);
+  }
+
+  /// Find the facts of the atom of a ground fact, without allocating memory.
+  std::unordered_multimap<std::uint64_t, AtomFacts>::iterator findAtom(std::uint64_t pAtomHash,
+                                                                       const Fact& pFact)
+  {
+    return _findAtom(*this, pAtomHash, pFact);
+  }
+
+  std::unordered_multimap<std::uint64_t, AtomFacts>::const_iterator findAtom(std::uint64_t pAtomHash,
+                                                                             const Fact& pFact) const
+  {
+    return _findAtom(*this, pAtomHash, pFact);
+  }
+
+private:
+  template <typename CHUNK>
+  static auto _findAtom(CHUNK& pChunk,
+                        std::uint64_t pAtomHash,
+                        const Fact& pFact) -> decltype(pChunk.atomHashToFacts.end())
+  {
+    auto itRange = pChunk.atomHashToFacts.equal_range(pAtomHash);
+    for (auto it = itRange.first; it != itRange.second; ++it)
+    {
+      // All the facts of an atom have the same arguments so the first one is enough to compare them
+      for (const auto& currSlot : it->second.facts.slots)
+      {
+        if (currSlot == _removedSlot)
+          continue;
+        if (_haveTheSameArguments(*pChunk.slotToFact[currSlot], pFact))
+          return it;
+        break;
+      }
+    }
+    return pChunk.atomHashToFacts.end();
+  }
+};
+
+
+/// Facts before a replacement of all the facts of a set of facts (by clear or by an assignment).
+struct SetOfFacts::Snapshot
+{
+  std::map<std::string, std::shared_ptr<const Chunk>> predicateNameToChunk;
+  std::size_t nbOfFacts;
+  std::uint64_t hash;
+  /// Number of trail entries recorded for the replacement.
+  std::size_t nbOfTrailEntries;
+};
+
+
+struct SetOfFacts::TrailEntry
+{
+  Fact fact;
+  bool canBeRemoved;
+  /// True if the fact was added, false if it was removed.
+  bool wasAdded;
+  /// For a removed fact, its positions in its posting lists so that a rollback puts it back at the same place.
+  std::vector<std::size_t> positions;
+  /// Set on the last entry of a replacement of all the facts, to undo the replacement at once.
+  std::shared_ptr<const Snapshot> snapshotPtr;
+};
+
+
+SetOfFacts::SetOfFacts()
+ : _predicateNameToChunk(),
+   _nbOfFacts(0),
+   _hash(0),
+   _trail(),
+   _nbOfOpenCheckpoints(0)
+{
 }
 
+SetOfFacts::SetOfFacts(const SetOfFacts& pOther)
+ : _predicateNameToChunk(pOther._predicateNameToChunk),
+   _nbOfFacts(pOther._nbOfFacts),
+   _hash(pOther._hash),
+   _trail(),
+   _nbOfOpenCheckpoints(0)
+{
+}
 
-void _addValueToExactCall(std::string& pRes,
-                           const Fact& pFact)
+SetOfFacts::SetOfFacts(SetOfFacts&& pOther)
+ : _predicateNameToChunk(std::move(pOther._predicateNameToChunk)),
+   _nbOfFacts(pOther._nbOfFacts),
+   _hash(pOther._hash),
+   _trail(),
+   _nbOfOpenCheckpoints(0)
 {
-  if (pFact.value())
+  pOther._predicateNameToChunk.clear();
+  pOther._nbOfFacts = 0;
+  pOther._hash = 0;
+}
+
+SetOfFacts::~SetOfFacts()
+{
+}
+
+SetOfFacts& SetOfFacts::operator=(const SetOfFacts& pOther)
+{
+  if (this == &pOther)
+    return *this;
+  if (_nbOfOpenCheckpoints > 0)
+    _recordReplacementOfAllTheFacts(&pOther);
+  _predicateNameToChunk = pOther._predicateNameToChunk;
+  _nbOfFacts = pOther._nbOfFacts;
+  _hash = pOther._hash;
+  return *this;
+}
+
+SetOfFacts& SetOfFacts::operator=(SetOfFacts&& pOther)
+{
+  if (_nbOfOpenCheckpoints > 0)
+    return operator=(static_cast<const SetOfFacts&>(pOther));
+  _predicateNameToChunk = std::move(pOther._predicateNameToChunk);
+  _nbOfFacts = pOther._nbOfFacts;
+  _hash = pOther._hash;
+  pOther._predicateNameToChunk.clear();
+  pOther._nbOfFacts = 0;
+  pOther._hash = 0;
+  return *this;
+}
+
+
+SetOfFacts::FactsView::Iterator::Iterator(ChunkIterator pChunkIt,
+                                          ChunkIterator pChunkEnd)
+  : _chunkIt(pChunkIt),
+    _chunkEnd(pChunkEnd),
+    _factIt()
+{
+  if (_chunkIt != _chunkEnd)
+    _factIt = _chunkIt->second->facts.begin();
+}
+
+SetOfFacts::FactsView::Iterator::Iterator(ChunkIterator pChunkIt,
+                                          ChunkIterator pChunkEnd,
+                                          std::map<Fact, FactRecord>::const_iterator pFactIt)
+  : _chunkIt(pChunkIt),
+    _chunkEnd(pChunkEnd),
+    _factIt(pFactIt)
+{
+}
+
+std::pair<const Fact&, bool> SetOfFacts::FactsView::Iterator::operator*() const
+{
+  return std::pair<const Fact&, bool>(_factIt->first, _factIt->second.canBeRemoved);
+}
+
+SetOfFacts::FactsView::Iterator& SetOfFacts::FactsView::Iterator::operator++()
+{
+  ++_factIt;
+  if (_factIt == _chunkIt->second->facts.end())
   {
-    pRes += "=";
-    if (pFact.isValueNegated())
-      pRes = "!";
-    pRes += pFact.value()->value;
+    ++_chunkIt;
+    if (_chunkIt != _chunkEnd)
+      _factIt = _chunkIt->second->facts.begin();
   }
+  return *this;
 }
+
+bool SetOfFacts::FactsView::Iterator::operator==(const Iterator& pOther) const
+{
+  if (_chunkIt != pOther._chunkIt)
+    return false;
+  return _chunkIt == _chunkEnd || _factIt == pOther._factIt;
 }
 
+SetOfFacts::FactsView::Iterator SetOfFacts::FactsView::begin() const
+{
+  return Iterator(_setOfFactsPtr->_predicateNameToChunk.begin(), _setOfFactsPtr->_predicateNameToChunk.end());
+}
 
+SetOfFacts::FactsView::Iterator SetOfFacts::FactsView::end() const
+{
+  return Iterator(_setOfFactsPtr->_predicateNameToChunk.end(), _setOfFactsPtr->_predicateNameToChunk.end());
+}
 
-SetOfFacts::SetOfFacts()
- : _facts(),
-   _exactCallToListsOpt(),
-   _exactCallWithoutValueToListsOpt(),
-   _signatureToLists()
+SetOfFacts::FactsView::Iterator SetOfFacts::FactsView::find(const Fact& pFact) const
+{
+  const auto& predicateNameToChunk = _setOfFactsPtr->_predicateNameToChunk;
+  auto itChunk = predicateNameToChunk.find(pFact.name());
+  if (itChunk != predicateNameToChunk.end())
+  {
+    auto itFact = itChunk->second->facts.find(pFact);
+    if (itFact != itChunk->second->facts.end())
+      return Iterator(itChunk, predicateNameToChunk.end(), itFact);
+  }
+  return end();
+}
+
+std::map<Fact, bool> SetOfFacts::FactsView::toMap() const
 {
+  std::map<Fact, bool> res;
+  for (const auto& currFact : *this)
+    res.emplace_hint(res.end(), currFact.first, currFact.second);
+  return res;
 }
 
 
@@ -83,32 +437,137 @@ std::string SetOfFacts::Delta::toPddl() const
 SetOfFacts::Delta SetOfFacts::deltaFrom(const SetOfFacts& pOldSetOfFacts) const
 {
   Delta res;
-  for (const auto& currFact : _facts)
-  {
-    auto it = pOldSetOfFacts._facts.find(currFact.first);
-    if (it == pOldSetOfFacts._facts.end())
-      res.addedFacts.insert(currFact.first);
-  }
+  // The facts are iterated in the order of the sets so the insertions are done at the end
+  iterateOnDeltaFrom([&](const Fact& pFact, bool pIsAdded) {
+    if (pIsAdded)
+      res.addedFacts.emplace_hint(res.addedFacts.end(), pFact);
+    else
+      res.removedFacts.emplace_hint(res.removedFacts.end(), pFact);
+  }, pOldSetOfFacts);
+  return res;
+}
+
 
-  for (const auto& currFact : pOldSetOfFacts._facts)
+void SetOfFacts::deltaFrom(std::vector<DeltaEntry>& pDeltaEntries,
+                           const SetOfFacts& pOldSetOfFacts) const
+{
+  pDeltaEntries.clear();
+  iterateOnDeltaFrom([&](const Fact& pFact, bool pIsAdded) {
+    pDeltaEntries.push_back(DeltaEntry{&pFact, pIsAdded});
+  }, pOldSetOfFacts);
+}
+
+
+void SetOfFacts::iterateOnDeltaFrom(const std::function<void (const Fact&, bool)>& pCallback,
+                                    const SetOfFacts& pOldSetOfFacts) const
+{
+  std::vector<const Fact*> addedFacts;
+  std::vector<const Fact*> removedFacts;
+  /// Hash of the arguments of the ground added facts to these facts
+  std::unordered_multimap<std::uint64_t, const Fact*> groundAddedFacts;
+
+  auto itChunk = _predicateNameToChunk.begin();
+  auto itOldChunk = pOldSetOfFacts._predicateNameToChunk.begin();
+  while (itChunk != _predicateNameToChunk.end() || itOldChunk != pOldSetOfFacts._predicateNameToChunk.end())
   {
-    auto it = _facts.find(currFact.first);
-    if (it == _facts.end())
+    const Chunk* chunkPtr = nullptr;
+    const Chunk* oldChunkPtr = nullptr;
+    if (itOldChunk == pOldSetOfFacts._predicateNameToChunk.end() ||
+        (itChunk != _predicateNameToChunk.end() && itChunk->first < itOldChunk->first))
+    {
+      chunkPtr = itChunk->second.get();
+      ++itChunk;
+    }
+    else if (itChunk == _predicateNameToChunk.end() || itOldChunk->first < itChunk->first)
+    {
+      oldChunkPtr = itOldChunk->second.get();
+      ++itOldChunk;
+    }
+    else
     {
-      bool canBeRemoved = true;
-      for (const auto& addedFact : res.addedFacts)
+      chunkPtr = itChunk->second.get();
+      oldChunkPtr = itOldChunk->second.get();
+      ++itChunk;
+      ++itOldChunk;
+      if (chunkPtr == oldChunkPtr)
+        continue; // The chunk is shared so nothing changed for this predicate
+    }
+
+    if (oldChunkPtr == nullptr)
+    {
+      for (const auto& currFact : chunkPtr->facts)
+        pCallback(currFact.first, true);
+      continue;
+    }
+    if (chunkPtr == nullptr)
+    {
+      for (const auto& currFact : oldChunkPtr->facts)
+        pCallback(currFact.first, false);
+      continue;
+    }
+
+    // Merge the sorted facts of the two chunks
+    addedFacts.clear();
+    removedFacts.clear();
+    auto itFact = chunkPtr->facts.begin();
+    auto itOldFact = oldChunkPtr->facts.begin();
+    while (itFact != chunkPtr->facts.end() || itOldFact != oldChunkPtr->facts.end())
+    {
+      if (itOldFact == oldChunkPtr->facts.end() ||
+          (itFact != chunkPtr->facts.end() && itFact->first < itOldFact->first))
       {
-        if (addedFact.areEqualWithoutValueConsideration(currFact.first))
-        {
-          canBeRemoved = false;
-          break;
-        }
+        addedFacts.push_back(&itFact->first);
+        ++itFact;
+      }
+      else if (itFact == chunkPtr->facts.end() || itOldFact->first < itFact->first)
+      {
+        removedFacts.push_back(&itOldFact->first);
+        ++itOldFact;
+      }
+      else
+      {
+        ++itFact;
+        ++itOldFact;
+      }
+    }
+
+    groundAddedFacts.clear();
+    bool hasAnAddedFactWithoutAtom = false;
+    for (const auto* currFactPtr : addedFacts)
+    {
+      pCallback(*currFactPtr, true);
+      if (FactIdTable::isGround(*currFactPtr))
+        groundAddedFacts.emplace(_hashOfArguments(*currFactPtr), currFactPtr);
+      else
+        hasAnAddedFactWithoutAtom = true;
+    }
+
+    auto isAnAddedFactWithTheSameArguments = [&](const Fact& pRemovedFact) {
+      for (const auto* currAddedFactPtr : addedFacts)
+        if (currAddedFactPtr->areEqualWithoutValueConsideration(pRemovedFact))
+          return true;
+      return false;
+    };
+    auto isAnAddedFactWithTheSameAtom = [&](const Fact& pRemovedFact) {
+      auto itRange = groundAddedFacts.equal_range(_hashOfArguments(pRemovedFact));
+      for (auto it = itRange.first; it != itRange.second; ++it)
+        if (_haveTheSameArguments(*it->second, pRemovedFact))
+          return true;
+      return false;
+    };
+    for (const auto* currFactPtr : removedFacts)
+    {
+      if (!addedFacts.empty())
+      {
+        // The ground facts are compared by atom, the other ones need a comparison with all the added facts
+        if (FactIdTable::isGround(*currFactPtr) ?
+            isAnAddedFactWithTheSameAtom(*currFactPtr) || (hasAnAddedFactWithoutAtom && isAnAddedFactWithTheSameArguments(*currFactPtr)) :
+            isAnAddedFactWithTheSameArguments(*currFactPtr))
+          continue;
       }
-      if (canBeRemoved)
-        res.removedFacts.insert(currFact.first);
+      pCallback(*currFactPtr, false);
     }
   }
-  return res;
 }
 
 
@@ -139,7 +598,7 @@ std::string SetOfFacts::toPddl(std::size_t pIdentation, bool pPrintTimeLessFacts
 {
   std::string res;
   bool firstIteration = true;
-  for (auto& currFact : _facts)
+  for (const auto& currFact : facts())
   {
     if (!pPrintTimeLessFactsToo && !currFact.second)
       continue;
@@ -157,145 +616,196 @@ std::string SetOfFacts::toPddl(std::size_t pIdentation, bool pPrintTimeLessFacts
 bool SetOfFacts::add(const Fact& pFact,
                      bool pCanBeRemoved)
 {
-  if (!_facts.try_emplace(pFact, pCanBeRemoved).second)
+  const Chunk* chunkPtr = _getChunk(pFact.name());
+  if (chunkPtr != nullptr && chunkPtr->facts.count(pFact) > 0)
     return false;
 
-  if (!pFact.hasAParameter() && !pFact.hasAFluentArgument())
-  {
-    auto exactCallStr = _getExactCall(pFact);
-    if (!_exactCallWithoutValueToListsOpt)
-      _exactCallWithoutValueToListsOpt.emplace();
-    (*_exactCallWithoutValueToListsOpt)[exactCallStr].emplace_back(pFact);
+  if (_nbOfOpenCheckpoints > 0)
+    _trail.push_back(TrailEntry{pFact, pCanBeRemoved, true, {}, {}});
+  _addFactToChunk(_getChunkToModify(pFact.name()), pFact, pCanBeRemoved, nullptr);
+  return true;
+}
 
-    if (pFact.value())
-    {
-      _addValueToExactCall(exactCallStr, pFact);
-      if (!_exactCallToListsOpt)
-        _exactCallToListsOpt.emplace();
-      (*_exactCallToListsOpt)[exactCallStr].emplace_back(pFact);
-    }
-  }
 
+void SetOfFacts::_addFactToChunk(Chunk& pChunk,
+                                 const Fact& pFact,
+                                 bool pCanBeRemoved,
+                                 const std::vector<std::size_t>* pPositionsPtr)
+{
+  auto slot = pChunk.newSlot();
+  const Fact& fact = pChunk.facts.emplace(pFact, FactRecord{pCanBeRemoved, slot}).first->first;
+  pChunk.slotToFact[slot] = &fact;
+  ++_nbOfFacts;
+
+  // Put the fact at the end of its posting lists, or at the positions it had if it is restored by a rollback
+  std::size_t nbOfPositionsUsed = 0;
+  auto addInPostingList = [&](PostingList& pPostingList) {
+    if (pPositionsPtr != nullptr)
+      pPostingList.restore(slot, (*pPositionsPtr)[nbOfPositionsUsed++]);
+    else
+      pPostingList.add(slot);
+  };
 
-  pFact.generateSignaturesWithRelatedTypes([&](const std::string& pSignature) {
-    auto& factArguments = pFact.arguments();
-    auto insertionRes = _signatureToLists.emplace(pSignature, factArguments.size());
-    ParameterToValues& parameterToValues = insertionRes.first->second;
+  std::optional<std::uint64_t> atomHashOpt;
+  if (!fact.hasAParameter() && FactIdTable::isGround(fact))
+  {
+    atomHashOpt = _hashOfArguments(fact);
+    auto itAtom = pChunk.findAtom(*atomHashOpt, fact);
+    if (itAtom == pChunk.atomHashToFacts.end())
+      itAtom = pChunk.atomHashToFacts.emplace(*atomHashOpt, AtomFacts());
+    addInPostingList(itAtom->second.facts);
+    if (fact.value())
+      _refreshFluentNumber(pChunk, itAtom->second);
+  }
+  _hash ^= _zobristKey(fact, atomHashOpt);
+
+  fact.generateSignaturesWithRelatedTypes([&](const std::string& pSignature) {
+    auto& factArguments = fact.arguments();
+    auto insertionRes = pChunk.signatureToIndex.emplace(pSignature, factArguments.size());
+    SignatureIndex& signatureIndex = insertionRes.first->second;
 
-    parameterToValues.all.emplace_back(pFact);
+    addInPostingList(signatureIndex.all);
     for (std::size_t i = 0; i < factArguments.size(); ++i)
     {
       if (factArguments[i].isEntity() && !factArguments[i].isAParameterToFill())
-        parameterToValues.argIdToArgValueToValues[i][factArguments[i].entity().value].emplace_back(pFact);
+        addInPostingList(signatureIndex.argIdToArgValueToFacts[i][factArguments[i].entity().value]);
       else
-        parameterToValues.argIdToArgValueToValues[i][""].emplace_back(pFact);
+        addInPostingList(signatureIndex.argIdToArgValueToFacts[i][""]);
     }
-    if (pFact.value())
+    if (fact.value())
     {
-      if (!pFact.value()->isAParameterToFill() && !pFact.isValueNegated())
-        parameterToValues.fluentValueToValues[pFact.value()->value].emplace_back(pFact);
+      if (!fact.value()->isAParameterToFill() && !fact.isValueNegated())
+        addInPostingList(signatureIndex.fluentValueToFacts[fact.value()->value]);
       else
-        parameterToValues.fluentValueToValues[""].emplace_back(pFact);
+        addInPostingList(signatureIndex.fluentValueToFacts[""]);
     }
   }, false, true);
-  return true;
+
+  std::vector<const std::string*> entitiesHeld;
+  _extractEntitiesHeldByAFact(entitiesHeld, fact);
+  for (const auto* currEntityPtr : entitiesHeld)
+    addInPostingList(pChunk.entityToFacts[*currEntityPtr]);
 }
 
 
-bool SetOfFacts::erase(const Fact& pFact)
+bool SetOfFacts::erase(const Fact& pFact,
+                       std::optional<Fact>* pErasedFactPtr)
 {
   if (_erase(pFact))
+  {
+    if (pErasedFactPtr != nullptr)
+      *pErasedFactPtr = pFact;
     return true;
+  }
 
   auto factIt = find(pFact);
   for (const auto& currFact : factIt) {
     auto copiedFact = currFact; // Copy to prevent usage after memory liberation
-    return _erase(copiedFact);
+    bool res = _erase(copiedFact);
+    if (res && pErasedFactPtr != nullptr)
+      *pErasedFactPtr = std::move(copiedFact);
+    return res;
   }
   return false;
 }
 
-std::map<Fact, bool>::iterator SetOfFacts::eraseFactIt(std::map<Fact, bool>::iterator pFactIt)
+void SetOfFacts::_eraseFactFromChunk(Chunk& pChunk,
+                                     std::map<Fact, FactRecord>::iterator pFactIt,
+                                     std::vector<std::size_t>* pPositionsPtr)
 {
-  // Do not allow to remove if this fact is marked as cannot be removed
-  if (!pFactIt->second)
-    throw std::runtime_error("Cannot erase this fact iterator because it is constant");
   const Fact& fact = pFactIt->first;
+  auto slot = pFactIt->second.slot;
+  // The positions recorded for a rollback must stay valid, so the posting lists are not compacted during a checkpoint
+  bool canCompact = _nbOfOpenCheckpoints == 0;
+  auto removeFromPostingList = [&](PostingList& pPostingList) {
+    auto position = pPostingList.remove(slot, canCompact);
+    if (pPositionsPtr != nullptr)
+      pPositionsPtr->push_back(position);
+  };
 
-  if (!fact.hasAParameter() && !fact.hasAFluentArgument())
+  std::optional<std::uint64_t> atomHashOpt;
+  if (!fact.hasAParameter() && FactIdTable::isGround(fact))
   {
-    auto exactCallStr = _getExactCall(fact);
-    if (_exactCallWithoutValueToListsOpt)
-    {
-      std::list<Fact>& listOfTypes = (*_exactCallWithoutValueToListsOpt)[exactCallStr];
-      _removeAValueForList(listOfTypes, fact);
-      if (listOfTypes.empty())
-        _exactCallWithoutValueToListsOpt->erase(exactCallStr);
-    }
-
-    if (_exactCallToListsOpt && fact.value())
-    {
-      _addValueToExactCall(exactCallStr, fact);
-      std::list<Fact>& listWithValueOfTypes = (*_exactCallToListsOpt)[exactCallStr];
-      _removeAValueForList(listWithValueOfTypes, fact);
-      if (listWithValueOfTypes.empty())
-        _exactCallToListsOpt->erase(exactCallStr);
-    }
+    atomHashOpt = _hashOfArguments(fact);
+    auto itAtom = pChunk.findAtom(*atomHashOpt, fact);
+    if (itAtom == pChunk.atomHashToFacts.end())
+      throw std::runtime_error("The atom of the fact to remove is not indexed");
+    removeFromPostingList(itAtom->second.facts);
+    if (itAtom->second.facts.empty())
+      pChunk.atomHashToFacts.erase(itAtom);
+    else if (fact.value())
+      _refreshFluentNumber(pChunk, itAtom->second);
   }
 
   fact.generateSignaturesWithRelatedTypes([&](const std::string& pSignature) {
     auto& factArguments = fact.arguments();
-    auto itParameterToValues = _signatureToLists.find(pSignature);
-    if (itParameterToValues != _signatureToLists.end())
-    {
-      ParameterToValues& parameterToValues = itParameterToValues->second;
-
-      _removeAValueForList(parameterToValues.all, fact);
-      if (parameterToValues.all.empty())
-      {
-        _signatureToLists.erase(pSignature);
-      }
-      else
-      {
-        for (std::size_t i = 0; i < factArguments.size(); ++i)
-        {
-          const std::string argKey = factArguments[i].isEntity() && !factArguments[i].isAParameterToFill() ? factArguments[i].entity().value : "";
-          std::list<Fact>& listOfValues = parameterToValues.argIdToArgValueToValues[i][argKey];
-          _removeAValueForList(listOfValues, fact);
-          if (listOfValues.empty())
-             parameterToValues.argIdToArgValueToValues[i].erase(argKey);
-        }
-        if (fact.value())
-        {
-          const std::string valueKey = !fact.value()->isAParameterToFill() ? fact.value()->value : "";
-          std::list<Fact>& listOfValues = parameterToValues.fluentValueToValues[valueKey];
-          _removeAValueForList(listOfValues, fact);
-          if (listOfValues.empty())
-             parameterToValues.fluentValueToValues.erase(valueKey);
-        }
-      }
-    }
-    else
-    {
-      throw std::runtime_error("Errur while deleteing a fact link");
-    }
+    auto itSignatureIndex = pChunk.signatureToIndex.find(pSignature);
+    if (itSignatureIndex == pChunk.signatureToIndex.end())
+      throw std::runtime_error("The signature \"" + pSignature + "\" of the fact to remove is not indexed");
+    SignatureIndex& signatureIndex = itSignatureIndex->second;
+
+    auto removeFromValueToFacts = [&](std::unordered_map<std::string, PostingList>& pValueToFacts,
+                                      const std::string& pKey) {
+      auto itPostingList = pValueToFacts.find(pKey);
+      if (itPostingList == pValueToFacts.end())
+        throw std::runtime_error("The value \"" + pKey + "\" of the fact to remove is not indexed");
+      removeFromPostingList(itPostingList->second);
+      if (itPostingList->second.empty())
+        pValueToFacts.erase(itPostingList);
+    };
+
+    removeFromPostingList(signatureIndex.all);
+    for (std::size_t i = 0; i < factArguments.size(); ++i)
+      removeFromValueToFacts(signatureIndex.argIdToArgValueToFacts[i],
+                             factArguments[i].isEntity() && !factArguments[i].isAParameterToFill() ? factArguments[i].entity().value : "");
+    if (fact.value())
+      removeFromValueToFacts(signatureIndex.fluentValueToFacts,
+                             !fact.value()->isAParameterToFill() && !fact.isValueNegated() ? fact.value()->value : "");
+    if (signatureIndex.all.empty())
+      pChunk.signatureToIndex.erase(itSignatureIndex);
   }, false, true);
 
-  return _facts.erase(pFactIt);
+  std::vector<const std::string*> entitiesHeld;
+  _extractEntitiesHeldByAFact(entitiesHeld, fact);
+  for (const auto* currEntityPtr : entitiesHeld)
+  {
+    auto itFacts = pChunk.entityToFacts.find(*currEntityPtr);
+    if (itFacts == pChunk.entityToFacts.end())
+      throw std::runtime_error("The entity \"" + *currEntityPtr + "\" held by the fact to remove is not indexed");
+    removeFromPostingList(itFacts->second);
+    if (itFacts->second.empty())
+      pChunk.entityToFacts.erase(itFacts);
+  }
+
+  _hash ^= _zobristKey(fact, atomHashOpt);
+  pChunk.facts.erase(pFactIt);
+  pChunk.slotToFact[slot] = nullptr;
+  pChunk.freeSlots.push_back(slot);
+  --_nbOfFacts;
 }
 
 
-bool SetOfFacts::_erase(const Fact& pFact)
+bool SetOfFacts::_erase(const Fact& pFact,
+                        bool pEvenIfTimeless)
 {
-  auto it = _facts.find(pFact);
-  if (it != _facts.end())
+  const Chunk* chunkPtr = _getChunk(pFact.name());
+  if (chunkPtr == nullptr)
+    return false;
+  auto itInSharedChunk = chunkPtr->facts.find(pFact);
+  // Do not allow to remove if this fact is marked as cannot be removed
+  if (itInSharedChunk == chunkPtr->facts.end() || (!itInSharedChunk->second.canBeRemoved && !pEvenIfTimeless))
+    return false;
+  std::vector<std::size_t>* positionsPtr = nullptr;
+  if (_nbOfOpenCheckpoints > 0)
   {
-    if (!it->second)
-      return false;
-    eraseFactIt(it);
-    return true;
+    _trail.push_back(TrailEntry{itInSharedChunk->first, itInSharedChunk->second.canBeRemoved, false, {}, {}});
+    positionsPtr = &_trail.back().positions;
   }
-  return false;
+
+  Chunk& chunk = _getChunkToModify(pFact.name());
+  _eraseFactFromChunk(chunk, chunk.facts.find(pFact), positionsPtr);
+  _removeChunkIfEmpty(pFact.name());
+  return true;
 }
 
 
@@ -319,12 +829,91 @@ std::string SetOfFacts::SetOfFactIterator::toStr() const
 
 void SetOfFacts::clear()
 {
-  _facts.clear();
-  if (_exactCallToListsOpt)
-    _exactCallToListsOpt.reset();
-  if (_exactCallWithoutValueToListsOpt)
-    _exactCallWithoutValueToListsOpt.reset();
-  _signatureToLists.clear();
+  if (_nbOfOpenCheckpoints > 0)
+    _recordReplacementOfAllTheFacts(nullptr);
+  _predicateNameToChunk.clear();
+  _nbOfFacts = 0;
+  _hash = 0;
+}
+
+
+SetOfFacts::Checkpoint SetOfFacts::checkpoint()
+{
+  return Checkpoint{_trail.size(), _nbOfOpenCheckpoints++};
+}
+
+
+void SetOfFacts::rollbackTo(const Checkpoint& pCheckpoint)
+{
+  if (pCheckpoint.nbOfOpenCheckpointsBefore >= _nbOfOpenCheckpoints)
+    throw std::runtime_error("Cannot rollback to a checkpoint that is already closed");
+  // The modifications are undone in the reverse order, so each fact is put back at the positions it had
+  // in its posting lists and find() iterates over the facts in the same order as before the checkpoint
+  while (_trail.size() > pCheckpoint.trailSize)
+  {
+    auto& trailEntry = _trail.back();
+    if (trailEntry.snapshotPtr)
+    {
+      const auto& snapshot = *trailEntry.snapshotPtr;
+      _predicateNameToChunk = snapshot.predicateNameToChunk;
+      _nbOfFacts = snapshot.nbOfFacts;
+      _hash = snapshot.hash;
+      _trail.erase(_trail.end() - snapshot.nbOfTrailEntries, _trail.end());
+      continue;
+    }
+
+    Chunk& chunk = _getChunkToModify(trailEntry.fact.name());
+    if (trailEntry.wasAdded)
+      _eraseFactFromChunk(chunk, chunk.facts.find(trailEntry.fact), nullptr);
+    else
+      _addFactToChunk(chunk, trailEntry.fact, trailEntry.canBeRemoved, &trailEntry.positions);
+    _removeChunkIfEmpty(trailEntry.fact.name());
+    _trail.pop_back();
+  }
+  _closeCheckpoint(pCheckpoint);
+}
+
+
+void SetOfFacts::releaseCheckpoint(const Checkpoint& pCheckpoint)
+{
+  if (pCheckpoint.nbOfOpenCheckpointsBefore >= _nbOfOpenCheckpoints)
+    throw std::runtime_error("Cannot release a checkpoint that is already closed");
+  _closeCheckpoint(pCheckpoint);
+}
+
+
+void SetOfFacts::iterateOnModificationsSince(const std::function<void (const Fact&, bool)>& pCallback,
+                                             const Checkpoint& pCheckpoint) const
+{
+  if (pCheckpoint.nbOfOpenCheckpointsBefore >= _nbOfOpenCheckpoints)
+    throw std::runtime_error("Cannot iterate on the modifications since a checkpoint that is already closed");
+  for (auto i = pCheckpoint.trailSize; i < _trail.size(); ++i)
+    pCallback(_trail[i].fact, _trail[i].wasAdded);
+}
+
+
+void SetOfFacts::_recordReplacementOfAllTheFacts(const SetOfFacts* pNewFactsPtr)
+{
+  // The entries of the facts are only there for iterateOnModificationsSince, the rollback uses the snapshot
+  auto nbOfTrailEntriesBefore = _trail.size();
+  for (const auto& currFact : facts())
+    _trail.push_back(TrailEntry{currFact.first, currFact.second, false, {}, {}});
+  if (pNewFactsPtr != nullptr)
+    for (const auto& currFact : pNewFactsPtr->facts())
+      _trail.push_back(TrailEntry{currFact.first, currFact.second, true, {}, {}});
+  if (_trail.size() == nbOfTrailEntriesBefore)
+    return;
+  _trail.back().snapshotPtr = std::make_shared<const Snapshot>(
+        Snapshot{_predicateNameToChunk, _nbOfFacts, _hash, _trail.size() - nbOfTrailEntriesBefore});
+}
+
+
+void SetOfFacts::_closeCheckpoint(const Checkpoint& pCheckpoint)
+{
+  _nbOfOpenCheckpoints = pCheckpoint.nbOfOpenCheckpointsBefore;
+  // The outer checkpoints still need the trail
+  if (_nbOfOpenCheckpoints == 0)
+    _trail.clear();
 }
 
 
@@ -335,38 +924,64 @@ typename SetOfFacts::SetOfFactIterator SetOfFacts::find(const Fact& pFact,
   {
     auto resolvedFact = pFact.tryToResolveFluentArguments(*this);
     if (!resolvedFact)
-      return SetOfFactIterator(nullptr);
+      return SetOfFactIterator();
     return find(*resolvedFact, pIgnoreValue);
   }
 
-  if (!pFact.hasAParameter(pIgnoreValue) && !pFact.hasAFluentArgument() && !pFact.isValueNegated())
+  const Chunk* chunkPtr = _getChunk(pFact.name());
+  if (chunkPtr == nullptr)
+    return SetOfFactIterator();
+
+  if (!pFact.hasAParameter(pIgnoreValue) && !pFact.isValueNegated())
   {
-    auto exactCallStr = _getExactCall(pFact);
-    if (!pIgnoreValue && pFact.value())
+    const PostingList* factsOfTheAtomPtr = _findFactsOfAnAtom(*chunkPtr, pFact);
+    if (factsOfTheAtomPtr == nullptr)
+      return SetOfFactIterator();
+    if (pIgnoreValue || !pFact.value())
+      return SetOfFactIterator(chunkPtr->slotToFact, factsOfTheAtomPtr->slots);
+
+    auto hasTheSameValue = [&](const Fact& pOtherFact) {
+      return !pOtherFact.isValueNegated() && pOtherFact.value() && pOtherFact.value()->value == pFact.value()->value;
+    };
+    bool allHaveTheSameValue = true;
+    std::vector<FactSlot> res;
+    for (const auto& currSlot : factsOfTheAtomPtr->slots)
     {
-      _addValueToExactCall(exactCallStr, pFact);
-      return SetOfFactIterator(_findAnExactCall(_exactCallToListsOpt, exactCallStr));
+      if (currSlot == _removedSlot)
+        continue;
+      if (hasTheSameValue(*chunkPtr->slotToFact[currSlot]))
+        res.push_back(currSlot);
+      else
+        allHaveTheSameValue = false;
     }
-    return SetOfFactIterator(_findAnExactCall(_exactCallWithoutValueToListsOpt, exactCallStr));
+    if (allHaveTheSameValue)
+      return SetOfFactIterator(chunkPtr->slotToFact, factsOfTheAtomPtr->slots);
+    return SetOfFactIterator(chunkPtr->slotToFact, std::move(res));
   }
 
-  const std::list<Fact>* resPtr = nullptr;
-  auto _matchArg = [&](const std::map<std::string, std::list<Fact>>& pArgValueToValues,
+  const PostingList* resPtr = nullptr;
+  auto _matchArg = [&](const std::unordered_map<std::string, PostingList>& pArgValueToFacts,
                        const std::string& pArgValue) -> std::optional<typename SetOfFacts::SetOfFactIterator> {
-    auto itForThisValue = pArgValueToValues.find(pArgValue);
-    if (itForThisValue != pArgValueToValues.end())
+    auto itForThisValue = pArgValueToFacts.find(pArgValue);
+    if (itForThisValue != pArgValueToFacts.end())
     {
       if (resPtr != nullptr)
-        return SetOfFactIterator(intersectTwoLists(*resPtr, itForThisValue->second));
+      {
+        std::vector<FactSlot> intersection;
+        for (const auto& currSlot : resPtr->slots)
+          if (currSlot != _removedSlot && itForThisValue->second.contains(currSlot))
+            intersection.push_back(currSlot);
+        return SetOfFactIterator(chunkPtr->slotToFact, std::move(intersection));
+      }
       resPtr = &itForThisValue->second;
     }
     return {};
   };
 
-  auto itParameterToValues = _signatureToLists.find(pFact.factSignature());
-  if (itParameterToValues != _signatureToLists.end())
+  auto itSignatureIndex = chunkPtr->signatureToIndex.find(pFact.factSignature());
+  if (itSignatureIndex != chunkPtr->signatureToIndex.end())
   {
-    const ParameterToValues& parameterToValues = itParameterToValues->second;
+    const SignatureIndex& signatureIndex = itSignatureIndex->second;
 
     bool hasOnlyParameters = true;
     auto& factArguments = pFact.arguments();
@@ -375,7 +990,7 @@ typename SetOfFacts::SetOfFactIterator SetOfFacts::find(const Fact& pFact,
       if (factArguments[i].isEntity() && !factArguments[i].isAParameterToFill())
       {
         hasOnlyParameters = false;
-        auto subRes = _matchArg(parameterToValues.argIdToArgValueToValues[i], factArguments[i].entity().value);
+        auto subRes = _matchArg(signatureIndex.argIdToArgValueToFacts[i], factArguments[i].entity().value);
         if (subRes)
           return *subRes;
       }
@@ -387,19 +1002,19 @@ typename SetOfFacts::SetOfFactIterator SetOfFacts::find(const Fact& pFact,
       if (!fluentValue->isAParameterToFill() && !pFact.isValueNegated())
       {
         hasOnlyParameters = false;
-        auto subRes = _matchArg(parameterToValues.fluentValueToValues, fluentValue->value);
+        auto subRes = _matchArg(signatureIndex.fluentValueToFacts, fluentValue->value);
         if (subRes)
           return *subRes;
       }
     }
 
     if (hasOnlyParameters)
-      return SetOfFactIterator(&parameterToValues.all);
+      return SetOfFactIterator(chunkPtr->slotToFact, signatureIndex.all.slots);
   }
 
   if (resPtr != nullptr)
-    return SetOfFactIterator(resPtr);
-  return SetOfFactIterator(nullptr);
+    return SetOfFactIterator(chunkPtr->slotToFact, resPtr->slots);
+  return SetOfFactIterator();
 }
 
 std::optional<Entity> SetOfFacts::getFluentValue(const ogp::Fact& pFact) const
@@ -415,6 +1030,28 @@ std::optional<Entity> SetOfFacts::getFluentValue(const ogp::Fact& pFact) const
 }
 
 
+std::optional<Number> SetOfFacts::getFluentNumber(const Fact& pFact) const
+{
+  if (pFact.hasAFluentArgument())
+  {
+    auto resolvedFact = pFact.tryToResolveFluentArguments(*this);
+    if (!resolvedFact)
+      return {};
+    return getFluentNumber(*resolvedFact);
+  }
+
+  if (!FactIdTable::isGround(pFact))
+    return {};
+  const Chunk* chunkPtr = _getChunk(pFact.name());
+  if (chunkPtr == nullptr)
+    return {};
+  auto itAtom = chunkPtr->findAtom(_hashOfArguments(pFact), pFact);
+  if (itAtom != chunkPtr->atomHashToFacts.end())
+    return itAtom->second.number;
+  return {};
+}
+
+
 void SetOfFacts::extractPotentialArgumentsOfAFactParameter(
     std::set<Entity>& pPotentialArgumentsOfTheParameter,
     const Fact& pFact,
@@ -502,56 +1139,156 @@ bool SetOfFacts::hasFact(const Fact& pFact) const
 }
 
 
-void SetOfFacts::updateImmutableFacts(const Ontology& pOntology)
+bool SetOfFacts::contains(const Fact& pFact) const
 {
-  // Remove existing immutable facts
-  std::list<Fact> factsToRemove;
-  for (const auto& currFact : _facts)
-    if (currFact.first.predicate.isImmutable())
-      factsToRemove.emplace_back(currFact.first);
-  for (auto& currFact : factsToRemove)
-    erase(currFact);
+  if (!FactIdTable::isGround(pFact))
+  {
+    const Chunk* chunkPtr = _getChunk(pFact.name());
+    return chunkPtr != nullptr && chunkPtr->facts.count(pFact) > 0;
+  }
+
+  const Chunk* chunkPtr = _getChunk(pFact.name());
+  if (chunkPtr == nullptr)
+    return false;
+  const PostingList* factsOfTheAtomPtr = _findFactsOfAnAtom(*chunkPtr, pFact);
+  if (factsOfTheAtomPtr == nullptr)
+    return false;
+  for (const auto& currSlot : factsOfTheAtomPtr->slots)
+  {
+    if (currSlot == _removedSlot)
+      continue;
+    const Fact& currFact = *chunkPtr->slotToFact[currSlot];
+    if (currFact.isValueNegated() == pFact.isValueNegated() &&
+        _areValuesEquivalent(currFact.value(), pFact.value()))
+      return true;
+  }
+  return false;
+}
+
 
-  // Add new immutable facts
-  std::list<Fact> factsToAdd;
-  for (const auto& currFact : _facts)
-      if (pOntology.nameToPredicatePtr(Predicate::getImmutablePrefix() + currFact.first.name()) != nullptr)
-        factsToAdd.emplace_back(currFact.first);
-  for (auto& currFact : factsToAdd)
+std::list<std::pair<Fact, bool>> SetOfFacts::getFactsHoldingEntities(const std::set<std::string>& pEntityIds) const
+{
+  std::list<std::pair<Fact, bool>> res;
+  for (const auto& currChunk : _predicateNameToChunk)
   {
-    currFact.toImmutable();
-    add(currFact);
+    const Chunk& chunk = *currChunk.second;
+    std::set<FactSlot> slotsAlreadyAdded;
+    for (const auto& currEntityId : pEntityIds)
+    {
+      auto itFacts = chunk.entityToFacts.find(currEntityId);
+      if (itFacts == chunk.entityToFacts.end())
+        continue;
+      for (const auto& currSlot : itFacts->second.slots)
+      {
+        if (currSlot == _removedSlot || !slotsAlreadyAdded.insert(currSlot).second)
+          continue;
+        const Fact& fact = *chunk.slotToFact[currSlot];
+        res.emplace_back(fact, chunk.facts.find(fact)->second.canBeRemoved);
+      }
+    }
   }
+  return res;
+}
+
+
+bool SetOfFacts::hasEntity(const std::string& pEntityId) const
+{
+  for (const auto& currChunk : _predicateNameToChunk)
+    if (currChunk.second->entityToFacts.count(pEntityId) > 0)
+      return true;
+  return false;
 }
 
 
-void SetOfFacts::_removeAValueForList(std::list<Fact>& pList,
-                                     const Fact& pValue) const
+void SetOfFacts::updateImmutableFacts(const Ontology& pOntology,
+                                      std::list<std::pair<Fact, bool>>* pModificationsPtr)
 {
-  for (auto it = pList.begin(); it != pList.end(); ++it)
+  // Immutable facts that should be in the set, in the order of the facts
+  std::list<Fact> immutableFacts;
+  std::set<Fact> immutableFactsSet;
+  for (const auto& currFact : facts())
   {
-    if (*it == pValue)
+    if (!currFact.first.predicate().isImmutable() &&
+        pOntology.nameToPredicatePtr(Predicate::getImmutablePrefix() + currFact.first.name()) != nullptr)
     {
-      pList.erase(it);
-      return;
+      immutableFacts.emplace_back(currFact.first);
+      immutableFacts.back().toImmutable(pOntology);
+      immutableFactsSet.insert(immutableFacts.back());
     }
   }
+
+  // Remove the immutable facts that are no longer right, the others are kept
+  std::list<Fact> factsToRemove;
+  for (const auto& currFact : facts())
+    if (currFact.first.predicate().isImmutable() && immutableFactsSet.count(currFact.first) == 0)
+      factsToRemove.emplace_back(currFact.first);
+  for (auto& currFact : factsToRemove)
+    if (erase(currFact) && pModificationsPtr != nullptr)
+      pModificationsPtr->emplace_back(currFact, false);
+
+  // Add the missing immutable facts
+  for (auto& currFact : immutableFacts)
+    if (add(currFact) && pModificationsPtr != nullptr)
+      pModificationsPtr->emplace_back(currFact, true);
+}
+
+
+const SetOfFacts::PostingList* SetOfFacts::_findFactsOfAnAtom(const Chunk& pChunk,
+                                                              const Fact& pFact) const
+{
+  if (!FactIdTable::isGround(pFact))
+    return nullptr;
+  auto itAtom = pChunk.findAtom(_hashOfArguments(pFact), pFact);
+  if (itAtom != pChunk.atomHashToFacts.end())
+    return &itAtom->second.facts;
+  return nullptr;
 }
 
 
-const std::list<Fact>* SetOfFacts::_findAnExactCall(
-    const std::optional<std::map<std::string, std::list<Fact>>>& pExactCalls,
-    const std::string& pExactCall) const
+void SetOfFacts::_refreshFluentNumber(const Chunk& pChunk,
+                                      AtomFacts& pAtomFacts)
 {
-  if (pExactCalls)
+  pAtomFacts.number.reset();
+  for (const auto& currSlot : pAtomFacts.facts.slots)
   {
-    auto it = pExactCalls->find(pExactCall);
-    if (it != pExactCalls->end())
-      return &it->second;
+    if (currSlot == _removedSlot)
+      continue;
+    const auto& value = pChunk.slotToFact[currSlot]->value();
+    if (value)
+      pAtomFacts.number = entityToNumberOpt(*value);
+    return;
   }
+}
+
+
+const SetOfFacts::Chunk* SetOfFacts::_getChunk(const std::string& pPredicateName) const
+{
+  auto it = _predicateNameToChunk.find(pPredicateName);
+  if (it != _predicateNameToChunk.end())
+    return it->second.get();
   return nullptr;
 }
 
 
+SetOfFacts::Chunk& SetOfFacts::_getChunkToModify(const std::string& pPredicateName)
+{
+  auto& chunkPtr = _predicateNameToChunk[pPredicateName];
+  if (!chunkPtr)
+    chunkPtr = std::make_shared<Chunk>();
+  else if (chunkPtr.use_count() > 1)
+    chunkPtr = std::make_shared<Chunk>(*chunkPtr); // Copy on write
+  // The chunk is owned only by this set of facts so we can modify it
+  return const_cast<Chunk&>(*chunkPtr);
+}
+
+
+void SetOfFacts::_removeChunkIfEmpty(const std::string& pPredicateName)
+{
+  auto it = _predicateNameToChunk.find(pPredicateName);
+  if (it != _predicateNameToChunk.end() && it->second->facts.empty())
+    _predicateNameToChunk.erase(it);
+}
+
+
 
 } // !ogp
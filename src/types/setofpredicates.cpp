@@ -1,4 +1,5 @@
 #include <orderedgoalsplanner/types/setofpredicates.hpp>
+#include <atomic>
 #include <vector>
 #include <orderedgoalsplanner/types/setoftypes.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
@@ -6,9 +7,19 @@
 
 namespace ogp
 {
+namespace
+{
+std::uint64_t _newVersion()
+{
+  static std::atomic<std::uint64_t> lastVersion{0};
+  return ++lastVersion;
+}
+}
+
 
 SetOfPredicates::SetOfPredicates()
-    : _nameToPredicate()
+    : _nameToPredicate(),
+      _version(_newVersion())
 {
 }
 
@@ -49,21 +60,26 @@ SetOfPredicates SetOfPredicates::fromPddl(const std::string& pStr,
 void SetOfPredicates::addAll(const SetOfPredicates& pOther)
 {
   for (const auto& currNameToPredicate : pOther._nameToPredicate)
-    addPredicate(currNameToPredicate.second);
+  {
+    _nameToPredicate.erase(currNameToPredicate.first);
+    _nameToPredicate.emplace(currNameToPredicate.first, currNameToPredicate.second);
+  }
+  _version = _newVersion();
 }
 
 void SetOfPredicates::addPredicate(const Predicate& pPredicate)
 {
   _nameToPredicate.erase(pPredicate.name);
-  _nameToPredicate.emplace(pPredicate.name, pPredicate);
+  _nameToPredicate.emplace(pPredicate.name, std::make_shared<const Predicate>(pPredicate));
+  _version = _newVersion();
 }
 
 void SetOfPredicates::updateImmutablePredicates()
 {
   std::map<std::string, Predicate> nameToImmutablePredicate;
   for (auto& currNameToPredicate : _nameToPredicate) {
-    if (!currNameToPredicate.second.isImmutable()) {
-      auto newPredicate = currNameToPredicate.second.createImmutableCopy();
+    if (!currNameToPredicate.second->isImmutable()) {
+      auto newPredicate = currNameToPredicate.second->createImmutableCopy();
       nameToImmutablePredicate.emplace(currNameToPredicate.first, std::move(newPredicate));
     }
   }
@@ -75,15 +91,23 @@ const Predicate* SetOfPredicates::nameToPredicatePtr(const std::string& pName) c
 {
   auto it = _nameToPredicate.find(pName);
   if (it != _nameToPredicate.end())
-    return &it->second;
+    return it->second.get();
   return nullptr;
 }
 
-Predicate SetOfPredicates::nameToPredicate(const std::string& pName) const
+std::shared_ptr<const Predicate> SetOfPredicates::nameToPredicateSharedPtr(const std::string& pName) const
 {
   auto it = _nameToPredicate.find(pName);
   if (it != _nameToPredicate.end())
     return it->second;
+  return {};
+}
+
+Predicate SetOfPredicates::nameToPredicate(const std::string& pName) const
+{
+  auto it = _nameToPredicate.find(pName);
+  if (it != _nameToPredicate.end())
+    return *it->second;
 
   throw std::runtime_error("\"" + pName + "\" is not a predicate name");
 }
@@ -96,16 +120,16 @@ std::string SetOfPredicates::toPddl(PredicatePddlType pTypeFilter,
   bool firstIteration = true;
   for (auto& currNameToPredicate : _nameToPredicate)
   {
-    if (pTypeFilter == PredicatePddlType::PDDL_PREDICATE && currNameToPredicate.second.value)
+    if (pTypeFilter == PredicatePddlType::PDDL_PREDICATE && currNameToPredicate.second->value)
       continue;
-    if (pTypeFilter == PredicatePddlType::PDDL_FUNCTION && !currNameToPredicate.second.value)
+    if (pTypeFilter == PredicatePddlType::PDDL_FUNCTION && !currNameToPredicate.second->value)
       continue;
 
     if (firstIteration)
       firstIteration = false;
     else
       res += "\n";
-    res += std::string(pIdentation, ' ') + currNameToPredicate.second.toPddl();
+    res += std::string(pIdentation, ' ') + currNameToPredicate.second->toPddl();
   }
   return res;
 }
@@ -120,7 +144,7 @@ std::string SetOfPredicates::toStr() const
       firstIteration = false;
     else
       res += "\n";
-    res += currNameToPredicate.second.toStr();
+    res += currNameToPredicate.second->toStr();
   }
   return res;
 }
@@ -129,9 +153,9 @@ bool SetOfPredicates::hasPredicateOfPddlType(PredicatePddlType pTypeFilter) cons
 {
   for (auto& currNameToPredicate : _nameToPredicate)
   {
-    if (pTypeFilter == PredicatePddlType::PDDL_PREDICATE && currNameToPredicate.second.value)
+    if (pTypeFilter == PredicatePddlType::PDDL_PREDICATE && currNameToPredicate.second->value)
       continue;
-    if (pTypeFilter == PredicatePddlType::PDDL_FUNCTION && !currNameToPredicate.second.value)
+    if (pTypeFilter == PredicatePddlType::PDDL_FUNCTION && !currNameToPredicate.second->value)
       continue;
     return true;
   }
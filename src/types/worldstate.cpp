@@ -1,5 +1,7 @@
 #include <orderedgoalsplanner/types/worldstate.hpp>
+#include <atomic>
 #include <list>
+#include <stdexcept>
 #include <orderedgoalsplanner/types/goalstack.hpp>
 #include <orderedgoalsplanner/types/actioninvocationwithgoal.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
@@ -10,11 +12,19 @@
 #include <orderedgoalsplanner/util/util.hpp>
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 #include "expressionParsed.hpp"
+#include "../algo/incrementalmatcher.hpp"
 
 namespace ogp
 {
 namespace
 {
+std::uint64_t _newWorldStateId()
+{
+  static std::atomic<std::uint64_t> lastId{0};
+  return ++lastId;
+}
+
+
 std::optional<bool> _isPresentWithAnotherValue(const Fact& pFact,
                                                const SetOfFacts::SetOfFactIterator& pSetOfFacts,
                                                ParameterValuesWithConstraints& pArgumentsToFilter)
@@ -58,7 +68,19 @@ WorldState::WorldState(const SetOfFacts* pFactsPtr)
     onPunctualFacts(),
     onFactsAdded(),
     onFactsRemoved(),
-    _factsMapping(pFactsPtr != nullptr ? *pFactsPtr : SetOfFacts())
+    onFactChanges(),
+    _factsMapping(pFactsPtr != nullptr ? *pFactsPtr : SetOfFacts()),
+    _isInATransaction(false),
+    _lastChangeSequenceNumber(0),
+    _changeJournalCapacity(0),
+    _changeJournal(),
+    _factChangesToNotify(),
+    _changedFactToNbOfReferences(),
+    _id(_newWorldStateId()),
+    _predicateToLastChangeSequenceNumber(),
+    _lastChangeOfAllPredicatesSequenceNumber(0),
+    _immutableFactsUpdateSequenceNumber(0),
+    _immutableFactsPredicatesVersion(0, 0)
 {
 }
 
@@ -68,7 +90,19 @@ WorldState::WorldState(const WorldState& pOther)
     onPunctualFacts(),
     onFactsAdded(),
     onFactsRemoved(),
-    _factsMapping(pOther._factsMapping)
+    onFactChanges(),
+    _factsMapping(pOther._factsMapping),
+    _isInATransaction(false),
+    _lastChangeSequenceNumber(0),
+    _changeJournalCapacity(0),
+    _changeJournal(),
+    _factChangesToNotify(),
+    _changedFactToNbOfReferences(),
+    _id(_newWorldStateId()),
+    _predicateToLastChangeSequenceNumber(),
+    _lastChangeOfAllPredicatesSequenceNumber(0),
+    _immutableFactsUpdateSequenceNumber(0),
+    _immutableFactsPredicatesVersion(0, 0)
 {
 }
 
@@ -81,6 +115,119 @@ WorldState::~WorldState()
 void WorldState::operator=(const WorldState& pOther)
 {
   _factsMapping = pOther._factsMapping;
+  // The facts are replaced without being journaled, so the changes since the previous sequence numbers are lost
+  _stampChangeOfAllPredicates();
+  for (const auto& currFactChange : _changeJournal)
+    _releaseChangedFact(currFactChange);
+  _changeJournal.clear();
+}
+
+
+void WorldState::setChangeJournalCapacity(std::size_t pCapacity)
+{
+  _changeJournalCapacity = pCapacity;
+  while (_changeJournal.size() > _changeJournalCapacity)
+  {
+    _releaseChangedFact(_changeJournal.front());
+    _changeJournal.pop_front();
+  }
+}
+
+
+bool WorldState::iterateOnChangesSince(const std::function<void (const FactChange&)>& pCallback,
+                                       std::uint64_t pSequenceNumber) const
+{
+  if (pSequenceNumber >= _lastChangeSequenceNumber)
+    return true;
+  if (_changeJournal.empty() || _changeJournal.front().sequenceNumber > pSequenceNumber + 1)
+    return false;
+  auto itBegin = std::lower_bound(_changeJournal.begin(), _changeJournal.end(), pSequenceNumber + 1,
+                                  [](const FactChange& pFactChange, std::uint64_t pNumber) {
+    return pFactChange.sequenceNumber < pNumber;
+  });
+  for (auto it = itBegin; it != _changeJournal.end(); ++it)
+    pCallback(*it);
+  return true;
+}
+
+
+void WorldState::rollbackTo(const Checkpoint& pCheckpoint)
+{
+  _rollbackTo(pCheckpoint, true);
+}
+
+
+void WorldState::_rollbackTo(const Checkpoint& pCheckpoint,
+                             bool pToNotify)
+{
+  bool toNotify = pToNotify && !onFactChanges.empty();
+  if (_changeJournalCapacity == 0 && !toNotify)
+  {
+    _factsMapping.iterateOnModificationsSince([&](const Fact& pFact, bool) { _stampPredicateChange(pFact.name()); }, pCheckpoint);
+    _factsMapping.rollbackTo(pCheckpoint);
+    return;
+  }
+
+  // Journal the inverse of the undone modifications, in the order they are undone
+  std::vector<std::pair<Fact, bool>> undoneModifications;
+  _factsMapping.iterateOnModificationsSince([&](const Fact& pFact, bool pWasAdded) {
+    undoneModifications.emplace_back(pFact, pWasAdded);
+  }, pCheckpoint);
+  _factsMapping.rollbackTo(pCheckpoint);
+  for (auto it = undoneModifications.rbegin(); it != undoneModifications.rend(); ++it)
+    _recordFactChange(it->second ? FactChangeType::REMOVED : FactChangeType::ADDED, it->first, toNotify);
+  if (toNotify && !_isInATransaction)
+    _notifyFactChanges();
+}
+
+
+void WorldState::_recordFactChange(FactChangeType pType,
+                                   const Fact& pFact,
+                                   bool pToNotify)
+{
+  _stampPredicateChange(pFact.name());
+  bool toNotify = pToNotify && !onFactChanges.empty();
+  if (_changeJournalCapacity == 0 && !toNotify)
+    return;
+
+  auto itChangedFact = _changedFactToNbOfReferences.emplace(pFact, 0).first;
+  FactChange factChange{_lastChangeSequenceNumber, pType, &itChangedFact->first};
+  if (_changeJournalCapacity > 0)
+  {
+    if (_changeJournal.size() == _changeJournalCapacity)
+    {
+      _releaseChangedFact(_changeJournal.front());
+      _changeJournal.pop_front();
+    }
+    _changeJournal.push_back(factChange);
+    ++itChangedFact->second;
+  }
+  if (toNotify)
+  {
+    _factChangesToNotify.push_back(factChange);
+    ++itChangedFact->second;
+  }
+}
+
+
+void WorldState::_releaseChangedFact(const FactChange& pFactChange)
+{
+  auto itChangedFact = _changedFactToNbOfReferences.find(*pFactChange.factPtr);
+  if (itChangedFact != _changedFactToNbOfReferences.end() &&
+      --itChangedFact->second == 0)
+    _changedFactToNbOfReferences.erase(itChangedFact);
+}
+
+
+void WorldState::_notifyFactChanges()
+{
+  if (_factChangesToNotify.empty())
+    return;
+  auto factChanges = std::move(_factChangesToNotify);
+  _factChangesToNotify.clear();
+  onFactChanges(factChanges);
+  for (const auto& currFactChange : factChanges)
+    _releaseChangedFact(currFactChange);
 }
 
 
@@ -136,6 +283,29 @@ bool WorldState::applyDelta(const SetOfFacts::Delta& pDelta,
 }
 
 
+bool WorldState::applyDelta(const std::vector<SetOfFacts::DeltaEntry>& pDeltaEntries,
+                            GoalStack& pGoalStack,
+                            const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
+                            const SetOfCallbacks& pCallbacks,
+                            const Ontology& pOntology,
+                            const SetOfEntities& pObjects,
+                            const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                            bool pCanFactsBeRemoved)
+{
+  WhatChanged whatChanged;
+  for (const auto& currEntry : pDeltaEntries)
+    if (currEntry.isAdded)
+      _addAFact(whatChanged, *currEntry.factPtr, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pObjects, pNow, pCanFactsBeRemoved);
+  for (const auto& currEntry : pDeltaEntries)
+    if (!currEntry.isAdded)
+      _removeAFact(whatChanged, *currEntry.factPtr);
+  pGoalStack._removeNoStackableGoalsAndNotifyGoalsChanged(*this, pOntology.constants, pObjects, pNow);
+  bool goalChanged = false;
+  _notifyWhatChanged(whatChanged, goalChanged, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pObjects, pNow);
+  return whatChanged.hasFactsToModifyInTheWorldForSure();
+}
+
+
 bool WorldState::applyEffect(const std::map<Parameter, Entity>& pParameters,
                              const std::unique_ptr<WorldStateModification>& pEffect,
                              bool& pGoalChanged,
@@ -203,7 +373,7 @@ template bool WorldState::addFacts<std::vector<Fact>>(const std::vector<Fact>&,
 
 bool WorldState::hasFact(const Fact& pFact) const
 {
-  return _factsMapping.facts().count(pFact) > 0;
+  return _factsMapping.contains(pFact);
 }
 
 bool WorldState::removeFact(const Fact& pFact,
@@ -244,28 +414,15 @@ bool WorldState::removeFactsHoldingEntities(const std::set<std::string>& pEntity
                                             const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
 {
   WhatChanged whatChanged;
-  auto& facts = _factsMapping.facts();
-  for (auto factIt = facts.begin(); factIt != facts.end(); )
+  for (auto& currFact : _factsMapping.getFactsHoldingEntities(pEntityIdsofFactsToRemove))
   {
-    bool factRemoved = false;
-    const Fact& currFact = factIt->first;
-    for (const auto& currEntityId : pEntityIdsofFactsToRemove)
-    {
-      if (currFact.hasEntity(currEntityId))
-      {
-        if (!factIt->second)
-          return false;
-
-        whatChanged.removedFacts.insert(currFact);
-        factIt = _factsMapping.eraseFactIt(factIt);
-        factRemoved = true;
-        break;
-      }
-    }
-    if (factRemoved)
-      continue;
-    ++factIt;
+    if (!currFact.second)
+      return false;
+    whatChanged.insertRemovedFact(currFact.first);
   }
+  for (const auto& currFact : whatChanged.removedFacts)
+    if (_factsMapping.erase(currFact))
+      _recordFactChange(FactChangeType::REMOVED, currFact);
 
   pGoalStack._removeNoStackableGoalsAndNotifyGoalsChanged(*this, pOntology.constants, pObjects, pNow);
   bool goalChanged = false;
@@ -305,10 +462,11 @@ void WorldState::_addAFact(WhatChanged& pWhatChanged,
 {
   if (pFact.isPunctual())
   {
-    pWhatChanged.punctualFacts.insert(pFact);
+    pWhatChanged.insertPunctualFact(pFact);
+    _recordFactChange(FactChangeType::PUNCTUAL, pFact);
     return;
   }
-  if (_factsMapping.facts().count(pFact) > 0)
+  if (_factsMapping.contains(pFact))
     return;
   bool skipThisFact = false;
 
@@ -330,13 +488,21 @@ void WorldState::_addAFact(WhatChanged& pWhatChanged,
            (pFact.isValueNegated() && !currExistingFact.isValueNegated() && pFact.value() == currExistingFact.value()) ||
            (!pFact.isValueNegated() && currExistingFact.isValueNegated())))
       {
-        WhatChanged subWhatChanged;
-        subWhatChanged.addedFacts.insert(pFact);
-        _removeFacts(subWhatChanged, std::vector<ogp::Fact>{currExistingFact});
-        pGoalStack._removeNoStackableGoalsAndNotifyGoalsChanged(*this, pOntology.constants, pObjects, pNow);
-        bool goalChanged = false;
-        _notifyWhatChanged(subWhatChanged, goalChanged, pGoalStack, pSetOfEvents, pCallbacks,
-                           pOntology, pObjects, pNow);
+        if (_isInATransaction)
+        {
+          // The removal will be notified with the other modifications of the transaction
+          _removeFacts(pWhatChanged, std::vector<ogp::Fact>{currExistingFact});
+        }
+        else
+        {
+          WhatChanged subWhatChanged;
+          subWhatChanged.insertAddedFact(pFact);
+          _removeFacts(subWhatChanged, std::vector<ogp::Fact>{currExistingFact});
+          pGoalStack._removeNoStackableGoalsAndNotifyGoalsChanged(*this, pOntology.constants, pObjects, pNow);
+          bool goalChanged = false;
+          _notifyWhatChanged(subWhatChanged, goalChanged, pGoalStack, pSetOfEvents, pCallbacks,
+                             pOntology, pObjects, pNow);
+        }
         aFactWasRemoved = true;
         break;
       }
@@ -352,8 +518,9 @@ void WorldState::_addAFact(WhatChanged& pWhatChanged,
 
   if (!skipThisFact)
   {
-    pWhatChanged.addedFacts.insert(pFact);
-    _factsMapping.add(pFact, pCanFactsBeRemoved);
+    pWhatChanged.insertAddedFact(pFact);
+    if (_factsMapping.add(pFact, pCanFactsBeRemoved))
+      _recordFactChange(FactChangeType::ADDED, pFact);
   }
 }
 
@@ -369,8 +536,16 @@ void WorldState::_removeFacts(WhatChanged& pWhatChanged,
 void WorldState::_removeAFact(WhatChanged& pWhatChanged,
                               const Fact& pFact)
 {
-  pWhatChanged.removedFacts.insert(pFact);
-  _factsMapping.erase(pFact);
+  pWhatChanged.insertRemovedFact(pFact);
+  if (_changeJournalCapacity == 0 && onFactChanges.empty())
+  {
+    if (_factsMapping.erase(pFact))
+      _stampPredicateChange(pFact.name());
+    return;
+  }
+  std::optional<Fact> erasedFact;
+  if (_factsMapping.erase(pFact, &erasedFact))
+    _recordFactChange(FactChangeType::REMOVED, *erasedFact);
 }
 
 void WorldState::_modify(WhatChanged& pWhatChanged,
@@ -399,7 +574,8 @@ void WorldState::_modify(WhatChanged& pWhatChanged,
 
   _addFacts(pWhatChanged, factsToAdd, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pObjects, pNow, pCanFactsBeRemoved);
   _removeFacts(pWhatChanged, factsToRemove);
-  pGoalStack._removeNoStackableGoalsAndNotifyGoalsChanged(*this, pOntology.constants, pObjects, pNow);
+  if (!_isInATransaction)
+    pGoalStack._removeNoStackableGoalsAndNotifyGoalsChanged(*this, pOntology.constants, pObjects, pNow);
 }
 
 
@@ -429,9 +605,12 @@ void WorldState::setFacts(const std::set<Fact>& pFacts,
                           const SetOfEntities& pObjects,
                           const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
 {
+  for (const auto& currFact : _factsMapping.facts())
+    _recordFactChange(FactChangeType::REMOVED, currFact.first);
   _factsMapping.clear();
   for (const auto& currFact : pFacts)
-    _factsMapping.add(currFact);
+    if (_factsMapping.add(currFact))
+      _recordFactChange(FactChangeType::ADDED, currFact);
   WhatChanged whatChanged;
   pGoalStack._removeNoStackableGoalsAndNotifyGoalsChanged(*this, pOntology.constants, pObjects, pNow);
   bool goalChanged = false;
@@ -440,17 +619,157 @@ void WorldState::setFacts(const std::set<Fact>& pFacts,
 }
 
 
+WorldState::Transaction::Transaction(WorldState& pWorldState,
+                                     GoalStack& pGoalStack,
+                                     const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
+                                     const SetOfCallbacks& pCallbacks,
+                                     const Ontology& pOntology,
+                                     const SetOfEntities& pObjects,
+                                     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                     bool pCanFactsBeRemoved)
+  : _worldState(pWorldState),
+    _goalStack(pGoalStack),
+    _setOfEvents(pSetOfEvents),
+    _callbacks(pCallbacks),
+    _ontology(pOntology),
+    _objects(pObjects),
+    _now(pNow ? std::make_unique<std::chrono::steady_clock::time_point>(*pNow) : nullptr),
+    _canFactsBeRemoved(pCanFactsBeRemoved),
+    _whatChanged(),
+    _checkpoint(),
+    _nbOfFactChangesToNotify(pWorldState._factChangesToNotify.size()),
+    _isOpen(true)
+{
+  if (_worldState._isInATransaction)
+    throw std::runtime_error("A transaction is already open on this world state");
+  _worldState._isInATransaction = true;
+  _checkpoint = _worldState._factsMapping.checkpoint();
+}
+
+
+WorldState::Transaction::~Transaction()
+{
+  if (!_isOpen)
+    return;
+  try
+  {
+    rollback();
+  }
+  catch (...) {}
+}
+
+
+void WorldState::Transaction::addFact(const Fact& pFact)
+{
+  if (!_isOpen)
+    throw std::runtime_error("The transaction is already committed");
+  _worldState._addAFact(_whatChanged, pFact, _goalStack, _setOfEvents, _callbacks,
+                        _ontology, _objects, _now, _canFactsBeRemoved);
+}
+
+
+void WorldState::Transaction::removeFact(const Fact& pFact)
+{
+  if (!_isOpen)
+    throw std::runtime_error("The transaction is already committed");
+  _worldState._removeAFact(_whatChanged, pFact);
+}
+
+
+void WorldState::Transaction::modify(const WorldStateModification* pWsModifPtr)
+{
+  if (!_isOpen)
+    throw std::runtime_error("The transaction is already committed");
+  _worldState._modify(_whatChanged, pWsModifPtr, _goalStack, _setOfEvents, _callbacks,
+                      _ontology, _objects, _now, _canFactsBeRemoved);
+}
+
+
+bool WorldState::Transaction::commit()
+{
+  if (!_isOpen)
+    throw std::runtime_error("The transaction is already committed");
+  _isOpen = false;
+
+  // A fact added and removed in the transaction is notified only if it is not as it was before the transaction
+  std::map<Fact, bool> factToWasPresentBefore;
+  _worldState._factsMapping.iterateOnModificationsSince([&](const Fact& pFact, bool pWasAdded) {
+    factToWasPresentBefore.emplace(pFact, !pWasAdded);
+  }, _checkpoint);
+  for (auto itAddedFact = _whatChanged.addedFacts.begin(); itAddedFact != _whatChanged.addedFacts.end(); )
+  {
+    auto itRemovedFact = _whatChanged.removedFacts.find(*itAddedFact);
+    if (itRemovedFact == _whatChanged.removedFacts.end())
+    {
+      ++itAddedFact;
+      continue;
+    }
+    auto itWasPresentBefore = factToWasPresentBefore.find(*itAddedFact);
+    bool wasPresentBefore = itWasPresentBefore != factToWasPresentBefore.end() ?
+          itWasPresentBefore->second : _worldState._factsMapping.contains(*itAddedFact);
+    bool isPresentNow = _worldState._factsMapping.contains(*itAddedFact);
+    if (wasPresentBefore != isPresentNow && isPresentNow)
+    {
+      _whatChanged.removedFacts.erase(itRemovedFact);
+      ++itAddedFact;
+      continue;
+    }
+    if (wasPresentBefore == isPresentNow)
+      _whatChanged.removedFacts.erase(itRemovedFact);
+    itAddedFact = _whatChanged.addedFacts.erase(itAddedFact);
+  }
+  _whatChanged.resetFactsToPropagate();
+  _worldState._factsMapping.releaseCheckpoint(_checkpoint);
+  _worldState._isInATransaction = false;
+
+  _goalStack._removeNoStackableGoalsAndNotifyGoalsChanged(_worldState, _ontology.constants, _objects, _now);
+  bool goalChanged = false;
+  _worldState._notifyWhatChanged(_whatChanged, goalChanged, _goalStack, _setOfEvents, _callbacks,
+                                 _ontology, _objects, _now);
+  return _whatChanged.hasFactsToModifyInTheWorldForSure();
+}
+
+
+void WorldState::Transaction::rollback()
+{
+  if (!_isOpen)
+    throw std::runtime_error("The transaction is already committed");
+  _isOpen = false;
+  _worldState._isInATransaction = false;
+
+  // The modifications of the transaction were never notified
+  auto& factChangesToNotify = _worldState._factChangesToNotify;
+  for (std::size_t i = _nbOfFactChangesToNotify; i < factChangesToNotify.size(); ++i)
+    _worldState._releaseChangedFact(factChangesToNotify[i]);
+  if (factChangesToNotify.size() > _nbOfFactChangesToNotify)
+    factChangesToNotify.erase(factChangesToNotify.begin() + _nbOfFactChangesToNotify, factChangesToNotify.end());
+  _worldState._rollbackTo(_checkpoint, false);
+}
+
+
 void WorldState::updateImmutableFacts(const Ontology& pOntology)
 {
-  _factsMapping.updateImmutableFacts(pOntology);
+  // The immutable facts only depend on the other facts and on the predicates
+  auto predicatesVersion = pOntology.predicatesVersion();
+  if (_immutableFactsPredicatesVersion == predicatesVersion &&
+      _immutableFactsUpdateSequenceNumber == _lastChangeSequenceNumber)
+    return;
+  std::list<std::pair<Fact, bool>> modifications;
+  _factsMapping.updateImmutableFacts(pOntology, &modifications);
+  // Like the other modifications, they are journaled and notified
+  for (const auto& currModification : modifications)
+    _recordFactChange(currModification.second ? FactChangeType::ADDED : FactChangeType::REMOVED,
+                      currModification.first);
+  if (!_isInATransaction)
+    _notifyFactChanges();
+  _immutableFactsPredicatesVersion = predicatesVersion;
+  _immutableFactsUpdateSequenceNumber = _lastChangeSequenceNumber;
 }
 
 
 bool WorldState::isOptionalFactSatisfied(const FactOptional& pFactOptional) const
 {
-  const auto& facts = _factsMapping.facts();
-  return (pFactOptional.isFactNegated || facts.count(pFactOptional.fact) > 0) &&
-      (!pFactOptional.isFactNegated || facts.count(pFactOptional.fact) == 0);
+  return _factsMapping.contains(pFactOptional.fact) != pFactOptional.isFactNegated;
 }
 
 
@@ -547,7 +866,50 @@ bool WorldState::isGoalSatisfied(const Goal& pGoal,
                                  const SetOfEntities& pConstants,
                                  const SetOfEntities& pObjects) const
 {
-  return pGoal.objective().isTrue(*this, pConstants, pObjects);
+  if (pGoal._watchedPredicates.empty())
+    return pGoal.objective().isTrue(*this, pConstants, pObjects);
+
+  auto satisfactionCache = pGoal._getSatisfactionCache();
+  if (satisfactionCache.worldStateId == _id &&
+      !hasAPredicateChangedSince(pGoal._watchedPredicates, satisfactionCache.sequenceNumber))
+    return satisfactionCache.isSatisfied;
+
+  // The objective is evaluated without the lock, the threads only share the result
+  satisfactionCache.isSatisfied = pGoal.objective().isTrue(*this, pConstants, pObjects);
+  satisfactionCache.worldStateId = _id;
+  satisfactionCache.sequenceNumber = _lastChangeSequenceNumber;
+  std::lock_guard<std::mutex> lock(pGoal._satisfactionCacheMutex);
+  pGoal._satisfactionCache = satisfactionCache;
+  return satisfactionCache.isSatisfied;
+}
+
+
+bool WorldState::hasAPredicateChangedSince(const std::vector<std::string>& pPredicateNames,
+                                           std::uint64_t pSequenceNumber) const
+{
+  if (_lastChangeOfAllPredicatesSequenceNumber > pSequenceNumber)
+    return true;
+  for (const auto& currPredicateName : pPredicateNames)
+  {
+    auto it = _predicateToLastChangeSequenceNumber.find(currPredicateName);
+    if (it != _predicateToLastChangeSequenceNumber.end() && it->second > pSequenceNumber)
+      return true;
+  }
+  return false;
+}
+
+
+void WorldState::_stampPredicateChange(const std::string& pPredicateName)
+{
+  ++_lastChangeSequenceNumber;
+  _predicateToLastChangeSequenceNumber[pPredicateName] = _lastChangeSequenceNumber;
+}
+
+
+void WorldState::_stampChangeOfAllPredicates()
+{
+  ++_lastChangeSequenceNumber;
+  _lastChangeOfAllPredicatesSequenceNumber = _lastChangeSequenceNumber;
 }
 
 
@@ -599,10 +961,7 @@ void WorldState::iterateOnMatchingFacts
 
 bool WorldState::hasEntity(const std::string& pEntityId) const
 {
-  for (const auto& currFact : _factsMapping.facts())
-    if (currFact.first.hasEntity(pEntityId))
-      return true;
-  return false;
+  return _factsMapping.hasEntity(pEntityId);
 }
 
 
@@ -611,7 +970,7 @@ bool WorldState::_tryToApplyEvent(std::set<EventId>& pEventsAlreadyApplied,
                                   bool& pGoalChanged,
                                   GoalStack& pGoalStack,
                                   const EventId& pEventId,
-                                  const std::map<EventId, Event>& pEvents,
+                                  const SetOfEvents& pSetOfEventsOfTheEvent,
                                   const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
                                   const SetOfCallbacks& pCallbacks,
                                   const Ontology& pOntology,
@@ -625,11 +984,48 @@ bool WorldState::_tryToApplyEvent(std::set<EventId>& pEventsAlreadyApplied,
     if (pEventsAlreadyApplied.count(pEventId) == 0)
     {
       pEventsAlreadyApplied.insert(pEventId);
-      auto itEvent = pEvents.find(pEventId);
-      if (itEvent != pEvents.end())
+      const auto& events = pSetOfEventsOfTheEvent.events();
+      auto itEvent = events.find(pEventId);
+      if (itEvent != events.end())
       {
         const Event& currEvent = itEvent->second;
 
+        const auto* incrementalMatcherPtr = pSetOfEventsOfTheEvent.incrementalMatcher(pEventId);
+        if (incrementalMatcherPtr != nullptr)
+        {
+          // Only the new complete matches are applied, the other ones were applied when they appeared
+          std::list<std::map<Parameter, Entity>> newMatches;
+          incrementalMatcherPtr->iterateOnNewMatches([&](const std::map<Parameter, Entity>& pParametersToValue) {
+            newMatches.emplace_back(pParametersToValue);
+            return false;
+          }, pWhatChanged.addedFacts, _factsMapping);
+          if (!newMatches.empty())
+          {
+            if (currEvent.factsToModify)
+            {
+              for (const auto& currParametersToValue : newMatches)
+              {
+                if (currParametersToValue.empty())
+                {
+                  _modify(pWhatChanged, &*currEvent.factsToModify, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pObjects, pNow, canFactsBeRemoved);
+                  continue;
+                }
+                auto factsToModify = currEvent.factsToModify->clone(&currParametersToValue);
+                _modify(pWhatChanged, &*factsToModify, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pObjects, pNow, canFactsBeRemoved);
+              }
+            }
+            if (pGoalStack.addGoals(currEvent.goalsToAdd, *this, pOntology.constants, pObjects, pNow))
+              pGoalChanged = true;
+            somethingChanged = true;
+          }
+          else
+          {
+            // Without a new match the event can still be applied by the facts of the next rounds
+            pEventsAlreadyApplied.erase(pEventId);
+          }
+          return somethingChanged;
+        }
+
         ParameterValuesWithConstraints parametersToValues;
         for (const auto& currParam : currEvent.parameters)
           parametersToValues[currParam];
@@ -692,15 +1088,28 @@ void WorldState::_tryToCallCallback(std::set<CallbackId>& pCallbackAlreadyCalled
                                     const SetOfEntities& pConstants,
                                     const SetOfEntities& pObjects,
                                     const std::string& pCallbackId,
-                                    const std::map<CallbackId, ConditionToCallback>& pCallbacks)
+                                    const SetOfCallbacks& pCallbacks)
 {
   if (pCallbackAlreadyCalled.count(pCallbackId) == 0)
   {
-    auto itCallback = pCallbacks.find(pCallbackId);
-    if (itCallback != pCallbacks.end())
+    auto& callbacks = pCallbacks.callbacks();
+    auto itCallback = callbacks.find(pCallbackId);
+    if (itCallback != callbacks.end())
     {
       const ConditionToCallback& currCallback = itCallback->second;
 
+      const auto* incrementalMatcherPtr = pCallbacks.incrementalMatcher(pCallbackId);
+      if (incrementalMatcherPtr != nullptr)
+      {
+        // The callback is called only if the condition has a new complete match
+        if (incrementalMatcherPtr->hasANewMatch(pWhatChanged.addedFacts, _factsMapping))
+        {
+          pCallbackAlreadyCalled.insert(pCallbackId);
+          currCallback.callback();
+        }
+        return;
+      }
+
       ParameterValuesWithConstraints parametersToValues;
       for (const auto& currParam : currCallback.parameters)
         parametersToValues[currParam];
@@ -717,6 +1126,18 @@ void WorldState::_tryToCallCallback(std::set<CallbackId>& pCallbackAlreadyCalled
   }
 }
 
+void WorldState::WhatChanged::resetFactsToPropagate()
+{
+  factsToPropagate.clear();
+  for (const auto& currFact : punctualFacts)
+    factsToPropagate.emplace_back(&currFact, FactChangeType::PUNCTUAL);
+  for (const auto& currFact : addedFacts)
+    factsToPropagate.emplace_back(&currFact, FactChangeType::ADDED);
+  for (const auto& currFact : removedFacts)
+    factsToPropagate.emplace_back(&currFact, FactChangeType::REMOVED);
+}
+
+
 void WorldState::_notifyWhatChanged(WhatChanged& pWhatChanged,
                                     bool& pGoalChanged,
                                     GoalStack& pGoalStack,
@@ -729,84 +1150,57 @@ void WorldState::_notifyWhatChanged(WhatChanged& pWhatChanged,
   if (pWhatChanged.somethingChanged())
   {
     // manage the events
+    // Each round only considers the facts produced by the previous round, because an event is tried only once
     std::map<SetOfEventsId, std::set<EventId>> soeToEventsAlreadyApplied;
     std::set<CallbackId> callbackAlreadyCalled;
-    bool needAnotherLoop = true;
-    while (needAnotherLoop)
+    // Callbacks reached by a changed fact, in the order they were reached
+    std::vector<CallbackId> callbacksToTry;
+    std::set<CallbackId> callbacksToTrySet;
+    std::vector<std::pair<const Fact*, FactChangeType>> factsOfTheRound;
+    const FactChangeType factChangeTypes[] = {FactChangeType::PUNCTUAL, FactChangeType::ADDED, FactChangeType::REMOVED};
+    while (!pWhatChanged.factsToPropagate.empty())
     {
-      needAnotherLoop = false;
+      factsOfTheRound.clear();
+      std::swap(factsOfTheRound, pWhatChanged.factsToPropagate);
+
       for (auto& currSetOfEvents : pSetOfEvents)
       {
-        auto& events = currSetOfEvents.second.events();
         const FactOptionalsToId& condToEvents = currSetOfEvents.second.reachableEventLinks();
         auto& eventsAlreadyApplied = soeToEventsAlreadyApplied[currSetOfEvents.first];
 
-        for (auto& currAddedFact : pWhatChanged.punctualFacts)
+        for (const auto& currFactChangeType : factChangeTypes)
         {
-          condToEvents.findFact([&](const EventId& pEventId) {
-            if (_tryToApplyEvent(eventsAlreadyApplied, pWhatChanged, pGoalChanged, pGoalStack, pEventId, events,
-                                 pSetOfEvents, pCallbacks, pOntology, pObjects, pNow))
-              needAnotherLoop = true;
-            return ContinueOrBreak::CONTINUE;
-          }, currAddedFact, false, false, false);
-        }
-        for (auto& currAddedFact : pWhatChanged.addedFacts)
-        {
-          condToEvents.findFact([&](const EventId& pEventId) {
-            if (_tryToApplyEvent(eventsAlreadyApplied, pWhatChanged, pGoalChanged, pGoalStack, pEventId, events,
-                                 pSetOfEvents, pCallbacks, pOntology, pObjects, pNow))
-              needAnotherLoop = true;
-            return ContinueOrBreak::CONTINUE;
-          }, currAddedFact, false, false, false);
-
-        }
-        for (auto& currRemovedFact : pWhatChanged.removedFacts)
-        {
-          condToEvents.findFact([&](const EventId& pEventId) {
-            if (_tryToApplyEvent(eventsAlreadyApplied, pWhatChanged, pGoalChanged, pGoalStack, pEventId, events,
-                                 pSetOfEvents, pCallbacks, pOntology, pObjects, pNow))
-              needAnotherLoop = true;
-            return ContinueOrBreak::CONTINUE;
-          }, currRemovedFact, true, false, false);
+          for (const auto& currFact : factsOfTheRound)
+          {
+            if (currFact.second != currFactChangeType)
+              continue;
+            condToEvents.findFact([&](const EventId& pEventId) {
+              _tryToApplyEvent(eventsAlreadyApplied, pWhatChanged, pGoalChanged, pGoalStack, pEventId, currSetOfEvents.second,
+                               pSetOfEvents, pCallbacks, pOntology, pObjects, pNow);
+              return ContinueOrBreak::CONTINUE;
+            }, *currFact.first, currFactChangeType == FactChangeType::REMOVED, false, false);
+          }
         }
       }
 
       if (!pCallbacks.empty())
       {
-        auto& callbacks = pCallbacks.callbacks();
-        auto _tryToCallCallback = [&](const std::string& pCallbackId)
+        auto& factLinks = pCallbacks.conditionsToIds();
+        auto addCallbackToTry = [&](const std::string& pCallbackId)
         {
-          if (callbackAlreadyCalled.count(pCallbackId) == 0)
-          {
-            auto itCallback = callbacks.find(pCallbackId);
-            if (itCallback != callbacks.end())
-            {
-              const ConditionToCallback& currCallback = itCallback->second;
-
-              ParameterValuesWithConstraints parametersToValues;
-              for (const auto& currParam : currCallback.parameters)
-                parametersToValues[currParam];
-              if (currCallback.condition && currCallback.condition->isTrue(*this, pOntology.constants, pObjects,
-                                                                           pWhatChanged.punctualFacts,
-                                                                           pWhatChanged.addedFacts,
-                                                                           pWhatChanged.removedFacts,
-                                                                           &parametersToValues))
-              {
-                callbackAlreadyCalled.insert(pCallbackId);
-                currCallback.callback();
-              }
-            }
-          }
+          if (callbacksToTrySet.insert(pCallbackId).second)
+            callbacksToTry.push_back(pCallbackId);
           return ContinueOrBreak::CONTINUE;
         };
-
-        auto& factLinks = pCallbacks.conditionsToIds();
-        for (auto& currAddedFact : pWhatChanged.punctualFacts)
-          factLinks.findFact(_tryToCallCallback, currAddedFact);
-        for (auto& currAddedFact : pWhatChanged.addedFacts)
-          factLinks.findFact(_tryToCallCallback, currAddedFact);
-        for (auto& currRemovedFact : pWhatChanged.removedFacts)
-          factLinks.findFact(_tryToCallCallback, currRemovedFact, true);
+        for (const auto& currFactChangeType : factChangeTypes)
+          for (const auto& currFact : factsOfTheRound)
+            if (currFact.second == currFactChangeType)
+              factLinks.findFact(addCallbackToTry, *currFact.first, currFactChangeType == FactChangeType::REMOVED);
+
+        // The conditions of the callbacks not called yet are checked again because the context is bigger
+        for (const auto& currCallbackId : callbacksToTry)
+          _tryToCallCallback(callbackAlreadyCalled, pWhatChanged, pOntology.constants, pObjects,
+                             currCallbackId, pCallbacks);
       }
     }
 
@@ -816,9 +1210,11 @@ void WorldState::_notifyWhatChanged(WhatChanged& pWhatChanged,
       onFactsAdded(pWhatChanged.addedFacts);
     if (!pWhatChanged.removedFacts.empty())
       onFactsRemoved(pWhatChanged.removedFacts);
-    if (pWhatChanged.hasFactsToModifyInTheWorldForSure())
+    if (pWhatChanged.hasFactsToModifyInTheWorldForSure() && !onFactsChanged.empty())
       onFactsChanged(_factsMapping.facts());
   }
+
+  _notifyFactChanges();
 }
 
 
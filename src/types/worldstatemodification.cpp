@@ -93,4 +93,13 @@ std::unique_ptr<WorldStateModification> WorldStateModification::createByConcaten
 }
 
 
+std::optional<Number> WorldStateModification::getNumber(const SetOfFacts& pSetOfFact) const
+{
+  auto value = getValue(pSetOfFact);
+  if (value)
+    return entityToNumberOpt(*value);
+  return {};
+}
+
+
 } // !ogp
@@ -21,6 +21,34 @@ bool _areEqual(
 }
 
 
+/// Compute natively an arithmetic node if both operands are numbers.
+std::optional<Number> _getNumberOfOperation(const WorldStateModificationNode& pNode,
+                                            const SetOfFacts& pSetOfFact)
+{
+  if (!pNode.leftOperand || !pNode.rightOperand)
+    return {};
+  auto leftNbOpt = pNode.leftOperand->getNumber(pSetOfFact);
+  if (!leftNbOpt)
+    return {};
+  auto rightNbOpt = pNode.rightOperand->getNumber(pSetOfFact);
+  if (!rightNbOpt)
+    return {};
+  switch (pNode.nodeType)
+  {
+  case WorldStateModificationNodeType::PLUS:
+  case WorldStateModificationNodeType::INCREASE:
+    return *leftNbOpt + *rightNbOpt;
+  case WorldStateModificationNodeType::MINUS:
+  case WorldStateModificationNodeType::DECREASE:
+    return *leftNbOpt - *rightNbOpt;
+  case WorldStateModificationNodeType::MULTIPLY:
+    return *leftNbOpt * *rightNbOpt;
+  default:
+    return {};
+  }
+}
+
+
 bool _isOkWithLocalParameters(const ParameterValuesWithConstraints& pLocalParameterToFind,
                               ParameterValuesWithConstraints& pParametersToFill,
                               const WorldStateModification& pWModif,
@@ -162,7 +190,7 @@ void WorldStateModificationNode::forAll(const std::function<void (const FactOpti
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setValue(plusIntOrStr(leftOperand->getValue(pSetOfFact), rightOperand->getValue(pSetOfFact)));
+      factToCheck.fact.setValue(_computeArithmeticValue(pSetOfFact));
       pFactCallback(factToCheck);
     }
   }
@@ -172,7 +200,7 @@ void WorldStateModificationNode::forAll(const std::function<void (const FactOpti
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setValue(minusIntOrStr(leftOperand->getValue(pSetOfFact), rightOperand->getValue(pSetOfFact)));
+      factToCheck.fact.setValue(_computeArithmeticValue(pSetOfFact));
       pFactCallback(factToCheck);
     }
   }
@@ -182,7 +210,7 @@ void WorldStateModificationNode::forAll(const std::function<void (const FactOpti
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setValue(multiplyNbOrStr(leftOperand->getValue(pSetOfFact), rightOperand->getValue(pSetOfFact)));
+      factToCheck.fact.setValue(_computeArithmeticValue(pSetOfFact));
       pFactCallback(factToCheck);
     }
   }
@@ -273,8 +301,8 @@ bool WorldStateModificationNode::canSatisfyObjective(const std::function<bool (c
 
       if (!factToCheck.fact.value())
       {
-        factToCheck.fact.setValue(Entity("??tmpValueFromSet_" + pFromDeductionId, factToCheck.fact.predicate.value));
-        localParameterToFind[Parameter(factToCheck.fact.value()->value, factToCheck.fact.predicate.value)];
+        factToCheck.fact.setValue(Entity("??tmpValueFromSet_" + pFromDeductionId, factToCheck.fact.predicate().value));
+        localParameterToFind[Parameter(factToCheck.fact.value()->value, factToCheck.fact.predicate().value)];
       }
       bool res = pFactCallback(factToCheck, &localParameterToFind, [&](const ParameterValuesWithConstraints& pLocalParameterToFind){
         return _isOkWithLocalParameters(pLocalParameterToFind, localParameterToFind, *rightOperand, pWorldState, pParameters);
@@ -301,7 +329,7 @@ bool WorldStateModificationNode::canSatisfyObjective(const std::function<bool (c
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setValue(plusIntOrStr(leftOperand->getValue(setOfFacts), rightOperand->getValue(setOfFacts)));
+      factToCheck.fact.setValue(_computeArithmeticValue(setOfFacts));
       return pFactCallback(factToCheck, nullptr, [](const ParameterValuesWithConstraints&){ return true; });
     }
   }
@@ -312,7 +340,7 @@ bool WorldStateModificationNode::canSatisfyObjective(const std::function<bool (c
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setValue(minusIntOrStr(leftOperand->getValue(setOfFacts), rightOperand->getValue(setOfFacts)));
+      factToCheck.fact.setValue(_computeArithmeticValue(setOfFacts));
       return pFactCallback(factToCheck, nullptr, [](const ParameterValuesWithConstraints&){ return true; });
     }
   }
@@ -323,7 +351,7 @@ bool WorldStateModificationNode::canSatisfyObjective(const std::function<bool (c
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setValue(multiplyNbOrStr(leftOperand->getValue(setOfFacts), rightOperand->getValue(setOfFacts)));
+      factToCheck.fact.setValue(_computeArithmeticValue(setOfFacts));
       return pFactCallback(factToCheck, nullptr, [](const ParameterValuesWithConstraints&){ return true; });
     }
   }
@@ -360,8 +388,8 @@ bool WorldStateModificationNode::iterateOnSuccessions(const std::function<bool (
 
       if (!factToCheck.fact.value())
       {
-        factToCheck.fact.setValue(Entity("??tmpValueFromSet_" + pFromDeductionId, factToCheck.fact.predicate.value));
-        localParameterToFind[Parameter(factToCheck.fact.value()->value, factToCheck.fact.predicate.value)];
+        factToCheck.fact.setValue(Entity("??tmpValueFromSet_" + pFromDeductionId, factToCheck.fact.predicate().value));
+        localParameterToFind[Parameter(factToCheck.fact.value()->value, factToCheck.fact.predicate().value)];
       }
       bool res = pCallback(_successions, factToCheck, &localParameterToFind, [&](const ParameterValuesWithConstraints& pLocalParameterToFind){
         return _isOkWithLocalParameters(pLocalParameterToFind, localParameterToFind, *rightOperand, pWorldState, pParameters);
@@ -388,7 +416,7 @@ bool WorldStateModificationNode::iterateOnSuccessions(const std::function<bool (
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setValue(plusIntOrStr(leftOperand->getValue(setOfFacts), rightOperand->getValue(setOfFacts)));
+      factToCheck.fact.setValue(_computeArithmeticValue(setOfFacts));
       return pCallback(_successions, factToCheck, nullptr, [](const ParameterValuesWithConstraints&){ return true; });
     }
   }
@@ -399,7 +427,7 @@ bool WorldStateModificationNode::iterateOnSuccessions(const std::function<bool (
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setValue(minusIntOrStr(leftOperand->getValue(setOfFacts), rightOperand->getValue(setOfFacts)));
+      factToCheck.fact.setValue(_computeArithmeticValue(setOfFacts));
       return pCallback(_successions, factToCheck, nullptr, [](const ParameterValuesWithConstraints&){ return true; });
     }
   }
@@ -410,7 +438,7 @@ bool WorldStateModificationNode::iterateOnSuccessions(const std::function<bool (
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setValue(multiplyNbOrStr(leftOperand->getValue(setOfFacts), rightOperand->getValue(setOfFacts)));
+      factToCheck.fact.setValue(_computeArithmeticValue(setOfFacts));
       return pCallback(_successions, factToCheck, nullptr, [](const ParameterValuesWithConstraints&){ return true; });
     }
   }
@@ -553,6 +581,14 @@ bool WorldStateModificationNode::operator==(const WorldStateModification& pOther
 
 std::optional<Entity> WorldStateModificationNode::getValue(const SetOfFacts& pSetOfFact) const
 {
+  if (nodeType == WorldStateModificationNodeType::PLUS ||
+      nodeType == WorldStateModificationNodeType::MINUS)
+  {
+    auto nbOpt = _getNumberOfOperation(*this, pSetOfFact);
+    if (nbOpt)
+      return Entity::createNumberEntity(numberToString(*nbOpt));
+  }
+
   if (nodeType == WorldStateModificationNodeType::PLUS)
   {
     auto leftValue = leftOperand->getValue(pSetOfFact);
@@ -569,6 +605,36 @@ std::optional<Entity> WorldStateModificationNode::getValue(const SetOfFacts& pSe
 }
 
 
+std::optional<Number> WorldStateModificationNode::getNumber(const SetOfFacts& pSetOfFact) const
+{
+  if (nodeType == WorldStateModificationNodeType::PLUS ||
+      nodeType == WorldStateModificationNodeType::MINUS)
+  {
+    auto nbOpt = _getNumberOfOperation(*this, pSetOfFact);
+    if (nbOpt)
+      return nbOpt;
+  }
+  return WorldStateModification::getNumber(pSetOfFact);
+}
+
+
+std::optional<Entity> WorldStateModificationNode::_computeArithmeticValue(const SetOfFacts& pSetOfFact) const
+{
+  auto nbOpt = _getNumberOfOperation(*this, pSetOfFact);
+  if (nbOpt)
+    return Entity::createNumberEntity(numberToString(*nbOpt));
+
+  // Not numbers, so the operation is done on the strings
+  auto leftValue = leftOperand->getValue(pSetOfFact);
+  auto rightValue = rightOperand->getValue(pSetOfFact);
+  if (nodeType == WorldStateModificationNodeType::INCREASE)
+    return plusIntOrStr(leftValue, rightValue);
+  if (nodeType == WorldStateModificationNodeType::DECREASE)
+    return minusIntOrStr(leftValue, rightValue);
+  return multiplyNbOrStr(leftValue, rightValue);
+}
+
+
 void WorldStateModificationNode::_forAllInstruction(const std::function<void (const WorldStateModification &)>& pCallback,
                                                     const SetOfFacts& pSetOfFact,
                                                     ParameterValuesWithConstraints& pParameters,
@@ -665,6 +731,11 @@ std::optional<Entity> WorldStateModificationFact::getValue(const SetOfFacts& pSe
   return pSetOfFact.getFluentValue(factOptional.fact);
 }
 
+std::optional<Number> WorldStateModificationFact::getNumber(const SetOfFacts& pSetOfFact) const
+{
+  return pSetOfFact.getFluentNumber(factOptional.fact);
+}
+
 bool WorldStateModificationFact::hasAContradictionWith(const std::set<FactOptional>& pFactsOpt,
                                                        std::list<Parameter>* pParametersPtr) const
 {
@@ -109,6 +109,7 @@ struct WorldStateModificationNode : public WorldStateModification
   bool operator==(const WorldStateModification& pOther) const override;
 
   std::optional<Entity> getValue(const SetOfFacts& pSetOfFact) const override;
+  std::optional<Number> getNumber(const SetOfFacts& pSetOfFact) const override;
 
   const FactOptional* getOptionalFact() const override
   {
@@ -141,6 +142,9 @@ struct WorldStateModificationNode : public WorldStateModification
 private:
   Successions _successions;
 
+  /// Compute the new value of the fact modified by an INCREASE, a DECREASE or a MULTIPLY node.
+  std::optional<Entity> _computeArithmeticValue(const SetOfFacts& pSetOfFact) const;
+
   void _forAllInstruction(const std::function<void (const WorldStateModification&)>& pCallback,
                           const SetOfFacts& pSetOfFact,
                           ParameterValuesWithConstraints& pParameters,
@@ -231,6 +235,7 @@ struct WorldStateModificationFact : public WorldStateModification
   bool operator==(const WorldStateModification& pOther) const override;
 
   std::optional<Entity> getValue(const SetOfFacts& pSetOfFact) const override;
+  std::optional<Number> getNumber(const SetOfFacts& pSetOfFact) const override;
 
   const FactOptional* getOptionalFact() const override
   {
@@ -306,6 +311,11 @@ struct WorldStateModificationNumber : public WorldStateModification
     return Entity::createNumberEntity(toStr(true));
   }
 
+  std::optional<Number> getNumber(const SetOfFacts&) const override
+  {
+    return _nb;
+  }
+
   const FactOptional* getOptionalFact() const override
   {
     return nullptr;
@@ -10,26 +10,38 @@ std::map<std::string, MinMaxValues> extractMinMaxValuesForFacts(const Problem& p
                                                                 const Domain& pDomain)
 {
   std::map<std::string, MinMaxValues> res;
-  for (const auto& currPrioToGoals : pProblem.goalStack.goals())
+  extractMinMaxValuesForFactsOfGoals(res, pProblem.goalStack);
+  extractMinMaxValuesForFactsOfDomain(res, pDomain);
+  return res;
+}
+
+
+void extractMinMaxValuesForFactsOfGoals(std::map<std::string, MinMaxValues>& pRes,
+                                        const GoalStack& pGoalStack)
+{
+  for (const auto& currPrioToGoals : pGoalStack.goals())
     for (const auto& currGoal : currPrioToGoals.second)
-      currGoal.objective().extractMinMaxValuesForFacts(res);
+      currGoal.objective().extractMinMaxValuesForFacts(pRes);
+}
+
 
+void extractMinMaxValuesForFactsOfDomain(std::map<std::string, MinMaxValues>& pRes,
+                                         const Domain& pDomain)
+{
   const auto& ontology = pDomain.getOntology();
   for (const auto& currDpPair : ontology.derivedPredicates.nameToDerivedPredicate())
   {
     const DerivedPredicate& currDp = currDpPair.second;
     if (currDp.condition)
-      currDp.condition->extractMinMaxValuesForFacts(res);
+      currDp.condition->extractMinMaxValuesForFacts(pRes);
   }
 
   for (const auto& currActionPair : pDomain.actions())
   {
     const Action& currAction = currActionPair.second;
     if (currAction.precondition)
-      currAction.precondition->extractMinMaxValuesForFacts(res);
+      currAction.precondition->extractMinMaxValuesForFacts(pRes);
   }
-
-  return res;
 }
 
 
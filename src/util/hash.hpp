@@ -0,0 +1,45 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_UTIL_HASH_HPP
+#define ORDEREDGOALSPLANNER_SRC_UTIL_HASH_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace ogp
+{
+
+/// Spread the bits of a value over 64 bits (finalizer of splitmix64).
+inline std::uint64_t mixHash(std::uint64_t pValue)
+{
+  pValue += 0x9e3779b97f4a7c15ULL;
+  pValue = (pValue ^ (pValue >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  pValue = (pValue ^ (pValue >> 27)) * 0x94d049bb133111ebULL;
+  return pValue ^ (pValue >> 31);
+}
+
+/**
+ * @brief Hash a string with FNV-1a 64 bits then spread the bits.<br/>
+ * Contrary to std::hash, the result only depends on the characters of the string,
+ * so it is the same for all the processes, the platforms and the standard libraries.
+ */
+inline std::uint64_t hashStr(const std::string& pStr)
+{
+  std::uint64_t res = 0xcbf29ce484222325ULL;
+  for (const char currChar : pStr)
+  {
+    res ^= static_cast<unsigned char>(currChar);
+    res *= 0x100000001b3ULL;
+  }
+  return mixHash(res);
+}
+
+/// Combine a value in a hash where the order of the values matters.
+inline void combineHash(std::uint64_t& pHash,
+                        std::uint64_t pValue)
+{
+  pHash = mixHash(pHash ^ pValue);
+}
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_UTIL_HASH_HPP
@@ -141,7 +141,7 @@ std::unique_ptr<Condition> _expressionParsedToCondition(const ExpressionParsed&
                rightOperandExp.name != "")
       {
         auto value = Entity::fromUsage(rightOperandExp.name, pOntology, pObjects, pParameters, pParameterNamesToEntityPtr);
-        const auto& leftFactPredicate = leftFactPtr->factOptional.fact.predicate;
+        const auto& leftFactPredicate = leftFactPtr->factOptional.fact.predicate();
         if (!leftFactPredicate.value)
           throw std::runtime_error("Value \"" + value.toStr() + "\" in condition was not exprected for predicate: \"" + leftFactPredicate.toPddl() + "\"");
         const auto& predicateValueExpectedType = *leftFactPredicate.value;
@@ -355,7 +355,7 @@ std::unique_ptr<WorldStateModification> _expressionParsedToWsModification(const
                rightOperandExp.name != "")
       {
         auto value = Entity::fromUsage(rightOperandExp.name, pOntology, pObjects, pParameters);
-        const auto& leftFactPredicate = leftFactPtr->factOptional.fact.predicate;
+        const auto& leftFactPredicate = leftFactPtr->factOptional.fact.predicate();
         if (!leftFactPredicate.value)
           throw std::runtime_error("Value \"" + value.toStr() + "\" in effect was not exprected for predicate: \"" + leftFactPredicate.toPddl() + "\"");
         const auto& predicateValueExpectedType = *leftFactPredicate.value;
@@ -183,17 +183,34 @@ bool compIntNb(
 {
   try
   {
-    auto nb1 = stringToNumber(pNb1Str);
-    if (nb1 == pNb2)
-      return pCanBeEqual;
-    if (pBoolSuperiorOrInferior)
-      return nb1 > pNb2;
-    else
-      return nb1 < pNb2;
+    return compNb(stringToNumber(pNb1Str), pNb2, pBoolSuperiorOrInferior, pCanBeEqual);
   } catch (...) {}
   return false;
 }
 
+
+bool compNb(const Number& pNb1,
+            const Number& pNb2,
+            bool pBoolSuperiorOrInferior,
+            bool pCanBeEqual)
+{
+  if (pNb1 == pNb2)
+    return pCanBeEqual;
+  if (pBoolSuperiorOrInferior)
+    return pNb1 > pNb2;
+  return pNb1 < pNb2;
+}
+
+
+std::optional<Number> entityToNumberOpt(const Entity& pEntity)
+{
+  try
+  {
+    return pEntity.toNumber();
+  } catch (...) {}
+  return {};
+}
+
 std::string incrementLastNumberUntilAConditionIsSatisfied(
     const std::string& pStr,
     const std::function<bool(const std::string&)>& pCondition)
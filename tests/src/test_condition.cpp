@@ -351,6 +351,55 @@ void _test_exists_with_imply_and_then_true()
   EXPECT_FALSE(_isTrue("(exists (?e - entity) (imply (= (fact_1 ?e) r2) (not (goal))))", ontology, worldState, objects));
 }
 
+
+
+
+void _test_mandatory_facts()
+{
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b\n"
+                                                      "fact_c\n"
+                                                      "fact_d\n"
+                                                      "fact_e", ontology.types);
+  ogp::SetOfEntities objects;
+  std::size_t pos = 0;
+  auto conditionPtr = ogp::pddlToCondition("(and (fact_a) (imply (fact_b) (fact_c)) (or (fact_d) (fact_e)))",
+                                           pos, ontology, objects, {});
+
+  std::list<std::string> mandatoryFacts;
+  conditionPtr->forAll([&](const ogp::FactOptionalAndValueModification& pFactOptional, bool) {
+    mandatoryFacts.emplace_back(pFactOptional.factOpt.toStr());
+    return ogp::ContinueOrBreak::CONTINUE;
+  }, false, false, true);
+  EXPECT_EQ(std::list<std::string>{"fact_a"}, mandatoryFacts);
+
+  EXPECT_TRUE(conditionPtr->isOptFactMandatory(ogp::FactOptional(ogp::Fact::fromStr("fact_a", ontology, objects, {}))));
+  // The right operand of an implication is only needed if the left operand is true
+  EXPECT_FALSE(conditionPtr->isOptFactMandatory(ogp::FactOptional(ogp::Fact::fromStr("fact_c", ontology, objects, {}))));
+  EXPECT_FALSE(conditionPtr->isOptFactMandatory(ogp::FactOptional(ogp::Fact::fromStr("fact_b", ontology, objects, {}), true)));
+  EXPECT_FALSE(conditionPtr->isOptFactMandatory(ogp::FactOptional(ogp::Fact::fromStr("fact_d", ontology, objects, {}))));
+}
+
+
+void _test_get_all_opt_facts()
+{
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b\n"
+                                                      "fact_c", ontology.types);
+  ogp::SetOfEntities objects;
+  std::size_t pos = 0;
+  auto conditionPtr = ogp::pddlToCondition("(and (fact_a) (not (fact_b)) (imply (fact_c) (fact_a)))",
+                                           pos, ontology, objects, {});
+
+  // The negated facts are built during the iteration, so the result has to hold copies of them
+  std::set<std::string> optFacts;
+  for (const auto& currOptFact : conditionPtr->getAllOptFacts())
+    optFacts.insert(currOptFact.factOpt.toStr());
+  EXPECT_EQ(std::set<std::string>({"!fact_b", "!fact_c", "fact_a"}), optFacts);
+}
+
 }
 
 
@@ -366,5 +415,6 @@ TEST(Tool, test_condition)
   _test_exists_with_and_list();
   _test_forall_with_imply_and_then_true();
   _test_exists_with_imply_and_then_true();
-
+  _test_mandatory_facts();
+  _test_get_all_opt_facts();
 }
@@ -79,6 +79,52 @@ void _test_dataDirectory(const std::string& pDataPath,
 }
 
 
+/// Load the domain and the problem of a directory, the domain is stored in pLoadedDomains.
+ogp::DomainAndProblemPtrs _loadDomainAndProblem(std::map<std::string, ogp::Domain>& pLoadedDomains,
+                                                const std::string& pDataPath,
+                                                const std::string& pProblemDirectory)
+{
+  auto directory = pDataPath + "/" + pProblemDirectory;
+
+  auto domainContent = _getFileContent(directory + "/domain.pddl");
+  auto domain = ogp::pddlToDomain(domainContent, false, pLoadedDomains);
+  pLoadedDomains.emplace(domain.getName(), std::move(domain));
+
+  auto problemContent = _getFileContent(directory + "/problem.pddl");
+  return ogp::pddlToProblemFromDomains(problemContent, pLoadedDomains);
+}
+
+
+std::string _planWithSession(const std::string& pDataPath,
+                             const std::string& pProblemDirectory,
+                             std::size_t pNbOfThreads)
+{
+  std::map<std::string, ogp::Domain> loadedDomains;
+  auto domainAndProblemPtrs = _loadDomainAndProblem(loadedDomains, pDataPath, pProblemDirectory);
+  auto& problem = *domainAndProblemPtrs.problemPtr;
+  auto& loadedDomain = *domainAndProblemPtrs.domainPtr;
+  ogp::PlannerSession session(loadedDomain, problem);
+  session.setNbOfThreadsToEvaluateCandidateActions(pNbOfThreads);
+  auto plan = session.planForEveryGoals(_emptyCallbacks, {});
+  EXPECT_TRUE(problem.goalStack.goals().empty());
+  return ogp::planToPddl(plan, loadedDomain);
+}
+
+
+std::string _planWithSearchStrategy(const std::string& pDataPath,
+                                    const std::string& pProblemDirectory,
+                                    const ogp::SearchStrategy& pSearchStrategy)
+{
+  std::map<std::string, ogp::Domain> loadedDomains;
+  auto domainAndProblemPtrs = _loadDomainAndProblem(loadedDomains, pDataPath, pProblemDirectory);
+  auto& problem = *domainAndProblemPtrs.problemPtr;
+  auto& loadedDomain = *domainAndProblemPtrs.domainPtr;
+  auto plan = ogp::planForEveryGoals(problem, loadedDomain, _emptyCallbacks, pSearchStrategy, {});
+  EXPECT_TRUE(problem.goalStack.goals().empty());
+  return ogp::planToPddl(plan, loadedDomain);
+}
+
+
 }
 
 
@@ -107,3 +153,38 @@ TEST_F(PlannerUsingExternalData, test_problemsInData_millionaire)
 {
   _test_dataDirectory(PlannerUsingExternalData::dataPath, "millionaire");
 }
+
+
+TEST_F(PlannerUsingExternalData, test_problemsInData_withForwardSearch)
+{
+  const auto& dataPath = PlannerUsingExternalData::dataPath;
+  auto expected = _getFileContentWithoutComments(dataPath + "/simple/problem.plan");
+
+  ogp::SearchStrategy searchStrategy;
+  searchStrategy.algorithm = ogp::SearchAlgorithm::WEIGHTED_A_STAR;
+  searchStrategy.heuristic = ogp::RelaxedHeuristic::H_ADD;
+  EXPECT_EQ(expected, _planWithSearchStrategy(dataPath, "simple", searchStrategy));
+  searchStrategy.heuristic = ogp::RelaxedHeuristic::H_FF;
+  EXPECT_EQ(expected, _planWithSearchStrategy(dataPath, "simple", searchStrategy));
+  searchStrategy.algorithm = ogp::SearchAlgorithm::GREEDY_BEST_FIRST;
+  EXPECT_EQ(expected, _planWithSearchStrategy(dataPath, "simple", searchStrategy));
+
+  EXPECT_EQ(_getFileContentWithoutComments(dataPath + "/ordered_goals/problem.plan"),
+            _planWithSearchStrategy(dataPath, "ordered_goals", searchStrategy));
+
+  // The domain has fluents and conditional effects, so the goals are planned with the backward chaining
+  EXPECT_EQ(_getFileContentWithoutComments(dataPath + "/move_and_tell/problem.plan"),
+            _planWithSearchStrategy(dataPath, "move_and_tell", searchStrategy));
+}
+
+
+TEST_F(PlannerUsingExternalData, test_problemsInData_withCandidateActionsEvaluatedInParallel)
+{
+  const auto& dataPath = PlannerUsingExternalData::dataPath;
+  for (const auto& currDirectory : {"simple", "ordered_goals", "move_and_tell", "minimize_durations", "millionaire"})
+  {
+    auto expected = _getFileContentWithoutComments(dataPath + "/" + currDirectory + "/problem.plan");
+    EXPECT_EQ(expected, _planWithSession(dataPath, currDirectory, 1));
+    EXPECT_EQ(expected, _planWithSession(dataPath, currDirectory, 4));
+  }
+}
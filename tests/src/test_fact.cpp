@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <thread>
 #include <orderedgoalsplanner/types/fact.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
 
@@ -67,6 +68,36 @@ void _test_generateSignatureForUpperTypes()
             _printSignatures(ogp::Fact::fromStr("fun3(e1, e1)", ontology, objects, {}), false, true));
 }
 
+
+
+void _test_predicateIsSharedWithTheOntology()
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("my_type sub_my_type - entity");
+  ontology.constants = ogp::SetOfEntities::fromPddl("toto toto2 - my_type", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("pred_name(?e - entity)", ontology.types);
+
+  auto fact1 = ogp::Fact::fromStr("pred_name(toto)", ontology, {}, {});
+  auto fact2 = ogp::Fact::fromStr("pred_name(toto2)", ontology, {}, {});
+  EXPECT_EQ(ontology.nameToPredicatePtr("pred_name"), &fact1.predicate());
+  EXPECT_EQ(&fact1.predicate(), &fact2.predicate());
+  EXPECT_EQ(&fact1.factSignature(), &fact2.factSignature());
+
+  // The signature is shared with the facts created by the other threads
+  const std::string* signatureInOtherThreadPtr = nullptr;
+  std::thread otherThread([&]() {
+    signatureInOtherThreadPtr = &ogp::Fact::fromStr("pred_name(toto2)", ontology, {}, {}).factSignature();
+  });
+  otherThread.join();
+  EXPECT_EQ(&fact1.factSignature(), signatureInOtherThreadPtr);
+
+  // The types of a parameter narrow the predicate of this fact only
+  std::vector<ogp::Parameter> parameters(1, ogp::Parameter::fromStr("?p - sub_my_type", ontology.types));
+  auto factWithParameter = ogp::Fact::fromStr("pred_name(?p)", ontology, {}, parameters);
+  EXPECT_EQ("pred_name(?e - sub_my_type)", factWithParameter.predicate().toStr());
+  EXPECT_EQ("pred_name(?e - entity)", fact1.predicate().toStr());
+}
+
 }
 
 
@@ -74,4 +105,5 @@ void _test_generateSignatureForUpperTypes()
 TEST(Tool, test_fact)
 {
   _test_generateSignatureForUpperTypes();
+  _test_predicateIsSharedWithTheOntology();
 }
@@ -910,6 +910,569 @@ void _removeNotMandatoryActions()
   EXPECT_EQ(action2, ogp::planToStr(plan));
 }
 
+void _removeNotMandatoryActionsWithRemovedFacts()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+  const std::string action3 = "action3";
+
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b\n"
+                                                      "fact_c", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, _worldStateModification_fromPddl("(fact_a)", ontology)));
+  actions.emplace(action2, ogp::Action(_condition_fromPddl("(not (fact_c))", ontology),
+                                       _worldStateModification_fromPddl("(and (fact_b) (not (fact_a)))", ontology)));
+  actions.emplace(action3, ogp::Action({}, _worldStateModification_fromPddl("(fact_c)", ontology)));
+  ogp::Domain domain(std::move(actions), ontology);
+
+  ogp::Problem problem;
+  auto& entities = problem.objects;
+  const auto goal = ogp::Goal::fromStr("fact_b", ontology, entities);
+  const std::map<ogp::Parameter, ogp::Entity> noParameters;
+
+  std::list<ogp::ActionInvocationWithGoal> plan;
+  plan.emplace_back(action3, noParameters, std::unique_ptr<ogp::Goal>(), 0);
+  plan.emplace_back(action1, noParameters, std::unique_ptr<ogp::Goal>(), 0);
+  plan.emplace_back(action2, noParameters, std::unique_ptr<ogp::Goal>(), 0);
+
+  // action1 is kept because action2 is not applicable after action3, then action3 is removed
+  ogp::removeNotMandatoryActions(plan, domain, problem, goal);
+  EXPECT_EQ("action1, action2", ogp::planToStr(plan, ", "));
+}
+
+
+void _replanForEveryGoals()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+  const std::string action3 = "action3";
+
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b\n"
+                                                      "fact_c", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, _worldStateModification_fromPddl("(fact_a)", ontology)));
+  actions.emplace(action2, ogp::Action(_condition_fromPddl("(fact_a)", ontology),
+                                       _worldStateModification_fromPddl("(fact_b)", ontology)));
+  actions.emplace(action3, ogp::Action(_condition_fromPddl("(fact_b)", ontology),
+                                       _worldStateModification_fromPddl("(fact_c)", ontology)));
+  ogp::Domain domain(std::move(actions), ontology);
+
+  ogp::Problem problem;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_c", ontology, problem.objects)}, ontology.constants);
+  auto problemForPlanning = problem;
+  auto plan = ogp::planForEveryGoals(problemForPlanning, domain, _emptyCallbacks, {});
+  EXPECT_EQ(action1 + ", " + action2 + ", " + action3, ogp::planToStr(plan));
+
+  ogp::notifyActionDone(problem, domain, _emptyCallbacks, plan.front(), {});
+  plan.pop_front();
+  std::size_t nbOfReusedActions = 0;
+  problemForPlanning = problem;
+  auto newPlan = ogp::replanForEveryGoals(problemForPlanning, domain, _emptyCallbacks, plan, {}, nullptr, nullptr,
+                                          &nbOfReusedActions);
+  EXPECT_EQ(action2 + ", " + action3, ogp::planToStr(newPlan));
+  EXPECT_EQ(2u, nbOfReusedActions);
+  EXPECT_TRUE(problemForPlanning.goalStack.goals().empty());
+
+  // The precondition of the next action is not satisfied anymore, so the search starts from the first action
+  const std::map<ogp::SetOfEventsId, ogp::SetOfEvents> setOfEventsMap;
+  problem.worldState.removeFact(ogp::Fact("fact_a", false, ontology, problem.objects, {}), problem.goalStack, setOfEventsMap,
+                                _emptyCallbacks, ontology, problem.objects, {});
+  problemForPlanning = problem;
+  newPlan = ogp::replanForEveryGoals(problemForPlanning, domain, _emptyCallbacks, plan, {}, nullptr, nullptr,
+                                     &nbOfReusedActions);
+  EXPECT_EQ(action1 + ", " + action2 + ", " + action3, ogp::planToStr(newPlan));
+  EXPECT_EQ(0u, nbOfReusedActions);
+
+  // The goal is already satisfied, so the previous plan is useless
+  problem.worldState.addFact(ogp::Fact("fact_c", false, ontology, problem.objects, {}), problem.goalStack, setOfEventsMap,
+                             _emptyCallbacks, ontology, problem.objects, {});
+  problemForPlanning = problem;
+  newPlan = ogp::replanForEveryGoals(problemForPlanning, domain, _emptyCallbacks, plan, {}, nullptr, nullptr,
+                                     &nbOfReusedActions);
+  EXPECT_EQ("", ogp::planToStr(newPlan));
+  EXPECT_EQ(0u, nbOfReusedActions);
+}
+
+
+void _plannerSession()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b\n"
+                                                      "fact_c", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, _worldStateModification_fromPddl("(fact_b)", ontology)));
+  actions.emplace(action2, ogp::Action(_condition_fromPddl("(fact_a)", ontology),
+                                       _worldStateModification_fromPddl("(fact_c)", ontology)));
+  ogp::Domain domain(std::move(actions), ontology);
+
+  ogp::Problem problem;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_b", ontology, problem.objects)}, ontology.constants);
+  auto problemForFreeFunction = problem;
+  ogp::PlannerSession session(domain, problem);
+  EXPECT_EQ(ogp::planToStr(ogp::planForEveryGoals(problemForFreeFunction, domain, _emptyCallbacks, {})),
+            ogp::planToStr(session.planForEveryGoals(_emptyCallbacks, {})));
+
+  // The failure of the persistent goal is memorized for this world state
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("persist(fact_c)", ontology, problem.objects)}, ontology.constants);
+  EXPECT_EQ("", ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+  EXPECT_EQ("", ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+
+  // A modification of the world state invalidates the memorized failure
+  const std::map<ogp::SetOfEventsId, ogp::SetOfEvents> setOfEventsMap;
+  problem.worldState.addFact(ogp::Fact("fact_a", false, ontology, problem.objects, {}), problem.goalStack, setOfEventsMap,
+                             _emptyCallbacks, ontology, problem.objects, {});
+  EXPECT_EQ(action2, ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+}
+
+
+void _transpositionTable()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, _worldStateModification_fromPddl("(fact_a)", ontology)));
+  actions.emplace(action2, ogp::Action({}, _worldStateModification_fromPddl("(fact_b)", ontology)));
+  ogp::Domain domain(std::move(actions), ontology);
+
+  ogp::Problem problem;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_a & fact_b", ontology, problem.objects)}, ontology.constants);
+  ogp::PlannerSession session(domain, problem);
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+  auto statistics = session.transpositionTableStatistics();
+  EXPECT_EQ(0u, statistics.nbOfHits);
+  EXPECT_LT(0u, statistics.nbOfMisses);
+  EXPECT_EQ(statistics.nbOfMisses, statistics.nbOfEntries);
+
+  // The same search reuses the costs of the rollouts
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+  auto newStatistics = session.transpositionTableStatistics();
+  EXPECT_EQ(statistics.nbOfMisses, newStatistics.nbOfMisses);
+  EXPECT_EQ(statistics.nbOfMisses, newStatistics.nbOfHits);
+
+  session.clearCaches();
+  EXPECT_EQ(0u, session.transpositionTableStatistics().nbOfEntries);
+}
+
+
+void _planCache()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("entity");
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, _worldStateModification_fromPddl("(fact_a)", ontology)));
+  actions.emplace(action2, ogp::Action({}, _worldStateModification_fromPddl("(fact_b)", ontology)));
+  ogp::Domain domain(std::move(actions), ontology);
+
+  ogp::Problem problem;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_a & fact_b", ontology, problem.objects)}, ontology.constants);
+  ogp::PlannerSession session(domain, problem);
+  // The cache is disabled by default
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+  EXPECT_EQ(0u, session.planCacheStatistics().nbOfMisses);
+
+  session.setPlanCacheCapacity(2);
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+  auto statistics = session.planCacheStatistics();
+  EXPECT_EQ(0u, statistics.nbOfHits);
+  EXPECT_EQ(1u, statistics.nbOfMisses);
+  EXPECT_EQ(1u, statistics.nbOfEntries);
+  EXPECT_EQ(2u, statistics.maxNbOfEntries);
+
+  // The same call returns the memorized plan without searching
+  auto transpositionTableStatistics = session.transpositionTableStatistics();
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+  EXPECT_EQ(1u, session.planCacheStatistics().nbOfHits);
+  EXPECT_EQ(transpositionTableStatistics.nbOfHits, session.transpositionTableStatistics().nbOfHits);
+
+  // A call that does not compare the candidate actions is another entry
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, false, {})));
+  EXPECT_EQ(2u, session.planCacheStatistics().nbOfMisses);
+
+  // A modification of the world state is another entry, and the least recently used entry is evicted
+  const std::map<ogp::SetOfEventsId, ogp::SetOfEvents> setOfEventsMap;
+  ogp::Fact factA("fact_a", false, ontology, problem.objects, {});
+  problem.worldState.addFact(factA, problem.goalStack, setOfEventsMap, _emptyCallbacks, ontology, problem.objects, {});
+  EXPECT_EQ(action2, ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+  statistics = session.planCacheStatistics();
+  EXPECT_EQ(3u, statistics.nbOfMisses);
+  EXPECT_EQ(2u, statistics.nbOfEntries);
+
+  // Back to the previous world state
+  problem.worldState.removeFact(factA, problem.goalStack, setOfEventsMap, _emptyCallbacks, ontology, problem.objects, {});
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, false, {})));
+  EXPECT_EQ(2u, session.planCacheStatistics().nbOfHits);
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+  statistics = session.planCacheStatistics();
+  EXPECT_EQ(4u, statistics.nbOfMisses);
+  EXPECT_DOUBLE_EQ(2. / 6., statistics.hitRate());
+
+  // The objects are compared even if they are not in the key
+  problem.objects.add(ogp::Entity::fromDeclaration("obj1 - entity", ontology.types));
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+  statistics = session.planCacheStatistics();
+  EXPECT_EQ(2u, statistics.nbOfHits);
+  EXPECT_EQ(5u, statistics.nbOfMisses);
+
+  session.clearCaches();
+  EXPECT_EQ(0u, session.planCacheStatistics().nbOfEntries);
+  EXPECT_EQ(2u, session.planCacheStatistics().maxNbOfEntries);
+}
+
+
+void _goalStackHash()
+{
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b", ontology.types);
+
+  ogp::Problem problem;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_a", ontology, problem.objects)}, ontology.constants);
+  const auto hashBefore = problem.goalStack.hash();
+  auto problemCopy = problem;
+  EXPECT_EQ(hashBefore, problemCopy.goalStack.hash());
+
+  // The attributes of the goals are taken into account
+  ogp::Problem otherProblem;
+  _setGoalsForAPriority(otherProblem, {ogp::Goal::fromStr("fact_a", ontology, otherProblem.objects, 10)}, ontology.constants);
+  EXPECT_NE(hashBefore, otherProblem.goalStack.hash());
+
+  // The effect between the goals is taken into account
+  problemCopy.goalStack.effectBetweenGoals = ogp::strToWsModification("fact_b", ontology, problemCopy.objects, {});
+  EXPECT_NE(hashBefore, problemCopy.goalStack.hash());
+}
+
+
+void _planningBudget()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, _worldStateModification_fromPddl("(fact_a)", ontology)));
+  actions.emplace(action2, ogp::Action({}, _worldStateModification_fromPddl("(fact_b)", ontology)));
+  ogp::Domain domain(std::move(actions), ontology);
+
+  ogp::Problem problem;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_a", ontology, problem.objects),
+                                  ogp::Goal::fromStr("fact_b", ontology, problem.objects)}, ontology.constants);
+
+  ogp::PlanningStatus status = ogp::PlanningStatus::TRUNCATED;
+  {
+    auto problemCopy = problem;
+    EXPECT_EQ(action1 + ", " + action2,
+              ogp::planToStr(ogp::planForEveryGoals(problemCopy, domain, _emptyCallbacks, ogp::PlanningBudget(), status, {})));
+    EXPECT_EQ(ogp::PlanningStatus::COMPLETED, status);
+  }
+
+  // The plan found before the exhaustion of the budget is returned
+  {
+    auto problemCopy = problem;
+    ogp::PlanningBudget budget;
+    budget.maxNbOfExpansions = 1;
+    EXPECT_EQ(action1, ogp::planToStr(ogp::planForEveryGoals(problemCopy, domain, _emptyCallbacks, budget, status, {})));
+    EXPECT_EQ(ogp::PlanningStatus::TRUNCATED, status);
+    // The goal that was not planned is not removed even if it is not persistent
+    ASSERT_EQ(1u, problemCopy.goalStack.goals().size());
+    ASSERT_EQ(1u, problemCopy.goalStack.goals().begin()->second.size());
+    EXPECT_EQ("fact_b", problemCopy.goalStack.goals().begin()->second.front().toStr());
+  }
+
+  // The deadline is hit before the search, so no goal is removed
+  {
+    auto problemCopy = problem;
+    ogp::PlanningBudget budget;
+    budget.deadline = std::chrono::steady_clock::now();
+    EXPECT_EQ("", ogp::planToStr(ogp::planForEveryGoals(problemCopy, domain, _emptyCallbacks, budget, status, {})));
+    EXPECT_EQ(ogp::PlanningStatus::TRUNCATED, status);
+    ASSERT_EQ(1u, problemCopy.goalStack.goals().size());
+    EXPECT_EQ(2u, problemCopy.goalStack.goals().begin()->second.size());
+
+    auto problemCopy2 = problem;
+    EXPECT_EQ("", ogp::planToStr(ogp::planForMoreImportantGoalPossible(problemCopy2, domain, _emptyCallbacks, true, budget, status, {})));
+    EXPECT_EQ(ogp::PlanningStatus::TRUNCATED, status);
+    ASSERT_EQ(1u, problemCopy2.goalStack.goals().size());
+    EXPECT_EQ(2u, problemCopy2.goalStack.goals().begin()->second.size());
+  }
+
+  // A session applies the budget too and does not memorize a truncated plan
+  {
+    auto problemCopy = problem;
+    ogp::PlannerSession session(domain, problemCopy);
+    session.setPlanCacheCapacity(10);
+    ogp::PlanningBudget budget;
+    budget.deadline = std::chrono::steady_clock::now();
+    EXPECT_EQ("", ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, budget, status, {})));
+    EXPECT_EQ(ogp::PlanningStatus::TRUNCATED, status);
+    EXPECT_EQ(0u, session.planCacheStatistics().nbOfEntries);
+    EXPECT_EQ(action1 + ", " + action2,
+              ogp::planToStr(session.planForEveryGoals(_emptyCallbacks, ogp::PlanningBudget(), status, {})));
+    EXPECT_EQ(ogp::PlanningStatus::COMPLETED, status);
+  }
+}
+
+
+void _unreachableGoal()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b\n"
+                                                      "fact_c", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, _worldStateModification_fromPddl("(fact_a)", ontology)));
+  // Nothing can add fact_b, so action2 can never be done
+  actions.emplace(action2, ogp::Action(_condition_fromPddl("(fact_b)", ontology),
+                                       _worldStateModification_fromPddl("(fact_c)", ontology)));
+  ogp::Domain domain(std::move(actions), ontology);
+
+  ogp::Problem problem;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_a & fact_c", ontology, problem.objects)}, ontology.constants);
+
+  // The goal fails before any search, so the budget is not consumed
+  ogp::PlanningStatus status = ogp::PlanningStatus::TRUNCATED;
+  {
+    auto problemCopy = problem;
+    ogp::PlanningBudget budget;
+    budget.maxNbOfExpansions = 1;
+    EXPECT_EQ("", ogp::planToStr(ogp::planForEveryGoals(problemCopy, domain, _emptyCallbacks, budget, status, {})));
+    EXPECT_EQ(ogp::PlanningStatus::COMPLETED, status);
+  }
+
+  // The goal becomes reachable when the precondition of action2 can be satisfied
+  const std::map<ogp::SetOfEventsId, ogp::SetOfEvents> setOfEventsMap;
+  problem.worldState.addFact(ogp::Fact("fact_b", false, ontology, problem.objects, {}), problem.goalStack, setOfEventsMap,
+                             _emptyCallbacks, ontology, problem.objects, {});
+  auto plan = ogp::planForEveryGoals(problem, domain, _emptyCallbacks, {});
+  EXPECT_EQ(2u, plan.size());
+  EXPECT_TRUE(problem.goalStack.goals().empty());
+}
+
+
+void _staticPreconditions()
+{
+  auto domain = ogp::pddlToDomain(R"(
+(define
+  (domain static_preconditions)
+  (:requirements :strips :typing)
+
+  (:types location)
+
+  (:constants
+    l1 l2 l3 - location
+  )
+
+  (:predicates
+    (at ?l - location)
+    (connected ?from - location ?to - location)
+  )
+
+  (:timeless
+    (connected l1 l2)
+  )
+
+  (:action move
+    :parameters (?from - location ?to - location)
+    :precondition (and (at ?from) (connected ?from ?to))
+    :effect (and (not (at ?from)) (at ?to))
+  )
+))", false, {});
+
+  auto domainAndProblemPtrs = ogp::pddlToProblem(R"(
+(define
+  (problem static_preconditions_problem)
+  (:domain static_preconditions)
+
+  (:init
+    (at l1)
+    (connected l3 l2)
+  )
+
+  (:goal
+    (at l2)
+  )
+))", domain);
+  auto& problem = *domainAndProblemPtrs.problemPtr;
+  const auto& ontology = domain.getOntology();
+
+  // The connections come from the timeless facts and from the world state, nothing can modify them
+  auto plan = ogp::planForEveryGoals(problem, domain, _emptyCallbacks, {});
+  EXPECT_EQ("move(?from -> l1, ?to -> l2)", ogp::planToStr(plan));
+  ogp::notifyActionDone(problem, domain, _emptyCallbacks, plan.front(), {});
+
+  // The connection is only in the other direction
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("at(l3)", ontology, problem.objects)}, ontology.constants);
+  EXPECT_EQ("", ogp::planToStr(ogp::planForEveryGoals(problem, domain, _emptyCallbacks, {})));
+
+  // The groundings kept by a session are computed again when a static fact is added
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("at(l3)", ontology, problem.objects)}, ontology.constants);
+  ogp::PlannerSession session(domain, problem);
+  EXPECT_EQ("", ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+  const std::map<ogp::SetOfEventsId, ogp::SetOfEvents> setOfEventsMap;
+  problem.worldState.addFact(ogp::Fact::fromStr("connected(l2, l3)", ontology, problem.objects, {}), problem.goalStack,
+                             setOfEventsMap, _emptyCallbacks, ontology, problem.objects, {});
+  // The unreachable goal was removed by the previous call
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("at(l3)", ontology, problem.objects)}, ontology.constants);
+  EXPECT_EQ("move(?from -> l2, ?to -> l3)", ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, {})));
+}
+
+
+void _forwardSearchWithTimelessFacts()
+{
+  auto domain = ogp::pddlToDomain(R"(
+(define
+  (domain forward_search_timeless)
+  (:requirements :strips :negative-preconditions)
+
+  (:predicates
+    (fact_a)
+    (fact_t)
+  )
+
+  (:timeless
+    (fact_t)
+  )
+
+  (:action action1
+    :precondition (not (fact_t))
+    :effect (fact_a)
+  )
+
+  (:action action2
+    :precondition (fact_t)
+    :effect (fact_a)
+  )
+))", false, {});
+  const auto& ontology = domain.getOntology();
+
+  // The world state of the problem does not hold the timeless facts of the domain
+  ogp::Problem problem;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_a", ontology, problem.objects)}, ontology.constants);
+  ogp::SearchStrategy searchStrategy;
+  searchStrategy.algorithm = ogp::SearchAlgorithm::WEIGHTED_A_STAR;
+  // action1 cannot be used by the planner because its precondition contradicts a timeless fact
+  EXPECT_EQ("action2", ogp::planToStr(ogp::planForEveryGoals(problem, domain, _emptyCallbacks, searchStrategy, {})));
+}
+
+
+void _forwardSearchInASession()
+{
+  auto domain = ogp::pddlToDomain(R"(
+(define
+  (domain forward_search_session)
+  (:requirements :strips)
+
+  (:predicates
+    (fact_a)
+    (fact_b)
+  )
+
+  (:action action1
+    :effect (fact_a)
+  )
+
+  (:action action2
+    :precondition (fact_a)
+    :effect (fact_b)
+  )
+))", false, {});
+  const auto& ontology = domain.getOntology();
+
+  ogp::Problem problem;
+  ogp::PlannerSession session(domain, problem);
+  ogp::SearchStrategy searchStrategy;
+  searchStrategy.algorithm = ogp::SearchAlgorithm::WEIGHTED_A_STAR;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_b", ontology, problem.objects)}, ontology.constants);
+  ogp::PlanningStatus status = ogp::PlanningStatus::TRUNCATED;
+  EXPECT_EQ("action1, action2", ogp::planToStr(session.planForMoreImportantGoalPossible(_emptyCallbacks, true, searchStrategy,
+                                                                                         ogp::PlanningBudget(), status, {})));
+  EXPECT_EQ(ogp::PlanningStatus::COMPLETED, status);
+  EXPECT_EQ(0u, session.forwardSearchGroundingStatistics().nbOfHits);
+  EXPECT_EQ(1u, session.forwardSearchGroundingStatistics().nbOfMisses);
+  EXPECT_EQ(2u, session.forwardSearchGroundingStatistics().nbOfEntries);
+
+  // The next calls reuse the grounding
+  status = ogp::PlanningStatus::TRUNCATED;
+  auto actionsToDoInParallel = session.actionsToDoInParallelNow(_emptyCallbacks, searchStrategy, ogp::PlanningBudget(), status, {});
+  ASSERT_EQ(1u, actionsToDoInParallel.actions.size());
+  EXPECT_EQ("action1", actionsToDoInParallel.actions.front().actionInvocation.toStr());
+  EXPECT_EQ(ogp::PlanningStatus::COMPLETED, status);
+  EXPECT_EQ(1u, session.forwardSearchGroundingStatistics().nbOfHits);
+  EXPECT_EQ("action1, action2", ogp::planToStr(session.planForEveryGoals(_emptyCallbacks, searchStrategy, {})));
+  EXPECT_EQ(2u, session.forwardSearchGroundingStatistics().nbOfHits);
+  EXPECT_EQ(1u, session.forwardSearchGroundingStatistics().nbOfMisses);
+
+  session.clearCaches();
+  EXPECT_EQ(0u, session.forwardSearchGroundingStatistics().nbOfHits);
+  EXPECT_EQ(0u, session.forwardSearchGroundingStatistics().nbOfMisses);
+}
+
+
+void _cancellationToken()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, _worldStateModification_fromPddl("(fact_a)", ontology)));
+  actions.emplace(action2, ogp::Action({}, _worldStateModification_fromPddl("(fact_b)", ontology)));
+  ogp::Domain domain(std::move(actions), ontology);
+
+  ogp::Problem problem;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_b", ontology, problem.objects)}, ontology.constants);
+
+  ogp::PlanningBudget budget;
+  auto cancellationToken = budget.cancellationToken;
+  cancellationToken.cancel();
+  ogp::PlanningStatus status = ogp::PlanningStatus::COMPLETED;
+  EXPECT_EQ("", ogp::planToStr(ogp::planForMoreImportantGoalPossible(problem, domain, _emptyCallbacks, true, budget, status, {})));
+  EXPECT_EQ(ogp::PlanningStatus::CANCELLED, status);
+  // The goal is not removed as if it was failing
+  EXPECT_EQ(1u, problem.goalStack.goals().size());
+
+  // The pruning stops without removing any action
+  std::list<ogp::ActionInvocationWithGoal> plan;
+  plan.emplace_back(action1, std::map<ogp::Parameter, ogp::Entity>(), std::unique_ptr<ogp::Goal>(), 0);
+  plan.emplace_back(action2, std::map<ogp::Parameter, ogp::Entity>(), std::unique_ptr<ogp::Goal>(), 0);
+  const auto goal = ogp::Goal::fromStr("fact_b", ontology, problem.objects);
+  ogp::removeNotMandatoryActions(plan, domain, problem, goal, &cancellationToken);
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(plan));
+  ogp::removeNotMandatoryActions(plan, domain, problem, goal);
+  EXPECT_EQ(action2, ogp::planToStr(plan));
+}
+
 
 
 void _removeAFact()
@@ -994,6 +1557,18 @@ TEST(Planner, test_planner)
   _assignAFluentWithoutValue();
   _assignAFluentWithoutValueAndEventToResetValue();
   _removeNotMandatoryActions();
+  _removeNotMandatoryActionsWithRemovedFacts();
+  _replanForEveryGoals();
+  _plannerSession();
+  _transpositionTable();
+  _planCache();
+  _goalStackHash();
+  _planningBudget();
+  _unreachableGoal();
+  _staticPreconditions();
+  _forwardSearchWithTimelessFacts();
+  _forwardSearchInASession();
+  _cancellationToken();
   _removeAFact();
   _parameterNotInConditionOrEffect();
 }
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <orderedgoalsplanner/types/fact.hpp>
+#include <orderedgoalsplanner/types/factid.hpp>
 #include <orderedgoalsplanner/types/setoffacts.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
 #include <orderedgoalsplanner/util/alias.hpp>
@@ -81,3 +82,340 @@ TEST(Tool, test_setOfFacts)
     EXPECT_EQ("[]", factToFacts.find(factWithParam, true).toStr());
   }
 }
+
+
+TEST(Tool, test_factIds)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("my_type my_type2");
+  ontology.constants = ogp::SetOfEntities::fromPddl("toto toto2 - my_type\n"
+                                                    "titi titi2 - my_type2", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("pred_name(?p1 - my_type, ?p2 - my_type2)\n"
+                                                      "pred_name2(?p1 - my_type) - my_type2",
+                                                      ontology.types);
+
+  ogp::FactIdTable factIdTable;
+  auto fact1 = ogp::Fact::fromStr("pred_name(toto, titi)", ontology, {}, {});
+  EXPECT_FALSE(factIdTable.getFactId(ogp::Fact::fromStr("pred_name(toto2, titi2)", ontology, {}, {})));
+  auto factId1 = factIdTable.getOrCreateFactId(fact1);
+  ASSERT_TRUE(factId1);
+  EXPECT_EQ(factId1, factIdTable.getFactId(ogp::Fact::fromStr("pred_name(toto, titi)", ontology, {}, {})));
+  EXPECT_NE(factId1, factIdTable.getOrCreateFactId(ogp::Fact::fromStr("pred_name(toto, titi2)", ontology, {}, {})));
+  EXPECT_FALSE(factIdTable.getFactId(ogp::Fact::fromStr("pred_name(toto2, titi)", ontology, {}, {})));
+  EXPECT_EQ("toto", factIdTable.symbolToStr(*factIdTable.getSymbolId("toto")));
+
+  // The value is not part of the identifier
+  auto fluentId = factIdTable.getOrCreateFactId(ogp::Fact::fromStr("pred_name2(toto)=titi", ontology, {}, {}));
+  EXPECT_EQ(fluentId, factIdTable.getFactId(ogp::Fact::fromStr("pred_name2(toto)=titi2", ontology, {}, {})));
+
+  // A fact with a parameter is not ground
+  std::vector<ogp::Parameter> parameters(1, ogp::Parameter::fromStr("?p - my_type", ontology.types));
+  EXPECT_FALSE(factIdTable.getOrCreateFactId(ogp::Fact::fromStr("pred_name(?p, titi)", ontology, {}, parameters)));
+  EXPECT_EQ(3, factIdTable.nbOfFactIds());
+
+  // The identifiers are local to their table
+  ogp::FactIdTable otherFactIdTable;
+  EXPECT_FALSE(otherFactIdTable.getFactId(fact1));
+  EXPECT_EQ(0, otherFactIdTable.nbOfFactIds());
+
+  SetOfFacts setOfFacts;
+  setOfFacts.add(fact1);
+  setOfFacts.add(ogp::Fact::fromStr("pred_name2(toto)=titi", ontology, {}, {}));
+  EXPECT_TRUE(setOfFacts.contains(fact1));
+  EXPECT_FALSE(setOfFacts.contains(ogp::Fact::fromStr("pred_name(toto2, titi)", ontology, {}, {})));
+  EXPECT_TRUE(setOfFacts.contains(ogp::Fact::fromStr("pred_name2(toto)=titi", ontology, {}, {})));
+  EXPECT_FALSE(setOfFacts.contains(ogp::Fact::fromStr("pred_name2(toto)=titi2", ontology, {}, {})));
+  EXPECT_EQ("[pred_name2(toto)=titi]", setOfFacts.find(ogp::Fact::fromStr("pred_name2(toto)=titi2", ontology, {}, {}), true).toStr());
+  EXPECT_TRUE(setOfFacts.erase(fact1));
+  EXPECT_FALSE(setOfFacts.contains(fact1));
+}
+
+
+TEST(Tool, test_setOfFactsCopyOnWrite)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("my_type my_type2");
+  ontology.constants = ogp::SetOfEntities::fromPddl("toto toto2 - my_type\n"
+                                                    "titi titi2 - my_type2", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("pred_name(?p1 - my_type, ?p2 - my_type2)\n"
+                                                      "pred_name2(?p1 - my_type) - my_type2",
+                                                      ontology.types);
+
+  SetOfFacts setOfFacts;
+  setOfFacts.add(ogp::Fact::fromStr("pred_name2(toto)=titi", ontology, {}, {}));
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto, titi)", ontology, {}, {}));
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto2, titi)", ontology, {}, {}));
+
+  auto copiedSetOfFacts = setOfFacts;
+  EXPECT_TRUE(copiedSetOfFacts.deltaFrom(setOfFacts).empty());
+  copiedSetOfFacts.erase(ogp::Fact::fromStr("pred_name(toto, titi)", ontology, {}, {}));
+  copiedSetOfFacts.add(ogp::Fact::fromStr("pred_name(toto, titi2)", ontology, {}, {}));
+  EXPECT_EQ(3u, setOfFacts.size());
+  EXPECT_EQ("(pred_name toto titi)\n(pred_name toto2 titi)\n(= (pred_name2 toto) titi)", setOfFacts.toPddl(0, true));
+  EXPECT_EQ("(pred_name toto titi2)\n(pred_name toto2 titi)\n(= (pred_name2 toto) titi)", copiedSetOfFacts.toPddl(0, true));
+  EXPECT_EQ("[pred_name(toto, titi)]", setOfFacts.find(ogp::Fact::fromStr("pred_name(toto, titi)", ontology, {}, {})).toStr());
+  EXPECT_TRUE(copiedSetOfFacts.find(ogp::Fact::fromStr("pred_name(toto, titi)", ontology, {}, {})).empty());
+  EXPECT_EQ("+(pred_name toto titi2)\n-(pred_name toto titi)", copiedSetOfFacts.deltaFrom(setOfFacts).toPddl());
+
+  std::size_t nbOfFacts = 0;
+  for (const auto& currFact : copiedSetOfFacts.facts())
+    if (currFact.second)
+      ++nbOfFacts;
+  EXPECT_EQ(3u, nbOfFacts);
+  copiedSetOfFacts.clear();
+  EXPECT_TRUE(copiedSetOfFacts.facts().empty());
+  EXPECT_EQ(3u, setOfFacts.facts().size());
+}
+
+
+TEST(Tool, test_setOfFactsKeepOrderAfterRollback)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("my_type my_type2");
+  ontology.constants = ogp::SetOfEntities::fromPddl("toto toto2 toto3 toto4 - my_type\n"
+                                                    "titi titi2 - my_type2", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("pred_name(?p1 - my_type) - my_type2\n"
+                                                      "pred_name2(?p1 - my_type)",
+                                                      ontology.types);
+
+  SetOfFacts setOfFacts;
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto)=titi", ontology, {}, {}));
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto2)=titi", ontology, {}, {}));
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto3)=titi", ontology, {}, {}));
+  setOfFacts.add(ogp::Fact::fromStr("pred_name2(toto)", ontology, {}, {}));
+  setOfFacts.add(ogp::Fact::fromStr("pred_name2(toto2)", ontology, {}, {}));
+
+  std::vector<ogp::Parameter> parameters(1, ogp::Parameter::fromStr("?p1 - my_type", ontology.types));
+  auto factWithParam = ogp::Fact::fromStr("pred_name(?p1)=titi", ontology, {}, parameters);
+  auto factWithParam2 = ogp::Fact::fromStr("pred_name2(?p1)", ontology, {}, parameters);
+  auto printFacts = [&]() {
+    return setOfFacts.find(factWithParam).toStr() + " " + setOfFacts.find(factWithParam2).toStr() + " " +
+        setOfFacts.find(ogp::Fact::fromStr("pred_name(toto2)=titi", ontology, {}, {}), true).toStr();
+  };
+  const std::string factsBefore = "[pred_name(toto)=titi, pred_name(toto2)=titi, pred_name(toto3)=titi] "
+                                  "[pred_name2(toto), pred_name2(toto2)] [pred_name(toto2)=titi]";
+  EXPECT_EQ(factsBefore, printFacts());
+  auto hashBefore = setOfFacts.hash();
+
+  auto checkpoint = setOfFacts.checkpoint();
+  EXPECT_TRUE(setOfFacts.erase(ogp::Fact::fromStr("pred_name(toto)=titi", ontology, {}, {})));
+  EXPECT_TRUE(setOfFacts.erase(ogp::Fact::fromStr("pred_name(toto2)=titi", ontology, {}, {})));
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto2)=titi2", ontology, {}, {}));
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto4)=titi", ontology, {}, {}));
+  EXPECT_TRUE(setOfFacts.erase(ogp::Fact::fromStr("pred_name2(toto)", ontology, {}, {})));
+  EXPECT_TRUE(setOfFacts.erase(ogp::Fact::fromStr("pred_name2(toto2)", ontology, {}, {})));
+  EXPECT_EQ("[pred_name(toto3)=titi, pred_name(toto4)=titi] [] [pred_name(toto2)=titi2]", printFacts());
+  setOfFacts.rollbackTo(checkpoint);
+  EXPECT_EQ(factsBefore, printFacts());
+  EXPECT_EQ(hashBefore, setOfFacts.hash());
+
+  // Same with a lot of removals, that would compact the posting lists without a checkpoint, and with a clear
+  checkpoint = setOfFacts.checkpoint();
+  auto factToggled1 = ogp::Fact::fromStr("pred_name(toto)=titi", ontology, {}, {});
+  auto factToggled2 = ogp::Fact::fromStr("pred_name(toto)=titi2", ontology, {}, {});
+  for (int i = 0; i < 100; ++i)
+  {
+    EXPECT_TRUE(setOfFacts.erase(i % 2 == 0 ? factToggled1 : factToggled2));
+    EXPECT_TRUE(setOfFacts.add(i % 2 == 0 ? factToggled2 : factToggled1));
+  }
+  setOfFacts.clear();
+  setOfFacts.add(ogp::Fact::fromStr("pred_name2(toto3)", ontology, {}, {}));
+  setOfFacts.rollbackTo(checkpoint);
+  EXPECT_EQ(factsBefore, printFacts());
+  EXPECT_EQ(hashBefore, setOfFacts.hash());
+  EXPECT_EQ(5u, setOfFacts.size());
+
+  // The copies and the moves do not inherit the checkpoints
+  checkpoint = setOfFacts.checkpoint();
+  SetOfFacts copiedSetOfFacts(setOfFacts);
+  EXPECT_ANY_THROW(copiedSetOfFacts.rollbackTo(checkpoint));
+  SetOfFacts movedSetOfFacts(std::move(copiedSetOfFacts));
+  EXPECT_ANY_THROW(movedSetOfFacts.rollbackTo(checkpoint));
+  setOfFacts.releaseCheckpoint(checkpoint);
+}
+
+
+TEST(Tool, test_setOfFactsKeepInsertionOrderAfterManyRemovals)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("my_type my_type2");
+  ontology.constants = ogp::SetOfEntities::fromPddl("toto toto2 toto3 - my_type\n"
+                                                    "titi titi2 - my_type2", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("pred_name(?p1 - my_type) - my_type2",
+                                                      ontology.types);
+
+  SetOfFacts setOfFacts;
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto)=titi", ontology, {}, {}));
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto2)=titi", ontology, {}, {}));
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto3)=titi", ontology, {}, {}));
+
+  // Overwrite the value of the second fact a lot of times to remove its slot from the middle of the posting lists
+  auto factToggled1 = ogp::Fact::fromStr("pred_name(toto2)=titi", ontology, {}, {});
+  auto factToggled2 = ogp::Fact::fromStr("pred_name(toto2)=titi2", ontology, {}, {});
+  for (int i = 0; i < 100; ++i)
+  {
+    EXPECT_TRUE(setOfFacts.erase(i % 2 == 0 ? factToggled1 : factToggled2));
+    EXPECT_TRUE(setOfFacts.add(i % 2 == 0 ? factToggled2 : factToggled1));
+  }
+
+  EXPECT_EQ(3u, setOfFacts.size());
+  std::vector<ogp::Parameter> parameters(1, ogp::Parameter::fromStr("?p1 - my_type", ontology.types));
+  auto factWithParam = ogp::Fact::fromStr("pred_name(?p1)=titi", ontology, {}, parameters);
+  EXPECT_EQ("[pred_name(toto)=titi, pred_name(toto3)=titi, pred_name(toto2)=titi]", setOfFacts.find(factWithParam).toStr());
+  EXPECT_EQ("[pred_name(toto)=titi, pred_name(toto3)=titi, pred_name(toto2)=titi]", setOfFacts.find(factWithParam, true).toStr());
+  EXPECT_TRUE(setOfFacts.contains(factToggled1));
+  EXPECT_FALSE(setOfFacts.contains(factToggled2));
+}
+
+
+TEST(Tool, test_setOfFactsHoldingEntities)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("my_type my_type2");
+  ontology.constants = ogp::SetOfEntities::fromPddl("toto toto2 - my_type\n"
+                                                    "titi titi2 - my_type2", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("pred_name(?p1 - my_type, ?p2 - my_type2)\n"
+                                                      "pred_name2(?p1 - my_type) - my_type2",
+                                                      ontology.types);
+
+  SetOfFacts setOfFacts;
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto, titi)", ontology, {}, {}));
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto2, titi2)", ontology, {}, {}), false);
+  setOfFacts.add(ogp::Fact::fromStr("pred_name2(toto2)=titi", ontology, {}, {}));
+
+  auto factsToStr = [](const std::list<std::pair<ogp::Fact, bool>>& pFacts) {
+    std::string res;
+    for (const auto& currFact : pFacts)
+      res += currFact.first.toStr() + (currFact.second ? "" : "(timeless)") + " ";
+    return res;
+  };
+  EXPECT_EQ("pred_name(toto, titi) pred_name2(toto2)=titi ", factsToStr(setOfFacts.getFactsHoldingEntities({"titi"})));
+  EXPECT_EQ("pred_name(toto2, titi2)(timeless) pred_name2(toto2)=titi ", factsToStr(setOfFacts.getFactsHoldingEntities({"toto2", "titi2"})));
+  EXPECT_TRUE(setOfFacts.hasEntity("titi2"));
+
+  auto copiedSetOfFacts = setOfFacts;
+  EXPECT_TRUE(copiedSetOfFacts.erase(ogp::Fact::fromStr("pred_name2(toto2)=titi", ontology, {}, {})));
+  EXPECT_EQ("pred_name(toto, titi) ", factsToStr(copiedSetOfFacts.getFactsHoldingEntities({"titi"})));
+  EXPECT_EQ("pred_name(toto, titi) pred_name2(toto2)=titi ", factsToStr(setOfFacts.getFactsHoldingEntities({"titi"})));
+  copiedSetOfFacts.clear();
+  EXPECT_FALSE(copiedSetOfFacts.hasEntity("toto"));
+  EXPECT_TRUE(setOfFacts.hasEntity("toto"));
+}
+
+
+TEST(Tool, test_setOfFactsFluentNumbers)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("my_type");
+  ontology.constants = ogp::SetOfEntities::fromPddl("toto toto2 - my_type", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("battery(?p1 - my_type) - number\n"
+                                                      "pred_name(?p1 - my_type) - my_type",
+                                                      ontology.types);
+
+  SetOfFacts setOfFacts;
+  auto battery = ogp::Fact::fromStr("battery(toto)=10", ontology, {}, {});
+  setOfFacts.add(battery);
+  setOfFacts.add(ogp::Fact::fromStr("battery(toto2)=2.5", ontology, {}, {}));
+  setOfFacts.add(ogp::Fact::fromStr("pred_name(toto)=toto2", ontology, {}, {}));
+
+  EXPECT_EQ("10", ogp::numberToString(*setOfFacts.getFluentNumber(ogp::Fact::fromStr("battery(toto)=*", ontology, {}, {}))));
+  EXPECT_EQ("2.500000", ogp::numberToString(*setOfFacts.getFluentNumber(ogp::Fact::fromStr("battery(toto2)=*", ontology, {}, {}))));
+  EXPECT_FALSE(setOfFacts.getFluentNumber(ogp::Fact::fromStr("pred_name(toto)=*", ontology, {}, {})));
+
+  auto copiedSetOfFacts = setOfFacts;
+  copiedSetOfFacts.erase(battery);
+  EXPECT_FALSE(copiedSetOfFacts.getFluentNumber(battery));
+  copiedSetOfFacts.add(ogp::Fact::fromStr("battery(toto)=7", ontology, {}, {}));
+  EXPECT_EQ("7", ogp::numberToString(*copiedSetOfFacts.getFluentNumber(battery)));
+  EXPECT_EQ("10", ogp::numberToString(*setOfFacts.getFluentNumber(battery)));
+}
+
+
+TEST(Tool, test_setOfFactsDeltaFrom)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("my_type my_type2");
+  ontology.constants = ogp::SetOfEntities::fromPddl("toto toto2 toto3 - my_type\n"
+                                                    "titi titi2 - my_type2", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("pred_name(?p1 - my_type, ?p2 - my_type2)\n"
+                                                      "pred_name2(?p1 - my_type) - my_type2\n"
+                                                      "pred_name3(?p1 - my_type)",
+                                                      ontology.types);
+
+  SetOfFacts oldSetOfFacts;
+  oldSetOfFacts.add(ogp::Fact::fromStr("pred_name(toto, titi)", ontology, {}, {}));
+  oldSetOfFacts.add(ogp::Fact::fromStr("pred_name2(toto)=titi", ontology, {}, {}));
+  oldSetOfFacts.add(ogp::Fact::fromStr("pred_name2(toto2)=titi", ontology, {}, {}));
+  oldSetOfFacts.add(ogp::Fact::fromStr("pred_name3(toto)", ontology, {}, {}));
+
+  auto newSetOfFacts = oldSetOfFacts;
+  newSetOfFacts.erase(ogp::Fact::fromStr("pred_name2(toto)=titi", ontology, {}, {}));
+  newSetOfFacts.add(ogp::Fact::fromStr("pred_name2(toto)=titi2", ontology, {}, {}));
+  newSetOfFacts.erase(ogp::Fact::fromStr("pred_name2(toto2)=titi", ontology, {}, {}));
+  newSetOfFacts.add(ogp::Fact::fromStr("pred_name2(toto3)=titi", ontology, {}, {}));
+  newSetOfFacts.erase(ogp::Fact::fromStr("pred_name3(toto)", ontology, {}, {}));
+
+  // The value change of pred_name2(toto) is only an addition
+  EXPECT_EQ("+(= (pred_name2 toto3) titi)\n+(= (pred_name2 toto) titi2)\n-(= (pred_name2 toto2) titi)\n-(pred_name3 toto)",
+            newSetOfFacts.deltaFrom(oldSetOfFacts).toPddl());
+  EXPECT_EQ("+(= (pred_name2 toto) titi)\n+(= (pred_name2 toto2) titi)\n+(pred_name3 toto)\n-(= (pred_name2 toto3) titi)",
+            oldSetOfFacts.deltaFrom(newSetOfFacts).toPddl());
+
+  std::vector<SetOfFacts::DeltaEntry> deltaEntries;
+  newSetOfFacts.deltaFrom(deltaEntries, oldSetOfFacts);
+  std::string deltaStr;
+  for (const auto& currEntry : deltaEntries)
+    deltaStr += (currEntry.isAdded ? "+" : "-") + currEntry.factPtr->toPddl(false) + " ";
+  EXPECT_EQ("+(= (pred_name2 toto3) titi) +(= (pred_name2 toto) titi2) -(= (pred_name2 toto2) titi) -(pred_name3 toto) ", deltaStr);
+
+  // The buffer is cleared before being filled again
+  newSetOfFacts.deltaFrom(deltaEntries, newSetOfFacts);
+  EXPECT_TRUE(deltaEntries.empty());
+}
+
+
+TEST(Tool, test_setOfFactsHash)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("my_type");
+  ontology.constants = ogp::SetOfEntities::fromPddl("toto toto2 - my_type", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("pred_name(?p1 - my_type)\n"
+                                                      "pred_name2(?p1 - my_type) - my_type",
+                                                      ontology.types);
+  auto fact1 = ogp::Fact::fromStr("pred_name(toto)", ontology, {}, {});
+  auto fact2 = ogp::Fact::fromStr("pred_name2(toto)=toto2", ontology, {}, {});
+  auto fact3 = ogp::Fact::fromStr("pred_name2(toto)=toto", ontology, {}, {});
+
+  SetOfFacts setOfFacts;
+  EXPECT_EQ(0u, setOfFacts.hash());
+  setOfFacts.add(fact1);
+  setOfFacts.add(fact2);
+
+  // The hash does not depend on the order of the insertions
+  SetOfFacts otherSetOfFacts;
+  otherSetOfFacts.add(fact2);
+  otherSetOfFacts.add(fact1);
+  EXPECT_EQ(setOfFacts.hash(), otherSetOfFacts.hash());
+
+  // The hash only depends on the content of the facts, so it is the same from one execution to another
+  EXPECT_EQ(898616491662288570ULL, setOfFacts.hash());
+
+  // The hash depends on the values of the fluents
+  auto copiedSetOfFacts = setOfFacts;
+  EXPECT_EQ(setOfFacts.hash(), copiedSetOfFacts.hash());
+  copiedSetOfFacts.erase(fact2);
+  copiedSetOfFacts.add(fact3);
+  EXPECT_NE(setOfFacts.hash(), copiedSetOfFacts.hash());
+
+  // A rollback restores the hash
+  auto checkpoint = copiedSetOfFacts.checkpoint();
+  copiedSetOfFacts.erase(fact1);
+  EXPECT_NE(setOfFacts.hash(), copiedSetOfFacts.hash());
+  copiedSetOfFacts.rollbackTo(checkpoint);
+  copiedSetOfFacts.erase(fact3);
+  copiedSetOfFacts.add(fact2);
+  EXPECT_EQ(setOfFacts.hash(), copiedSetOfFacts.hash());
+
+  copiedSetOfFacts.clear();
+  EXPECT_EQ(0u, copiedSetOfFacts.hash());
+}
@@ -308,6 +308,41 @@ void _test_implySuccessions()
 }
 
 
+void _test_disjunctionSuccessions()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+
+  std::map<std::string, ogp::Action> actions;
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b\n"
+                                                      "fact_c\n"
+                                                      "fact_d",
+                                                      ontology.types);
+
+  actions.emplace(action1, ogp::Action({}, ogp::strToWsModification("fact_a & not(fact_b)", ontology, {}, {})));
+  // The removal of fact_b does not prevent action2 because fact_c can be true
+  actions.emplace(action2, ogp::Action(ogp::strToCondition("fact_a & or(fact_b, fact_c)", ontology, {}, {}),
+                                       ogp::strToWsModification("fact_d", ontology, {}, {})));
+
+  Domain domain(actions, ontology);
+  EXPECT_EQ("action: action1\n"
+            "----------------------------------\n"
+            "\n"
+            "fact: fact_a\n"
+            "action: action2\n"
+            "\n"
+            "not action: action1\n"
+            "\n"
+            "\n"
+            "action: action2\n"
+            "----------------------------------\n"
+            "\n"
+            "not action: action2\n", domain.printSuccessionCache());
+}
+
+
 void _test_successionsWithUndefinedValueInPrecondition()
 {
   const std::string action1 = "action1";
@@ -440,6 +475,7 @@ TEST(Tool, test_successionsCache)
   _test_notActionSuccessions();
   _test_impossibleSuccessions();
   _test_implySuccessions();
+  _test_disjunctionSuccessions();
   _test_successionsWithUndefinedValueInPrecondition();
   _test_numericIncreaseSuccessions();
   _test_successionWithFluentInParameter();
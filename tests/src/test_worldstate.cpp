@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <thread>
 #include <orderedgoalsplanner/types/goalstack.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
@@ -180,6 +181,46 @@ TEST(Tool, test_wordstate)
 }
 
 
+TEST(Tool, test_factsView)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("type1");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(pred_a ?t - type1)\n"
+                                                         "pred_b", pos, ontology.types);
+  }
+  auto objects = ogp::SetOfEntities::fromPddl("toto toto2 - type1", ontology.types);
+
+  ogp::WorldState worldstate;
+  std::size_t nbOfFactsFromTheView = 0;
+  auto viewConnection = worldstate.onFactsChanged.connectUnsafe([&](const ogp::SetOfFacts::FactsView& pFacts) {
+    nbOfFactsFromTheView = pFacts.size();
+  });
+  // The callbacks written for the former std::map<Fact, bool> still work
+  std::map<ogp::Fact, bool> factsFromTheMap;
+  auto mapConnection = worldstate.onFactsChanged.connectUnsafe([&](const std::map<ogp::Fact, bool>& pFacts) {
+    factsFromTheMap = pFacts;
+  });
+
+  _modifyFactsFromPddl(worldstate, "(pred_a toto)\n(pred_b)", ontology, objects);
+  EXPECT_EQ(2, nbOfFactsFromTheView);
+  EXPECT_EQ(2, factsFromTheMap.size());
+
+  const std::map<ogp::Fact, bool> facts = worldstate.facts();
+  EXPECT_EQ(facts, factsFromTheMap);
+  auto predAToto = ogp::Fact::fromStr("pred_a(toto)", ontology, objects, {});
+  auto itFact = worldstate.facts().find(predAToto);
+  ASSERT_TRUE(itFact != worldstate.facts().end());
+  EXPECT_EQ(predAToto, (*itFact).first);
+  EXPECT_TRUE((*itFact).second);
+  EXPECT_TRUE(worldstate.facts().find(ogp::Fact::fromStr("pred_a(toto2)", ontology, objects, {})) == worldstate.facts().end());
+
+  viewConnection.disconnect();
+  mapConnection.disconnect();
+}
+
+
 TEST(Tool, test_remove_fact_with_an_entity)
 {
   ogp::Ontology ontology;
@@ -344,3 +385,436 @@ TEST(Tool, test_update_problem)
   EXPECT_EQ("(= (pred_e ent_c) toto)\n(= (pred_e ent_a) toto2)",
             problem.worldState.factsMapping().toPddl(0, true));
 }
+
+
+
+TEST(Tool, test_checkpoint)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("type1 - entity");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(pred_a ?e - entity)\n"
+                                                         "pred_b\n"
+                                                         "(pred_e ?e - entity) - type1", pos, ontology.types);
+  }
+  auto objects = ogp::SetOfEntities::fromPddl("toto toto2 - type1", ontology.types);
+
+  ogp::Problem problem;
+  problem.objects = objects;
+  _modifyFactsFromPddl(problem.worldState, "(pred_a toto)\n(= (pred_e toto) toto)", ontology, objects);
+  {
+    std::size_t pos = 0;
+    problem.goalStack.setGoals({*ogp::pddlToGoal("(pred_b)", pos, ontology, objects)},
+                               problem.worldState, ontology.constants, objects, {});
+  }
+
+  auto checkpoint = problem.checkpoint();
+  const auto historicalHashBefore = problem.historical.hash();
+  _modifyFactsFromPddl(problem.worldState, "(pred_b)\n(not (pred_a toto))\n(= (pred_e toto) toto2)", ontology, objects);
+  problem.historical.notifyActionDone("action_a");
+  EXPECT_NE(historicalHashBefore, problem.historical.hash());
+  EXPECT_EQ(problem.historical.hash(), ogp::Historical(problem.historical).hash());
+  problem.goalStack.clearGoals(problem.worldState, ontology.constants, objects, {});
+  EXPECT_EQ("(pred_b)\n(= (pred_e toto) toto2)", problem.worldState.factsMapping().toPddl(0, true));
+
+  {
+    auto nestedCheckpoint = problem.worldState.checkpoint();
+    _modifyFactsFromPddl(problem.worldState, "(pred_a toto2)", ontology, objects);
+    problem.worldState.rollbackTo(nestedCheckpoint);
+    EXPECT_EQ("(pred_b)\n(= (pred_e toto) toto2)", problem.worldState.factsMapping().toPddl(0, true));
+    EXPECT_ANY_THROW(problem.worldState.rollbackTo(nestedCheckpoint));
+  }
+
+  problem.rollbackTo(checkpoint);
+  EXPECT_EQ("(pred_a toto)\n(= (pred_e toto) toto)", problem.worldState.factsMapping().toPddl(0, true));
+  EXPECT_FALSE(problem.historical.hasActionAlreadyBeenDone("action_a"));
+  EXPECT_EQ(historicalHashBefore, problem.historical.hash());
+  EXPECT_EQ("pred_b", problem.goalStack.getCurrentGoalStr());
+
+  // Released modifications are kept
+  checkpoint = problem.checkpoint();
+  _modifyFactsFromPddl(problem.worldState, "(pred_a toto2)", ontology, objects);
+  problem.releaseCheckpoint(checkpoint);
+  EXPECT_EQ("(pred_a toto)\n(pred_a toto2)\n(= (pred_e toto) toto)", problem.worldState.factsMapping().toPddl(0, true));
+}
+
+
+TEST(Tool, test_transaction)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("type1 - entity");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(pred_a ?e - entity)\n"
+                                                         "pred_b\n"
+                                                         "(pred_e ?e - entity) - type1", pos, ontology.types);
+  }
+  auto objects = ogp::SetOfEntities::fromPddl("toto toto2 - type1", ontology.types);
+
+  ogp::Problem problem;
+  problem.objects = objects;
+  _modifyFactsFromPddl(problem.worldState, "(pred_a toto)\n(= (pred_e toto) toto)", ontology, objects);
+
+  std::size_t nbOfNotifications = 0;
+  std::string addedFactsStr;
+  std::string removedFactsStr;
+  auto onFactsAddedConnection = problem.worldState.onFactsAdded.connectUnsafe([&](const std::set<Fact>& pFacts) {
+    ++nbOfNotifications;
+    for (const auto& currFact : pFacts)
+      addedFactsStr += currFact.toPddl(false) + " ";
+  });
+  auto onFactsRemovedConnection = problem.worldState.onFactsRemoved.connectUnsafe([&](const std::set<Fact>& pFacts) {
+    for (const auto& currFact : pFacts)
+      removedFactsStr += currFact.toPddl(false) + " ";
+  });
+
+  const std::map<SetOfEventsId, SetOfEvents> setOfEvents;
+  const SetOfCallbacks callbacks;
+  {
+    WorldState::Transaction transaction(problem.worldState, problem.goalStack, setOfEvents, callbacks,
+                                        ontology, objects, {});
+    transaction.addFact(ogp::Fact::fromStr("pred_e(toto)=toto2", ontology, objects, {}));
+    transaction.addFact(ogp::Fact::fromStr("pred_b", ontology, objects, {}));
+    transaction.removeFact(ogp::Fact::fromStr("pred_b", ontology, objects, {}));
+    transaction.removeFact(ogp::Fact::fromStr("pred_a(toto)", ontology, objects, {}));
+    transaction.addFact(ogp::Fact::fromStr("pred_a(toto)", ontology, objects, {}));
+    transaction.addFact(ogp::Fact::fromStr("pred_a(toto2)", ontology, objects, {}));
+    EXPECT_EQ(0u, nbOfNotifications);
+    EXPECT_ANY_THROW(WorldState::Transaction(problem.worldState, problem.goalStack, setOfEvents, callbacks,
+                                             ontology, objects, {}));
+    EXPECT_TRUE(transaction.commit());
+    EXPECT_ANY_THROW(transaction.commit());
+  }
+  EXPECT_EQ(1u, nbOfNotifications);
+  EXPECT_EQ("(pred_a toto2) (= (pred_e toto) toto2) ", addedFactsStr);
+  EXPECT_EQ("(= (pred_e toto) toto) ", removedFactsStr);
+  EXPECT_EQ("(pred_a toto)\n(pred_a toto2)\n(= (pred_e toto) toto2)", problem.worldState.factsMapping().toPddl(0, true));
+
+  {
+    WorldState::Transaction transaction(problem.worldState, problem.goalStack, setOfEvents, callbacks,
+                                        ontology, objects, {});
+    transaction.removeFact(ogp::Fact::fromStr("pred_a(toto2)", ontology, objects, {}));
+    EXPECT_TRUE(transaction.commit());
+  }
+  EXPECT_EQ("(= (pred_e toto) toto) (pred_a toto2) ", removedFactsStr);
+
+  // The destructor rolls back a transaction that is not committed, for example if an exception is thrown
+  const auto factsBefore = problem.worldState.factsMapping().toPddl(0, true);
+  try
+  {
+    WorldState::Transaction transaction(problem.worldState, problem.goalStack, setOfEvents, callbacks,
+                                        ontology, objects, {});
+    transaction.addFact(ogp::Fact::fromStr("pred_a(toto2)", ontology, objects, {}));
+    transaction.removeFact(ogp::Fact::fromStr("pred_a(toto)", ontology, objects, {}));
+    transaction.addFact(ogp::Fact::fromStr("pred_e(toto)=toto", ontology, objects, {}));
+    throw std::runtime_error("error in the transaction");
+  }
+  catch (const std::runtime_error&) {}
+  EXPECT_EQ(factsBefore, problem.worldState.factsMapping().toPddl(0, true));
+  EXPECT_EQ(1u, nbOfNotifications);
+  EXPECT_EQ("(= (pred_e toto) toto) (pred_a toto2) ", removedFactsStr);
+
+  // A new transaction can be opened after a rollback
+  {
+    WorldState::Transaction transaction(problem.worldState, problem.goalStack, setOfEvents, callbacks,
+                                        ontology, objects, {});
+    transaction.addFact(ogp::Fact::fromStr("pred_b", ontology, objects, {}));
+    transaction.rollback();
+    EXPECT_ANY_THROW(transaction.commit());
+  }
+  EXPECT_EQ(factsBefore, problem.worldState.factsMapping().toPddl(0, true));
+  onFactsAddedConnection.disconnect();
+  onFactsRemovedConnection.disconnect();
+}
+
+
+TEST(Tool, test_changeJournal)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("type1 - entity");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(pred_a ?e - entity)\n"
+                                                         "(pred_e ?e - entity) - type1", pos, ontology.types);
+  }
+  auto objects = ogp::SetOfEntities::fromPddl("toto toto2 - type1", ontology.types);
+
+  ogp::WorldState worldState;
+  worldState.setChangeJournalCapacity(3);
+  _modifyFactsFromPddl(worldState, "(pred_a toto)\n(= (pred_e toto) toto)", ontology, objects);
+  EXPECT_EQ(2u, worldState.lastChangeSequenceNumber());
+
+  auto changesToStr = [](const std::vector<WorldState::FactChange>& pChanges) {
+    std::string res;
+    for (const auto& currChange : pChanges)
+      res += std::to_string(currChange.sequenceNumber) +
+          (currChange.type == WorldState::FactChangeType::ADDED ? "+" : "-") + currChange.fact().toPddl(false) + " ";
+    return res;
+  };
+
+  std::string notifiedChangesStr;
+  auto onFactChangesConnection = worldState.onFactChanges.connectUnsafe([&](const std::vector<WorldState::FactChange>& pChanges) {
+    notifiedChangesStr += changesToStr(pChanges);
+  });
+  _modifyFactsFromPddl(worldState, "(= (pred_e toto) toto2)", ontology, objects);
+  EXPECT_EQ("3-(= (pred_e toto) toto) 4+(= (pred_e toto) toto2) ", notifiedChangesStr);
+
+  std::vector<WorldState::FactChange> changes;
+  auto pushChange = [&](const WorldState::FactChange& pChange) { changes.push_back(pChange); };
+  EXPECT_TRUE(worldState.iterateOnChangesSince(pushChange, 2));
+  EXPECT_EQ("3-(= (pred_e toto) toto) 4+(= (pred_e toto) toto2) ", changesToStr(changes));
+  changes.clear();
+  EXPECT_TRUE(worldState.iterateOnChangesSince(pushChange, 4));
+  EXPECT_TRUE(changes.empty());
+  // The first change is no longer in the journal
+  EXPECT_FALSE(worldState.iterateOnChangesSince(pushChange, 0));
+  EXPECT_TRUE(changes.empty());
+
+  auto checkpoint = worldState.checkpoint();
+  _modifyFactsFromPddl(worldState, "(not (pred_a toto))", ontology, objects);
+  worldState.rollbackTo(checkpoint);
+  // The rollback is notified like it is journaled, so the observers stay in sync with the facts
+  EXPECT_EQ("3-(= (pred_e toto) toto) 4+(= (pred_e toto) toto2) 5-(pred_a toto) 6+(pred_a toto) ", notifiedChangesStr);
+  EXPECT_TRUE(worldState.iterateOnChangesSince(pushChange, 4));
+  EXPECT_EQ("5-(pred_a toto) 6+(pred_a toto) ", changesToStr(changes));
+  // A fact modified several times is stored once
+  EXPECT_EQ(changes[0].factPtr, changes[1].factPtr);
+  onFactChangesConnection.disconnect();
+}
+
+
+TEST(Tool, test_eventChain)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("type1 - entity");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(pred_a ?e - entity)", pos, ontology.types);
+  }
+  ontology.constants = ogp::SetOfEntities::fromPddl("e0 e1 e2 e3 e4 e5 e6 e7 e8 e9 - type1", ontology.types);
+
+  // Each event adds the fact that triggers the next event of the chain
+  ogp::SetOfEvents setOfEvents;
+  for (int i = 0; i < 9; ++i)
+    setOfEvents.add(ogp::Event(_condition_fromPddl("(pred_a e" + std::to_string(i) + ")", ontology),
+                               _worldStateModification_fromPddl("(pred_a e" + std::to_string(i + 1) + ")", ontology)));
+  std::map<SetOfEventsId, SetOfEvents> setOfEventsMap;
+  setOfEventsMap.emplace("ev", std::move(setOfEvents));
+
+  ogp::WorldState worldState;
+  std::size_t pos = 0;
+  GoalStack goalStack;
+  const SetOfCallbacks callbacks;
+  worldState.modifyFactsFromPddl("(pred_a e0)", pos, goalStack, setOfEventsMap, callbacks, ontology, {}, {});
+  EXPECT_EQ("(pred_a e0)\n(pred_a e1)\n(pred_a e2)\n(pred_a e3)\n(pred_a e4)\n(pred_a e5)\n(pred_a e6)\n(pred_a e7)\n(pred_a e8)\n(pred_a e9)",
+            worldState.factsMapping().toPddl(0, true));
+}
+
+
+TEST(Tool, test_incrementalMatcherOfEventsAndCallbacks)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("robot location - entity");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(at ?r - robot ?l - location)\n"
+                                                         "(charger ?l - location)\n"
+                                                         "(can_charge ?r - robot)", pos, ontology.types);
+  }
+  ontology.constants = ogp::SetOfEntities::fromPddl("r1 r2 - robot\n"
+                                                    "kitchen bedroom - location", ontology.types);
+
+  std::vector<ogp::Parameter> parameters{_parameter("?r - robot", ontology), _parameter("?l - location", ontology)};
+  ogp::SetOfEvents setOfEvents;
+  auto eventId = setOfEvents.add(ogp::Event(_condition_fromPddl("(and (at ?r ?l) (charger ?l))", ontology, parameters),
+                                            _worldStateModification_fromPddl("(can_charge ?r)", ontology, parameters),
+                                            parameters));
+  std::map<SetOfEventsId, SetOfEvents> setOfEventsMap;
+  setOfEventsMap.emplace("ev", std::move(setOfEvents));
+
+  int nbOfCallbacks = 0;
+  ogp::MutableSetOfCallbacks mutableSetOfCallbacks;
+  mutableSetOfCallbacks.add(ogp::ConditionToCallback(_condition_fromPddl("(and (at ?r ?l) (charger ?l))", ontology, parameters),
+                                                     [&]() { ++nbOfCallbacks; }, parameters));
+  const SetOfCallbacks callbacks(mutableSetOfCallbacks.callbacks());
+
+  ogp::WorldState worldState;
+  GoalStack goalStack;
+  auto modify = [&](const std::string& pStr) {
+    std::size_t pos = 0;
+    worldState.modifyFactsFromPddl(pStr, pos, goalStack, setOfEventsMap, callbacks, ontology, {}, {});
+  };
+
+  modify("(at r1 kitchen)");
+  EXPECT_EQ("(at r1 kitchen)", worldState.factsMapping().toPddl(0, true));
+  EXPECT_EQ(0, nbOfCallbacks);
+
+  // The match is complete only when the second fact arrives
+  modify("(charger kitchen)");
+  EXPECT_EQ("(at r1 kitchen)\n(can_charge r1)\n(charger kitchen)", worldState.factsMapping().toPddl(0, true));
+  EXPECT_EQ(1, nbOfCallbacks);
+
+  // A fact that does not create a new match does not fire again
+  modify("(at r2 bedroom)");
+  EXPECT_EQ("(at r1 kitchen)\n(at r2 bedroom)\n(can_charge r1)\n(charger kitchen)", worldState.factsMapping().toPddl(0, true));
+  EXPECT_EQ(1, nbOfCallbacks);
+
+  modify("(charger bedroom)");
+  EXPECT_EQ("(at r1 kitchen)\n(at r2 bedroom)\n(can_charge r1)\n(can_charge r2)\n(charger bedroom)\n(charger kitchen)",
+            worldState.factsMapping().toPddl(0, true));
+  EXPECT_EQ(2, nbOfCallbacks);
+  EXPECT_TRUE(setOfEventsMap.at("ev").incrementalMatcher(eventId) != nullptr);
+}
+
+
+TEST(Tool, test_goalSatisfactionCache)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("type1 - entity");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(pred_a ?e - entity)\n"
+                                                         "(pred_b ?e - entity)", pos, ontology.types);
+  }
+  ontology.constants = ogp::SetOfEntities::fromPddl("toto toto2 - type1", ontology.types);
+  const ogp::SetOfEntities objects;
+
+  ogp::WorldState worldState;
+  ogp::Goal goal(_condition_fromPddl("(pred_a toto)", ontology));
+  ogp::Goal goalWithQuantifier(_condition_fromPddl("(exists (?e - type1) (pred_a ?e))", ontology));
+  EXPECT_FALSE(worldState.isGoalSatisfied(goal, ontology.constants, objects));
+  EXPECT_FALSE(worldState.isGoalSatisfied(goalWithQuantifier, ontology.constants, objects));
+
+  // A modification of another predicate does not invalidate the satisfaction
+  auto sequenceNumber = worldState.lastChangeSequenceNumber();
+  _modifyFactsFromPddl(worldState, "(pred_b toto)", ontology, objects);
+  EXPECT_FALSE(worldState.hasAPredicateChangedSince({"pred_a"}, sequenceNumber));
+  EXPECT_TRUE(worldState.hasAPredicateChangedSince({"pred_a", "pred_b"}, sequenceNumber));
+  EXPECT_FALSE(worldState.isGoalSatisfied(goal, ontology.constants, objects));
+
+  _modifyFactsFromPddl(worldState, "(pred_a toto)", ontology, objects);
+  EXPECT_TRUE(worldState.isGoalSatisfied(goal, ontology.constants, objects));
+  EXPECT_TRUE(worldState.isGoalSatisfied(goalWithQuantifier, ontology.constants, objects));
+
+  // The satisfaction cached for a world state is not used for its copies
+  auto worldStateCopied = worldState;
+  EXPECT_NE(worldState.id(), worldStateCopied.id());
+  _modifyFactsFromPddl(worldStateCopied, "(not (pred_a toto))", ontology, objects);
+  EXPECT_FALSE(worldStateCopied.isGoalSatisfied(goal, ontology.constants, objects));
+  EXPECT_TRUE(worldState.isGoalSatisfied(goal, ontology.constants, objects));
+
+  // A rollback invalidates the satisfaction
+  auto checkpoint = worldState.checkpoint();
+  _modifyFactsFromPddl(worldState, "(not (pred_a toto))", ontology, objects);
+  EXPECT_FALSE(worldState.isGoalSatisfied(goal, ontology.constants, objects));
+  worldState.rollbackTo(checkpoint);
+  EXPECT_TRUE(worldState.isGoalSatisfied(goal, ontology.constants, objects));
+
+  worldState = worldStateCopied;
+  EXPECT_FALSE(worldState.isGoalSatisfied(goal, ontology.constants, objects));
+
+  // The same goal can be checked by several threads on different world states
+  _modifyFactsFromPddl(worldStateCopied, "(pred_a toto)", ontology, objects);
+  std::vector<std::thread> threads;
+  std::vector<int> nbOfErrors(4, 0);
+  for (std::size_t i = 0; i < nbOfErrors.size(); ++i)
+  {
+    threads.emplace_back([&, i]() {
+      const auto& worldStateOfTheThread = i % 2 == 0 ? worldState : worldStateCopied;
+      for (int j = 0; j < 1000; ++j)
+        if (worldStateOfTheThread.isGoalSatisfied(goal, ontology.constants, objects) != (i % 2 != 0))
+          ++nbOfErrors[i];
+    });
+  }
+  for (auto& currThread : threads)
+    currThread.join();
+  EXPECT_EQ(std::vector<int>(4, 0), nbOfErrors);
+}
+
+
+TEST(Tool, test_updateImmutableFacts)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("type1 - entity");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(pred_a ?e - entity)\n"
+                                                         "(pred_b ?e - entity)", pos, ontology.types);
+  }
+  ontology.updateImmutablePredicates();
+  auto objects = ogp::SetOfEntities::fromPddl("toto toto2 - type1", ontology.types);
+  const auto immutablePredA = ogp::Predicate::getImmutablePrefix() + "pred_a";
+  const auto immutablePredB = ogp::Predicate::getImmutablePrefix() + "pred_b";
+  const auto immutableFactA = ogp::Fact::fromPddl("(" + immutablePredA + " toto)", ontology, objects, {});
+  const auto immutableFactB = ogp::Fact::fromPddl("(" + immutablePredB + " toto2)", ontology, objects, {});
+
+  ogp::WorldState worldState;
+  _modifyFactsFromPddl(worldState, "(pred_a toto)", ontology, objects);
+  worldState.updateImmutableFacts(ontology);
+  EXPECT_TRUE(worldState.hasFact(immutableFactA));
+
+  // Only the predicates of the immutable facts that changed are stamped
+  auto sequenceNumber = worldState.lastChangeSequenceNumber();
+  _modifyFactsFromPddl(worldState, "(pred_b toto2)", ontology, objects);
+  worldState.updateImmutableFacts(ontology);
+  EXPECT_FALSE(worldState.hasAPredicateChangedSince({"pred_a", immutablePredA}, sequenceNumber));
+  EXPECT_TRUE(worldState.hasAPredicateChangedSince({immutablePredB}, sequenceNumber));
+  EXPECT_TRUE(worldState.hasFact(immutableFactB));
+
+  // Nothing is done if neither the facts nor the predicates changed
+  sequenceNumber = worldState.lastChangeSequenceNumber();
+  worldState.updateImmutableFacts(ontology);
+  EXPECT_EQ(sequenceNumber, worldState.lastChangeSequenceNumber());
+
+  // A modification of the predicates is seen even if the ontology is the same object
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(pred_a ?e - entity)\n"
+                                                         "(pred_b ?e - entity)", pos, ontology.types);
+  }
+  worldState.updateImmutableFacts(ontology);
+  EXPECT_FALSE(worldState.hasFact(immutableFactA));
+  EXPECT_TRUE(worldState.hasAPredicateChangedSince({immutablePredA}, sequenceNumber));
+}
+
+
+TEST(Tool, test_journalOfTheImmutableFacts)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("type1 - entity");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(pred_a ?e - entity)\n"
+                                                         "(pred_b ?e - entity)", pos, ontology.types);
+  }
+  ontology.updateImmutablePredicates();
+  auto objects = ogp::SetOfEntities::fromPddl("toto toto2 - type1", ontology.types);
+  const auto immutablePredA = ogp::Predicate::getImmutablePrefix() + "pred_a";
+
+  ogp::WorldState worldState;
+  worldState.setChangeJournalCapacity(10);
+  std::size_t nbOfNotifiedChanges = 0;
+  auto onFactChangesConnection = worldState.onFactChanges.connectUnsafe([&](const std::vector<WorldState::FactChange>& pChanges) {
+    nbOfNotifiedChanges += pChanges.size();
+  });
+  _modifyFactsFromPddl(worldState, "(pred_a toto)", ontology, objects);
+  worldState.updateImmutableFacts(ontology);
+  _modifyFactsFromPddl(worldState, "(pred_b toto)", ontology, objects);
+  _modifyFactsFromPddl(worldState, "(pred_b toto2)", ontology, objects);
+  EXPECT_EQ(4u, worldState.lastChangeSequenceNumber());
+  // The immutable fact added is journaled and notified like the other facts
+  EXPECT_EQ(4u, nbOfNotifiedChanges);
+
+  std::string changesStr;
+  auto pushChange = [&](const WorldState::FactChange& pChange) {
+    changesStr += std::to_string(pChange.sequenceNumber) +
+        (pChange.type == WorldState::FactChangeType::ADDED ? "+" : "-") + pChange.fact().name() + " ";
+  };
+  EXPECT_TRUE(worldState.iterateOnChangesSince(pushChange, 1));
+  EXPECT_EQ("2+" + immutablePredA + " 3+pred_b 4+pred_b ", changesStr);
+  changesStr.clear();
+  EXPECT_TRUE(worldState.iterateOnChangesSince(pushChange, 2));
+  EXPECT_EQ("3+pred_b 4+pred_b ", changesStr);
+  onFactChangesConnection.disconnect();
+}